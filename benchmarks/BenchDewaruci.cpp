@@ -0,0 +1,366 @@
+#include <QtTest>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include "../src/database/DatabaseConnection.h"
+#include "../src/database/DatabaseShipConnection.h"
+#include "../src/database/SyntheticShipGenerator.h"
+#include "../src/database/models/FrameArrangementXZ.h"
+#include "../src/database/models/FrameArrangementYZ.h"
+#include "../src/controllers/StructureProfileTableController.h"
+#include "../src/controllers/FrameArrangementXZController.h"
+#include "../src/controllers/FrameArrangementYZController.h"
+#include "../src/controllers/FrameArrangementYZFrameController.h"
+
+/**
+ * Benchmark suite for the calculation core, the ship models and the YZ renderer.
+ *
+ * Every benchmark runs against scratch SQLite files in a temporary directory, so the
+ * project databases under data/ are never touched. Unless "-o" is given on the command
+ * line, results are printed to the console and written as CSV to benchDewaruci.csv.
+ */
+class BenchDewaruci : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void countingFormula_data();
+    void countingFormula();
+    void countingFormulaUncached_data();
+    void countingFormulaUncached();
+    void bracketFormula_data();
+    void bracketFormula();
+    void bracketFormulaEdit();
+
+    void xzLoadData_data();
+    void xzLoadData();
+    void xzCascade_data();
+    void xzCascade();
+
+    void yzNameAssignment_data();
+    void yzNameAssignment();
+    void yzSuffixConflict_data();
+    void yzSuffixConflict();
+
+    void yzRender_data();
+    void yzRender();
+    void yzPaintCached_data();
+    void yzPaintCached();
+
+private:
+    bool seedFrameXZ(int frameCount);
+    bool seedFrameYZ(int rowCount, int linesPerRow);
+
+    QTemporaryDir m_tempDir;
+    StructureProfileTableController *m_profileController = nullptr;
+    FrameArrangementXZ *m_xzModel = nullptr;
+    FrameArrangementXZController *m_xzController = nullptr;
+    FrameArrangementYZ *m_yzModel = nullptr;
+    FrameArrangementYZController *m_yzController = nullptr;
+};
+
+void BenchDewaruci::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+    QVERIFY(DatabaseConnection::instance().initialize(m_tempDir.filePath("dewaruci.db")));
+    QVERIFY(DatabaseShipConnection::instance().initialize(m_tempDir.filePath("shipsdb.db")));
+
+    m_profileController = new StructureProfileTableController(this);
+    m_profileController->initialize();
+
+    m_xzModel = new FrameArrangementXZ(this);
+    m_xzController = new FrameArrangementXZController(this);
+    m_xzController->setModel(m_xzModel);
+    QVERIFY(m_xzModel->createTable());
+
+    m_yzModel = new FrameArrangementYZ(this);
+    m_yzController = new FrameArrangementYZController(this);
+    m_yzController->setModel(m_yzModel);
+    QVERIFY(m_yzModel->createTable());
+}
+
+void BenchDewaruci::cleanupTestCase()
+{
+    DatabaseConnection::instance().close();
+    DatabaseShipConnection::instance().close();
+}
+
+// ---------------- Formulas ----------------
+
+void BenchDewaruci::countingFormula_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::newRow("T") << QStringLiteral("T");
+    QTest::newRow("HP") << QStringLiteral("HP");
+    QTest::newRow("L") << QStringLiteral("L");
+}
+
+void BenchDewaruci::countingFormula()
+{
+    QFETCH(QString, type);
+    QVariantList result;
+    QBENCHMARK {
+        result = m_profileController->countingFormula(300.0, 12.0, 100.0, 15.0, type);
+    }
+    QCOMPARE(result.size(), 4);
+}
+
+// Repeated inputs are served by the formula cache; the uncached variant measures the
+// computation and QVariant marshalling that a cache miss pays
+void BenchDewaruci::countingFormulaUncached_data()
+{
+    countingFormula_data();
+}
+
+void BenchDewaruci::countingFormulaUncached()
+{
+    QFETCH(QString, type);
+    QVariantList result;
+    QBENCHMARK {
+        m_profileController->clearFormulaCache();
+        result = m_profileController->countingFormula(300.0, 12.0, 100.0, 15.0, type);
+    }
+    QCOMPARE(result.size(), 4);
+}
+
+void BenchDewaruci::bracketFormula_data()
+{
+    QTest::addColumn<double>("modulus");
+    QTest::newRow("W=50") << 50.0;
+    QTest::newRow("W=500") << 500.0;
+    QTest::newRow("W=5000") << 5000.0;
+}
+
+void BenchDewaruci::bracketFormula()
+{
+    QFETCH(double, modulus);
+    QVariantList result;
+    QBENCHMARK {
+        result = m_profileController->profileTableCountingFormulaBrackets(12.0, modulus, 235.0, 355.0);
+    }
+    QCOMPARE(result.size(), 4);
+}
+
+void BenchDewaruci::bracketFormulaEdit()
+{
+    QVariantList result;
+    QBENCHMARK {
+        result = m_profileController->profileTableCountingFormulaBracketsEdit(12.0, 500.0, 235.0, 355.0,
+                                                                             0.0, 0.0, 0.0, 0.0);
+    }
+    QCOMPARE(result.size(), 4);
+}
+
+// ---------------- Frame XZ ----------------
+
+void BenchDewaruci::xzLoadData_data()
+{
+    QTest::addColumn<int>("frames");
+    QTest::newRow("250 frames") << 250;
+    QTest::newRow("1000 frames") << 1000;
+    QTest::newRow("10000 frames") << 10000;
+}
+
+void BenchDewaruci::xzLoadData()
+{
+    QFETCH(int, frames);
+    QVERIFY(seedFrameXZ(frames));
+    QBENCHMARK {
+        m_xzModel->loadData();
+    }
+    QCOMPARE(m_xzModel->getRowCount(), frames);
+}
+
+void BenchDewaruci::xzCascade_data()
+{
+    QTest::addColumn<int>("frames");
+    QTest::newRow("50 frames") << 50;
+    QTest::newRow("250 frames") << 250;
+}
+
+void BenchDewaruci::xzCascade()
+{
+    QFETCH(int, frames);
+    QVERIFY(seedFrameXZ(frames));
+    m_xzModel->loadData();
+
+    // Changing frame 0 rewrites every later row; alternate between two spacings so every
+    // iteration has work to do, without xpCoor so it is a pure spacing edit
+    const QVariantMap first = m_xzModel->getFrameAtIndex(0);
+    const int frameNumber = first.value("frameNumber").toInt();
+    const int originalSpacing = first.value("frameSpacing").toInt();
+    QVariantMap changed = first;
+    changed.remove("xpCoor");
+    int spacing = originalSpacing;
+    QBENCHMARK {
+        spacing = (spacing == originalSpacing) ? 700 : originalSpacing;
+        changed["frameSpacing"] = spacing;
+        m_xzController->checkChangedFrameXZ(changed, frameNumber);
+    }
+
+    // Leave the engine and the database on the seeded spacing for the next data row
+    changed["frameSpacing"] = originalSpacing;
+    m_xzController->checkChangedFrameXZ(changed, frameNumber);
+    QCOMPARE(m_xzModel->getRowCount(), frames);
+    const QVariantMap last = m_xzModel->getFrameAtIndex(frames - 1);
+    QCOMPARE(last.value("xpCoor").toDouble(), last.value("frameNumber").toInt() * originalSpacing / 1000.0);
+}
+
+// ---------------- Frame YZ ----------------
+
+void BenchDewaruci::yzNameAssignment_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("50 rows") << 50;
+    QTest::newRow("200 rows") << 200;
+}
+
+void BenchDewaruci::yzNameAssignment()
+{
+    QFETCH(int, rows);
+    QVERIFY(seedFrameYZ(rows, 4));
+    m_yzModel->loadData();
+
+    QList<int> ids;
+    for (int i = 0; i < m_yzModel->getRowCount(); ++i)
+        ids.append(m_yzModel->getFrameAtIndex(i).value("id").toInt());
+
+    QBENCHMARK {
+        int suffix = 0;
+        for (int id : ids) {
+            m_yzModel->assignAutoNamesFrom(id, QStringLiteral("L"), suffix, 4);
+            suffix += 4;
+        }
+    }
+    QCOMPARE(m_yzModel->getRowCount(), rows);
+}
+
+void BenchDewaruci::yzSuffixConflict_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("1000 rows") << 1000;
+    QTest::newRow("10000 rows") << 10000;
+}
+
+void BenchDewaruci::yzSuffixConflict()
+{
+    QFETCH(int, rows);
+    QVERIFY(seedFrameYZ(rows, 10));
+    m_yzModel->loadData();
+
+    int last = -1;
+    QBENCHMARK {
+        m_yzModel->checkSuffixConflict(QStringLiteral("L"), rows * 5, 10);
+        last = m_yzModel->getLastSuffixForPrefix(QStringLiteral("L"));
+    }
+    QVERIFY(last >= 0);
+}
+
+void BenchDewaruci::yzRender_data()
+{
+    QTest::addColumn<int>("lines");
+    QTest::newRow("1k lines") << 1000;
+    QTest::newRow("10k lines") << 10000;
+    QTest::newRow("100k lines") << 100000;
+}
+
+// Rasterising the whole view, as a tile worker (or a paint with no cached tiles) does
+void BenchDewaruci::yzRender()
+{
+    QFETCH(int, lines);
+    const int linesPerRow = 10;
+    QVERIFY(seedFrameYZ(lines / linesPerRow, linesPerRow));
+
+    FrameArrangementYZFrameController canvas;
+    canvas.setFrameController(m_yzController);
+    const YZSceneRenderer::Scene &scene = canvas.scene();
+    QVERIFY(scene.hasData);
+
+    const double pxPerMM = canvas.gridSpacing() / 1000.0 * canvas.scaleFactor();
+    const QRectF view(-640.0, -400.0, 1280.0, 800.0);
+    QImage image(1280, 800, QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        image.fill(Qt::white);
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.translate(-view.topLeft());
+        YZSceneRenderer::render(&painter, scene, pxPerMM, view);
+    }
+}
+
+void BenchDewaruci::yzPaintCached_data()
+{
+    yzRender_data();
+}
+
+// Steady-state paint: every tile of the view is rendered before timing, so this measures
+// compositing the cached tiles plus the label layer
+void BenchDewaruci::yzPaintCached()
+{
+    QFETCH(int, lines);
+    const int linesPerRow = 10;
+    QVERIFY(seedFrameYZ(lines / linesPerRow, linesPerRow));
+
+    FrameArrangementYZFrameController canvas;
+    canvas.setWidth(1280);
+    canvas.setHeight(800);
+    canvas.setFrameController(m_yzController);
+
+    QImage image(1280, 800, QImage::Format_ARGB32_Premultiplied);
+    {
+        QPainter painter(&image);
+        canvas.paint(&painter);
+    }
+    QTRY_VERIFY_WITH_TIMEOUT(canvas.tilesIdle(), 60000);
+
+    QBENCHMARK {
+        QPainter painter(&image);
+        canvas.paint(&painter);
+    }
+    QVERIFY(canvas.tilesIdle());
+}
+
+// ---------------- Seeding helpers ----------------
+
+bool BenchDewaruci::seedFrameXZ(int frameCount)
+{
+    SyntheticShipGenerator::Spec spec;
+    spec.zones = { { 0, frameCount - 1, 600 } };
+    SyntheticShipGenerator generator(spec);
+    return generator.generateFrameXZ();
+}
+
+bool BenchDewaruci::seedFrameYZ(int rowCount, int linesPerRow)
+{
+    SyntheticShipGenerator::Spec spec;
+    spec.yzGroupCount = rowCount;
+    spec.linesPerGroup = linesPerRow;
+    spec.prefixes = { QStringLiteral("L") };
+    SyntheticShipGenerator generator(spec);
+    return generator.generateFrameYZ();
+}
+
+int main(int argc, char *argv[])
+{
+    // The YZ canvas needs a GUI application, but benchmarks must run headless (CI, SSH)
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    // Models and renderer log every row/line with qDebug(); that would dominate the timings
+    QLoggingCategory::setFilterRules(QStringLiteral("default.debug=false"));
+
+    QStringList args = app.arguments();
+    if (!args.contains(QStringLiteral("-o")))
+        args << "-o" << "-,txt" << "-o" << "benchDewaruci.csv,csv";
+
+    BenchDewaruci bench;
+    return QTest::qExec(&bench, args);
+}
+
+#include "BenchDewaruci.moc"
@@ -0,0 +1,1092 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QFile>
+#include <QDir>
+#include <QTextStream>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include "src/core/ProfileFormulas.h"
+#include "src/core/FrameCoordinates.h"
+#include "src/core/YZNaming.h"
+#include "src/core/YZSectionExport.h"
+#include "src/core/YZPrefixPalette.h"
+#include "src/core/HullSection.h"
+#include "src/database/DatabaseConnection.h"
+#include "src/database/DatabaseShipConnection.h"
+#include "src/database/SyntheticShipGenerator.h"
+#include "src/database/models/FrameArrangementXZ.h"
+#include "src/database/models/FrameArrangementYZ.h"
+#include "src/database/models/HullOffsets.h"
+#include "src/database/models/LinearIsotropicMaterials.h"
+#include "src/database/models/PrefixMembers.h"
+#include "src/database/models/PrincipalDimensions.h"
+#include "src/controllers/HullGirderController.h"
+#include "src/controllers/StructuralWeightController.h"
+#include "src/controllers/StructureProfileTableController.h"
+
+/**
+ * dewaruci-cli - headless batch tool over the calculation core.
+ *
+ *   dewaruci-cli profiles    (--library-db FILE | --csv FILE) [-o FILE]
+ *   dewaruci-cli brackets    (--library-db FILE | --csv FILE) [--reh-profile N] [--reh-bracket N] [-o FILE]
+ *   dewaruci-cli xz-recalc   (--ship-db FILE | --csv FILE) [--lpp M] [--length M] [--write] [-o FILE]
+ *   dewaruci-cli yz-validate (--ship-db FILE | --csv FILE) [-o FILE]
+ *   dewaruci-cli yz-export   --ship-db FILE [--format svg|dxf] [--out-dir DIR] [--frame N] [-o FILE]
+ *   dewaruci-cli girder      --ship-db FILE [--library-db FILE] [--frame N] [--assign PREFIX=PROFILE:T[:deck] ...] [-o FILE]
+ *   dewaruci-cli weight      --ship-db FILE --library-db FILE [--default-material N] [--assign PREFIX=PROFILE:T[:deck[:MATNO]] ...] [-o FILE]
+ *   dewaruci-cli generate    [--ship-db FILE] [--library-db FILE] [--zones ...] [--yz-groups N] ...
+ *
+ * Results are written as CSV to stdout (or -o FILE) in chunks while the input is read,
+ * row computations run on every core (--threads to limit). yz-export writes one drawing
+ * per frame number, frames in parallel, and lists the files as CSV. yz-validate exits with 1
+ * when naming issues are found, any command exits with 2 on usage or database errors.
+ * girder and weight save the --assign members in the ship database; girder prints the hull
+ * girder section of each YZ frame, weight the steel weight per prefix and frame zone. Both
+ * cover the longitudinals and their plate strips only.
+ */
+
+namespace {
+
+const int ChunkSize = 8192;
+
+QTextStream &err()
+{
+    static QTextStream stream(stderr);
+    return stream;
+}
+
+// Minimal CSV reader: header line with column names, comma separated, optional double quotes
+class CsvReader
+{
+public:
+    bool open(const QString &path)
+    {
+        m_file.setFileName(path);
+        if (!m_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            m_error = m_file.errorString();
+            return false;
+        }
+        m_stream.setDevice(&m_file);
+        QStringList header;
+        if (!next(header)) {
+            m_error = QStringLiteral("CSV file has no header line");
+            return false;
+        }
+        for (int i = 0; i < header.size(); ++i)
+            m_columns.insert(header.at(i).trimmed().toLower(), i);
+        return true;
+    }
+
+    bool next(QStringList &fields)
+    {
+        while (!m_stream.atEnd()) {
+            const QString line = m_stream.readLine();
+            if (line.trimmed().isEmpty())
+                continue;
+            fields = split(line);
+            return true;
+        }
+        return false;
+    }
+
+    bool hasColumn(const QString &name) const { return m_columns.contains(name); }
+
+    QString value(const QStringList &fields, const QString &name, const QString &fallback = QString()) const
+    {
+        const int index = m_columns.value(name, -1);
+        return (index >= 0 && index < fields.size()) ? fields.at(index).trimmed() : fallback;
+    }
+
+    double number(const QStringList &fields, const QString &name, double fallback = 0.0) const
+    {
+        bool ok = false;
+        const double v = value(fields, name).toDouble(&ok);
+        return ok ? v : fallback;
+    }
+
+    QString error() const { return m_error; }
+
+private:
+    static QStringList split(const QString &line)
+    {
+        QStringList fields;
+        QString current;
+        bool quoted = false;
+        for (int i = 0; i < line.size(); ++i) {
+            const QChar ch = line.at(i);
+            if (ch == QLatin1Char('"')) {
+                if (quoted && i + 1 < line.size() && line.at(i + 1) == QLatin1Char('"')) {
+                    current.append(ch);
+                    ++i;
+                } else {
+                    quoted = !quoted;
+                }
+            } else if (ch == QLatin1Char(',') && !quoted) {
+                fields.append(current);
+                current.clear();
+            } else {
+                current.append(ch);
+            }
+        }
+        fields.append(current);
+        return fields;
+    }
+
+    QFile m_file;
+    QTextStream m_stream;
+    QHash<QString, int> m_columns;
+    QString m_error;
+};
+
+QString csvField(const QString &value)
+{
+    if (value.contains(QLatin1Char(',')) || value.contains(QLatin1Char('"')))
+        return QLatin1Char('"') + QString(value).replace(QLatin1String("\""), QLatin1String("\"\"")) + QLatin1Char('"');
+    return value;
+}
+
+QString num(double value)
+{
+    return QString::number(value, 'g', 10);
+}
+
+// Reads rows in chunks, maps each chunk on the thread pool and writes it out in input order
+template <typename Row, typename Result>
+qint64 streamChunks(const std::function<bool(Row &)> &next,
+                    const std::function<Result(const Row &)> &compute,
+                    const std::function<void(const Row &, const Result &)> &write)
+{
+    qint64 total = 0;
+    QVector<Row> chunk;
+    chunk.reserve(ChunkSize);
+    bool more = true;
+    while (more) {
+        chunk.clear();
+        Row row;
+        while (chunk.size() < ChunkSize && (more = next(row)))
+            chunk.append(row);
+        if (chunk.isEmpty())
+            break;
+
+        const QVector<Result> results = QtConcurrent::blockingMapped<QVector<Result>>(chunk, compute);
+        for (int i = 0; i < chunk.size(); ++i)
+            write(chunk.at(i), results.at(i));
+        total += chunk.size();
+    }
+    return total;
+}
+
+bool openLibraryDb(const QString &path)
+{
+    if (!DatabaseConnection::instance().initialize(path)) {
+        err() << "Cannot open library database " << path << ": " << DatabaseConnection::instance().lastError() << Qt::endl;
+        return false;
+    }
+    return true;
+}
+
+bool openShipDb(const QString &path)
+{
+    if (!DatabaseShipConnection::instance().initialize(path)) {
+        err() << "Cannot open ship database " << path << ": " << DatabaseShipConnection::instance().getLastError() << Qt::endl;
+        return false;
+    }
+    return true;
+}
+
+bool sameValue(double stored, double computed)
+{
+    return std::abs(stored - computed) <= 0.011;
+}
+
+// ---------------- profiles ----------------
+
+struct ProfileRow {
+    int id = 0;
+    QString type;
+    QString name;
+    double hw = 0.0, tw = 0.0, bf = 0.0, tf = 0.0;
+    ProfileFormulas::SectionProperties stored;
+};
+
+int runProfiles(const QCommandLineParser &parser, QTextStream &out)
+{
+    CsvReader csv;
+    QSqlQuery query;
+    std::function<bool(ProfileRow &)> next;
+
+    if (parser.isSet("csv")) {
+        if (!csv.open(parser.value("csv"))) {
+            err() << "Cannot read " << parser.value("csv") << ": " << csv.error() << Qt::endl;
+            return 2;
+        }
+        const QString bfColumn = csv.hasColumn("bf_profiles") ? QStringLiteral("bf_profiles") : QStringLiteral("bf");
+        int line = 0;
+        next = [&csv, bfColumn, line](ProfileRow &row) mutable {
+            QStringList f;
+            if (!csv.next(f))
+                return false;
+            row = ProfileRow();
+            row.id = csv.hasColumn("id") ? csv.value(f, "id").toInt() : ++line;
+            row.type = csv.value(f, "type");
+            row.name = csv.value(f, "name");
+            row.hw = csv.number(f, "hw");
+            row.tw = csv.number(f, "tw");
+            row.bf = csv.number(f, bfColumn);
+            row.tf = csv.number(f, "tf");
+            row.stored.area = csv.number(f, "area");
+            row.stored.e = csv.number(f, "e");
+            row.stored.w = csv.number(f, "w");
+            row.stored.upperI = csv.number(f, "upper_i");
+            return true;
+        };
+    } else if (parser.isSet("library-db")) {
+        if (!openLibraryDb(parser.value("library-db")))
+            return 2;
+        query = QSqlQuery(DatabaseConnection::instance().database());
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT id, type, name, hw, tw, bf_profiles, tf, area, e, w, upper_i "
+                        "FROM structure_seagoing_ship_section0_profile_table ORDER BY id")) {
+            err() << "Query failed: " << query.lastError().text() << Qt::endl;
+            return 2;
+        }
+        next = [&query](ProfileRow &row) {
+            if (!query.next())
+                return false;
+            row.id = query.value(0).toInt();
+            row.type = query.value(1).toString();
+            row.name = query.value(2).toString();
+            row.hw = query.value(3).toDouble();
+            row.tw = query.value(4).toDouble();
+            row.bf = query.value(5).toDouble();
+            row.tf = query.value(6).toDouble();
+            row.stored.area = query.value(7).toDouble();
+            row.stored.e = query.value(8).toDouble();
+            row.stored.w = query.value(9).toDouble();
+            row.stored.upperI = query.value(10).toDouble();
+            return true;
+        };
+    } else {
+        err() << "profiles needs --library-db or --csv" << Qt::endl;
+        return 2;
+    }
+
+    out << "id,type,name,hw,tw,bf,tf,area,e,w,upper_i,status\n";
+    int mismatches = 0;
+    const qint64 total = streamChunks<ProfileRow, ProfileFormulas::SectionProperties>(
+        next,
+        [](const ProfileRow &row) {
+            return ProfileFormulas::sectionProperties(row.hw, row.tw, row.bf, row.tf, row.type);
+        },
+        [&out, &mismatches](const ProfileRow &row, const ProfileFormulas::SectionProperties &s) {
+            // "new" when nothing is stored yet, otherwise compare against the stored values
+            QString status = QStringLiteral("new");
+            const ProfileFormulas::SectionProperties &st = row.stored;
+            if (st.area != 0.0 || st.e != 0.0 || st.w != 0.0 || st.upperI != 0.0) {
+                const bool ok = sameValue(st.area, s.area) && sameValue(st.e, s.e)
+                                && sameValue(st.w, s.w) && sameValue(st.upperI, s.upperI);
+                status = ok ? QStringLiteral("ok") : QStringLiteral("mismatch");
+                if (!ok)
+                    ++mismatches;
+            }
+            out << row.id << ',' << csvField(row.type) << ',' << csvField(row.name) << ','
+                << num(row.hw) << ',' << num(row.tw) << ',' << num(row.bf) << ',' << num(row.tf) << ','
+                << num(s.area) << ',' << num(s.e) << ',' << num(s.w) << ',' << num(s.upperI) << ','
+                << status << '\n';
+        });
+
+    out.flush();
+    err() << "profiles: " << total << " rows, " << mismatches << " mismatches" << Qt::endl;
+    return 0;
+}
+
+// ---------------- brackets ----------------
+
+struct BracketRow {
+    int id = 0;
+    QString name;
+    double tw = 0.0, w = 0.0;
+    double rehProfile = 235.0, rehBracket = 235.0;
+};
+
+int runBrackets(const QCommandLineParser &parser, QTextStream &out)
+{
+    const double defaultRehProfile = parser.value("reh-profile").toDouble();
+    const double defaultRehBracket = parser.value("reh-bracket").toDouble();
+    if (defaultRehProfile <= 0.0 || defaultRehBracket <= 0.0) {
+        err() << "--reh-profile and --reh-bracket must be positive" << Qt::endl;
+        return 2;
+    }
+
+    CsvReader csv;
+    QSqlQuery query;
+    std::function<bool(BracketRow &)> next;
+
+    if (parser.isSet("csv")) {
+        if (!csv.open(parser.value("csv"))) {
+            err() << "Cannot read " << parser.value("csv") << ": " << csv.error() << Qt::endl;
+            return 2;
+        }
+        int line = 0;
+        next = [&csv, line, defaultRehProfile, defaultRehBracket](BracketRow &row) mutable {
+            QStringList f;
+            if (!csv.next(f))
+                return false;
+            row = BracketRow();
+            row.id = csv.hasColumn("id") ? csv.value(f, "id").toInt() : ++line;
+            row.name = csv.value(f, "name");
+            row.tw = csv.number(f, "tw");
+            row.w = csv.number(f, "w");
+            row.rehProfile = csv.number(f, "reh_profile", defaultRehProfile);
+            row.rehBracket = csv.number(f, "reh_bracket", defaultRehBracket);
+            return true;
+        };
+    } else if (parser.isSet("library-db")) {
+        if (!openLibraryDb(parser.value("library-db")))
+            return 2;
+        query = QSqlQuery(DatabaseConnection::instance().database());
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT id, name, tw, w FROM structure_seagoing_ship_section0_profile_table ORDER BY id")) {
+            err() << "Query failed: " << query.lastError().text() << Qt::endl;
+            return 2;
+        }
+        next = [&query, defaultRehProfile, defaultRehBracket](BracketRow &row) {
+            if (!query.next())
+                return false;
+            row.id = query.value(0).toInt();
+            row.name = query.value(1).toString();
+            row.tw = query.value(2).toDouble();
+            row.w = query.value(3).toDouble();
+            row.rehProfile = defaultRehProfile;
+            row.rehBracket = defaultRehBracket;
+            return true;
+        };
+    } else {
+        err() << "brackets needs --library-db or --csv" << Qt::endl;
+        return 2;
+    }
+
+    out << "id,name,tw,w,reh_profile,reh_bracket,l,tb,bf,tbf\n";
+    const qint64 total = streamChunks<BracketRow, ProfileFormulas::BracketSizes>(
+        next,
+        [](const BracketRow &row) {
+            return ProfileFormulas::bracketSizes(row.tw, row.w, row.rehProfile, row.rehBracket);
+        },
+        [&out](const BracketRow &row, const ProfileFormulas::BracketSizes &b) {
+            out << row.id << ',' << csvField(row.name) << ',' << num(row.tw) << ',' << num(row.w) << ','
+                << num(row.rehProfile) << ',' << num(row.rehBracket) << ','
+                << num(b.l) << ',' << num(b.tb) << ',' << num(b.bf) << ',' << num(b.tbf) << '\n';
+        });
+
+    out.flush();
+    err() << "brackets: " << total << " rows" << Qt::endl;
+    return 0;
+}
+
+// ---------------- xz-recalc ----------------
+
+int runXZRecalc(const QCommandLineParser &parser, QTextStream &out)
+{
+    const double lpp = parser.value("lpp").toDouble();
+    const double upperL = parser.value("length").toDouble();
+    QVector<FrameCoordinates::FrameRow> rows;
+
+    if (parser.isSet("csv")) {
+        CsvReader csv;
+        if (!csv.open(parser.value("csv"))) {
+            err() << "Cannot read " << parser.value("csv") << ": " << csv.error() << Qt::endl;
+            return 2;
+        }
+        QStringList f;
+        while (csv.next(f)) {
+            FrameCoordinates::FrameRow row;
+            row.id = csv.hasColumn("id") ? csv.value(f, "id").toInt() : int(rows.size()) + 1;
+            row.frameNumber = csv.value(f, "frame_number").toInt();
+            row.frameName = csv.value(f, "frame_name", QStringLiteral("Frame %1").arg(row.frameNumber));
+            row.frameSpacing = csv.value(f, "frame_spacing").toInt();
+            row.ml = csv.value(f, "ml", QStringLiteral("FORWARD"));
+            rows.append(row);
+        }
+    } else if (parser.isSet("ship-db")) {
+        if (!openShipDb(parser.value("ship-db")))
+            return 2;
+        QSqlQuery query(DatabaseShipConnection::instance().getDatabase());
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT id, frame_name, frame_number, frame_spacing, ml "
+                        "FROM structure_seagoing_ship_section0_frame_arrangement_xz")) {
+            err() << "Query failed: " << query.lastError().text() << Qt::endl;
+            return 2;
+        }
+        while (query.next()) {
+            FrameCoordinates::FrameRow row;
+            row.id = query.value(0).toInt();
+            row.frameName = query.value(1).toString();
+            row.frameNumber = query.value(2).toInt();
+            row.frameSpacing = query.value(3).toInt();
+            row.ml = query.value(4).toString();
+            rows.append(row);
+        }
+    } else {
+        err() << "xz-recalc needs --ship-db or --csv" << Qt::endl;
+        return 2;
+    }
+
+    FrameCoordinates::recompute(rows, lpp, upperL);
+
+    if (parser.isSet("write")) {
+        if (!parser.isSet("ship-db")) {
+            err() << "--write needs --ship-db" << Qt::endl;
+            return 2;
+        }
+        QSqlDatabase db = DatabaseShipConnection::instance().getDatabase();
+        // Only xp_coor is written; x_l, xll_coor and xll_lll are derived on read
+        QVariantList xps, ids;
+        for (const FrameCoordinates::FrameRow &row : rows) {
+            xps << row.xpCoor;
+            ids << row.id;
+        }
+        db.transaction();
+        QSqlQuery update(db);
+        update.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_xz "
+                       "SET xp_coor=?, updated_at=(strftime('%s','now')*1000) WHERE id=?");
+        for (const QVariantList &column : { xps, ids })
+            update.addBindValue(column);
+        if (!update.execBatch() || !db.commit()) {
+            err() << "Update failed: " << update.lastError().text() << Qt::endl;
+            db.rollback();
+            return 2;
+        }
+    }
+
+    out << "id,frame_name,frame_number,frame_spacing,ml,xp_coor,x_l,xll_coor,xll_lll\n";
+    for (const FrameCoordinates::FrameRow &row : rows) {
+        out << row.id << ',' << csvField(row.frameName) << ',' << row.frameNumber << ',' << row.frameSpacing << ','
+            << csvField(row.ml) << ',' << num(row.xpCoor) << ',' << num(row.xl) << ','
+            << num(row.xllCoor) << ',' << num(row.xllLll) << '\n';
+    }
+    out.flush();
+    err() << "xz-recalc: " << rows.size() << " frames" << (parser.isSet("write") ? ", written" : "") << Qt::endl;
+    return 0;
+}
+
+// ---------------- yz-validate ----------------
+
+int runYZValidate(const QCommandLineParser &parser, QTextStream &out)
+{
+    QVector<YZNaming::NameRow> rows;
+
+    if (parser.isSet("csv")) {
+        CsvReader csv;
+        if (!csv.open(parser.value("csv"))) {
+            err() << "Cannot read " << parser.value("csv") << ": " << csv.error() << Qt::endl;
+            return 2;
+        }
+        QStringList f;
+        while (csv.next(f)) {
+            YZNaming::NameRow row;
+            row.id = csv.hasColumn("id") ? csv.value(f, "id").toInt() : int(rows.size()) + 1;
+            row.name = csv.value(f, "name");
+            row.no = csv.value(f, "no").toInt();
+            row.frameNo = csv.value(f, "frame_no").toInt();
+            rows.append(row);
+        }
+    } else if (parser.isSet("ship-db")) {
+        if (!openShipDb(parser.value("ship-db")))
+            return 2;
+        QSqlQuery query(DatabaseShipConnection::instance().getDatabase());
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT id, name, no, frame_no FROM structure_seagoing_ship_section0_frame_arrangement_yz ORDER BY id")) {
+            err() << "Query failed: " << query.lastError().text() << Qt::endl;
+            return 2;
+        }
+        while (query.next()) {
+            YZNaming::NameRow row;
+            row.id = query.value(0).toInt();
+            row.name = query.value(1).toString();
+            row.no = query.value(2).toInt();
+            row.frameNo = query.value(3).toInt();
+            rows.append(row);
+        }
+    } else {
+        err() << "yz-validate needs --ship-db or --csv" << Qt::endl;
+        return 2;
+    }
+
+    // Prefix groups are independent, so each one is validated on its own thread
+    const QHash<QString, QVector<YZNaming::NameRow>> groups = YZNaming::groupByPrefix(rows);
+    QStringList prefixes = groups.keys();
+    std::sort(prefixes.begin(), prefixes.end());
+    QVector<QVector<YZNaming::NameRow>> groupList;
+    for (const QString &prefix : prefixes)
+        groupList.append(groups.value(prefix));
+
+    const QVector<QVector<YZNaming::Issue>> issuesPerGroup =
+        QtConcurrent::blockingMapped<QVector<QVector<YZNaming::Issue>>>(groupList, &YZNaming::validateGroup);
+
+    int issueCount = 0;
+    out << "id,name,kind,detail\n";
+    for (const QVector<YZNaming::Issue> &issues : issuesPerGroup) {
+        for (const YZNaming::Issue &issue : issues) {
+            out << issue.id << ',' << csvField(issue.name) << ',' << issue.kind << ',' << csvField(issue.detail) << '\n';
+            ++issueCount;
+        }
+    }
+    out.flush();
+    err() << "yz-validate: " << rows.size() << " rows, " << prefixes.size() << " prefixes, "
+          << issueCount << " issues" << Qt::endl;
+    return issueCount > 0 ? 1 : 0;
+}
+
+// ---------------- yz-export ----------------
+
+struct SectionExport {
+    int frameNo = 0;
+    QString fileName;
+    int lines = 0;
+    QString error;
+};
+
+// Prefix and start suffix of a YZ row: the stored columns when the table has them and they
+// are filled, otherwise parsed from the name
+void yzPrefixSuffix(const QString &name, const QVariant &storedPrefix, const QVariant &storedSuffix,
+                    QString &prefix, int &suffix)
+{
+    prefix = storedPrefix.toString();
+    suffix = storedSuffix.toInt();
+    if (prefix.isEmpty())
+        YZNaming::parsePrefixSuffix(name, prefix, suffix);
+}
+
+// One frame on the calling worker thread, over its own read-only connection
+SectionExport exportSection(const QString &shipDb, int frameNo, const QString &format, const QString &outDir,
+                            double halfWidthMM, double heightMM, const QVector<QPointF> &hull,
+                            bool storedPrefix, const YZPrefixPalette &palette)
+{
+    SectionExport result;
+    result.frameNo = frameNo;
+    result.fileName = QDir(outDir).filePath(QStringLiteral("frame_%1.%2").arg(frameNo).arg(format));
+
+    const QString connection = QStringLiteral("yz-export-%1").arg(frameNo);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection);
+        db.setDatabaseName(shipDb);
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+        QFile file(result.fileName);
+        if (!db.open()) {
+            result.error = db.lastError().text();
+        } else if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            result.error = file.errorString();
+        } else {
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            // The read-only connection cannot add the prefix/suffix columns to older tables
+            query.prepare(QStringLiteral("SELECT name, no, spacing, y, z, sym%1 "
+                                         "FROM structure_seagoing_ship_section0_frame_arrangement_yz WHERE frame_no = ?")
+                              .arg(storedPrefix ? QStringLiteral(", prefix, suffix") : QString()));
+            query.addBindValue(frameNo);
+
+            std::unique_ptr<YZSectionSink> sink;
+            if (format == QLatin1String("dxf"))
+                sink = std::make_unique<YZDxfSink>(&file);
+            else
+                sink = std::make_unique<YZSvgSink>(&file);
+            YZSectionExporter exporter(sink.get());
+            exporter.setOutline(halfWidthMM, heightMM);
+            exporter.setHullPolygon(hull);
+            exporter.setPalette(palette);
+
+            // Empty Y/Z columns are NULL (or '' when written from text fields)
+            auto present = [](const QVariant &v) { return !v.isNull() && !v.toString().isEmpty(); };
+            if (!query.exec()) {
+                result.error = query.lastError().text();
+            } else if (!exporter.begin()) {
+                result.error = QStringLiteral("cannot write output");
+            } else {
+                while (query.next()) {
+                    YZLineGeometry::Row row;
+                    int suffix = 0;
+                    yzPrefixSuffix(query.value(0).toString(), storedPrefix ? query.value(6) : QVariant(),
+                                   storedPrefix ? query.value(7) : QVariant(), row.prefix, suffix);
+                    row.suffix = suffix;
+                    row.count = query.value(1).toInt();
+                    row.spacing = query.value(2).toDouble();
+                    row.hasY = present(query.value(3));
+                    row.hasZ = present(query.value(4));
+                    row.y = query.value(3).toDouble();
+                    row.z = query.value(4).toDouble();
+                    row.sym = query.value(5).toString();
+                    exporter.addRow(row);
+                }
+                if (!exporter.end())
+                    result.error = file.errorString();
+                result.lines = exporter.lineCount();
+            }
+        }
+    }
+    QSqlDatabase::removeDatabase(connection);
+    return result;
+}
+
+int runYZExport(const QCommandLineParser &parser, QTextStream &out)
+{
+    const QString format = parser.value("format").toLower();
+    if (format != QLatin1String("svg") && format != QLatin1String("dxf")) {
+        err() << "yz-export writes svg or dxf (PDF export is in the application)" << Qt::endl;
+        return 2;
+    }
+    if (!parser.isSet("ship-db")) {
+        err() << "yz-export needs --ship-db" << Qt::endl;
+        return 2;
+    }
+    const QString shipDb = parser.value("ship-db");
+    const QString outDir = parser.value("out-dir");
+    if (!QDir().mkpath(outDir)) {
+        err() << "Cannot create " << outDir << Qt::endl;
+        return 2;
+    }
+    if (!openShipDb(shipDb))
+        return 2;
+
+    // Hull outline from the principal dimensions (m), canvas defaults when not entered yet
+    double halfWidthMM = 24384.0 / 2.0;
+    double heightMM = 5490.0;
+    QSqlQuery query(DatabaseShipConnection::instance().getDatabase());
+    query.setForwardOnly(true);
+    if (query.exec("SELECT b, d FROM structure_seagoing_ship_section0_principal_dimensions WHERE id = 1") && query.next()) {
+        if (query.value(0).toDouble() > 0.0)
+            halfWidthMM = query.value(0).toDouble() * 1000.0 / 2.0;
+        if (query.value(1).toDouble() > 0.0)
+            heightMM = query.value(1).toDouble() * 1000.0;
+    }
+
+    // Hull sections from the offset table at each frame's xpCoor, when both are there
+    HullSection section;
+    QHash<int, double> xpByFrame;
+    if (query.exec("SELECT station_x, z, half_breadth FROM structure_seagoing_ship_section0_hull_offsets")) {
+        QVector<HullSection::Offset> offsets;
+        while (query.next())
+            offsets.append({ query.value(0).toDouble(), query.value(1).toDouble(), query.value(2).toDouble() });
+        section.setOffsets(offsets);
+    }
+    if (!section.isEmpty()
+        && query.exec("SELECT frame_number, xp_coor FROM structure_seagoing_ship_section0_frame_arrangement_xz")) {
+        while (query.next())
+            xpByFrame.insert(query.value(0).toInt(), query.value(1).toDouble());
+    }
+
+    // Same prefix colours as the canvas: one palette over every prefix of the table
+    const QSqlRecord yzColumns = DatabaseShipConnection::instance().getDatabase()
+        .record(QStringLiteral("structure_seagoing_ship_section0_frame_arrangement_yz"));
+    const bool storedPrefix = yzColumns.contains(QStringLiteral("prefix")) && yzColumns.contains(QStringLiteral("suffix"));
+    YZPrefixPalette palette;
+    if (query.exec(storedPrefix
+                   ? QStringLiteral("SELECT name, prefix FROM structure_seagoing_ship_section0_frame_arrangement_yz")
+                   : QStringLiteral("SELECT name FROM structure_seagoing_ship_section0_frame_arrangement_yz"))) {
+        QSet<QString> prefixes;
+        while (query.next()) {
+            QString prefix;
+            int suffix = 0;
+            yzPrefixSuffix(query.value(0).toString(), storedPrefix ? query.value(1) : QVariant(), QVariant(),
+                           prefix, suffix);
+            prefixes.insert(prefix);
+        }
+        palette.assign(QVector<QString>(prefixes.begin(), prefixes.end()));
+    }
+
+    QVector<int> frames;
+    if (parser.isSet("frame")) {
+        frames.append(parser.value("frame").toInt());
+    } else {
+        if (!query.exec("SELECT DISTINCT frame_no FROM structure_seagoing_ship_section0_frame_arrangement_yz ORDER BY frame_no")) {
+            err() << "Query failed: " << query.lastError().text() << Qt::endl;
+            return 2;
+        }
+        while (query.next())
+            frames.append(query.value(0).toInt());
+    }
+    query.finish();
+
+    // Frames are independent: each one is streamed to its file on its own thread
+    const QVector<SectionExport> results = QtConcurrent::blockingMapped<QVector<SectionExport>>(
+        frames, [&](int frameNo) {
+            const auto xp = xpByFrame.constFind(frameNo);
+            const QVector<QPointF> hull = xp != xpByFrame.constEnd() ? section.polygonAt(*xp) : QVector<QPointF>();
+            return exportSection(shipDb, frameNo, format, outDir, halfWidthMM, heightMM, hull, storedPrefix, palette);
+        });
+
+    int failures = 0;
+    qint64 lines = 0;
+    out << "frame_no,file,lines,status\n";
+    for (const SectionExport &r : results) {
+        out << r.frameNo << ',' << csvField(r.fileName) << ',' << r.lines << ','
+            << (r.error.isEmpty() ? QStringLiteral("ok") : csvField(r.error)) << '\n';
+        if (!r.error.isEmpty())
+            ++failures;
+        lines += r.lines;
+    }
+    out.flush();
+    err() << "yz-export: " << results.size() << " frames, " << lines << " lines, " << failures << " failed" << Qt::endl;
+    return failures > 0 ? 2 : 0;
+}
+
+// ---------------- girder / weight ----------------
+
+bool parseAssignment(const QString &text, PrefixMembers::Member &member)
+{
+    // "BL=HP 200x10:12:deck:2" = prefix=profile:plate thickness mm[:bottom|deck[:material number]]
+    const int eq = text.indexOf(QLatin1Char('='));
+    if (eq <= 0)
+        return false;
+    const QStringList values = text.mid(eq + 1).split(QLatin1Char(':'));
+    if (values.size() < 2 || values.size() > 4)
+        return false;
+    bool ok = false, matOk = true;
+    member.prefix = text.left(eq).trimmed().toUpper();
+    member.profileName = values.at(0).trimmed();
+    member.plateThickness = values.at(1).trimmed().toDouble(&ok);
+    member.placement = PrefixMembers::placementFromString(values.size() >= 3 ? values.at(2).trimmed() : QString());
+    member.matNo = values.size() == 4 ? values.at(3).trimmed().toInt(&matOk) : 0;
+    return ok && matOk && member.plateThickness >= 0.0 && member.matNo >= 0;
+}
+
+// Ship and library models of the application, loaded from the open databases, with the
+// --assign members saved first
+struct ShipModels {
+    FrameArrangementXZ frameXZ;
+    FrameArrangementYZ frameYZ;
+    PrincipalDimensions dimensions;
+    HullOffsets hullOffsets;
+    PrefixMembers members;
+    LinearIsotropicMaterials materials;
+    std::unique_ptr<StructureProfileTableController> profiles;
+
+    bool load(const QCommandLineParser &parser, const QString &command)
+    {
+        QVector<PrefixMembers::Member> assignments;
+        for (const QString &text : parser.values("assign")) {
+            PrefixMembers::Member member;
+            if (!parseAssignment(text, member)) {
+                err() << "Invalid --assign " << text << ", expected PREFIX=PROFILE:THICKNESS[:bottom|deck[:MATNO]]" << Qt::endl;
+                return false;
+            }
+            assignments.append(member);
+        }
+        if (!parser.isSet("ship-db")) {
+            err() << command << " needs --ship-db" << Qt::endl;
+            return false;
+        }
+        if (!openShipDb(parser.value("ship-db")))
+            return false;
+        if (parser.isSet("library-db") && !openLibraryDb(parser.value("library-db")))
+            return false;
+
+        if (!frameXZ.loadData() || !frameYZ.loadData() || !members.createTable() || !members.loadData()) {
+            err() << "Cannot read the ship database: " << DatabaseShipConnection::instance().getLastError()
+                  << members.lastError() << Qt::endl;
+            return false;
+        }
+        dimensions.loadData();
+        hullOffsets.loadData();
+        QHash<int, double> xpByFrame;
+        for (const FrameArrangementXZ::FrameData &frame : frameXZ.frames())
+            xpByFrame.insert(frame.frameNumber, frame.xpCoor);
+        hullOffsets.setFramePositions(xpByFrame);
+
+        for (const PrefixMembers::Member &member : assignments) {
+            if (!members.setMember(member)) {
+                err() << command << ": " << members.lastError() << Qt::endl;
+                return false;
+            }
+        }
+
+        if (parser.isSet("library-db")) {
+            profiles = std::make_unique<StructureProfileTableController>();
+            profiles->initialize();
+        }
+        return true;
+    }
+};
+
+int runGirder(const QCommandLineParser &parser, QTextStream &out)
+{
+    ShipModels ship;
+    if (!ship.load(parser, QStringLiteral("girder")))
+        return 2;
+
+    // Same controller as the application, wired the same way
+    HullGirderController girder;
+    QStringList errors;
+    QObject::connect(&girder, &HullGirderController::errorOccurred, [&errors](const QString &error) {
+        if (!errors.contains(error)) errors.append(error);
+    });
+    if (ship.profiles)
+        girder.setProfileController(ship.profiles.get());
+    girder.setPrincipalDimensions(&ship.dimensions);
+    girder.setHullOffsets(&ship.hullOffsets);
+    girder.setPrefixMembers(&ship.members);
+    girder.setModel(&ship.frameYZ);
+
+    QVector<int> frames;
+    if (parser.isSet("frame")) {
+        frames.append(parser.value("frame").toInt());
+    } else {
+        QSet<int> seen;
+        for (const FrameArrangementYZ::FrameYZData &row : ship.frameYZ.allFrames())
+            seen.insert(row.frameNo);
+        frames = QVector<int>(seen.begin(), seen.end());
+        std::sort(frames.begin(), frames.end());
+    }
+
+    out << "frame_no,elements,unplated,area_m2,neutral_axis_m,inertia_m4,modulus_deck_m3,modulus_keel_m3\n";
+    int invalid = 0;
+    for (int frameNo : frames) {
+        girder.setFrameNo(frameNo);
+        const QVariantMap r = girder.result();
+        if (!r.value("valid").toBool())
+            ++invalid;
+        out << frameNo << ',' << r.value("elements").toInt() << ',' << r.value("unplated").toInt() << ','
+            << num(r.value("area").toDouble()) << ',' << num(r.value("neutralAxis").toDouble()) << ','
+            << num(r.value("inertia").toDouble()) << ',' << num(r.value("modulusDeck").toDouble()) << ','
+            << num(r.value("modulusKeel").toDouble()) << '\n';
+    }
+    out.flush();
+    for (const QString &error : errors)
+        err() << "girder: " << error << Qt::endl;
+    err() << "girder: " << frames.size() << " frames, " << invalid << " without section area; "
+          << HullGirderSection::scope() << Qt::endl;
+    return 0;
+}
+
+int runWeight(const QCommandLineParser &parser, QTextStream &out)
+{
+    ShipModels ship;
+    if (!ship.load(parser, QStringLiteral("weight")))
+        return 2;
+    if (!parser.isSet("library-db"))
+        err() << "weight: no --library-db, material densities and profiles are unknown" << Qt::endl;
+
+    StructuralWeightController weight;
+    QStringList errors;
+    QObject::connect(&weight, &StructuralWeightController::errorOccurred, [&errors](const QString &error) {
+        if (!errors.contains(error)) errors.append(error);
+    });
+    if (parser.isSet("library-db")) {
+        weight.setMaterials(&ship.materials);
+        weight.setProfileController(ship.profiles.get());
+    }
+    if (parser.isSet("default-material"))
+        weight.setDefaultMaterial(parser.value("default-material").toInt());
+    weight.setPrincipalDimensions(&ship.dimensions);
+    weight.setFrameModel(&ship.frameXZ);
+    weight.setModel(&ship.frameYZ);
+    weight.setHullOffsets(&ship.hullOffsets);
+    weight.setPrefixMembers(&ship.members);
+
+    // One line for the whole, then per prefix and per frame zone
+    const QVariantMap r = weight.result();
+    auto write = [&out](const QString &group, const QString &key, const QVariantMap &w) {
+        out << group << ',' << csvField(key) << ',' << num(w.value("mass").toDouble()) << ','
+            << num(w.value("lcg").toDouble()) << ',' << num(w.value("vcg").toDouble()) << '\n';
+    };
+    out << "group,key,mass_t,lcg_m,vcg_m\n";
+    write(QStringLiteral("total"), QString(), r);
+    for (const QVariant &entry : r.value("prefixes").toList())
+        write(QStringLiteral("prefix"), entry.toMap().value("prefix").toString(), entry.toMap());
+    for (const QVariant &entry : r.value("zones").toList()) {
+        const QVariantMap zone = entry.toMap();
+        write(QStringLiteral("zone"), QString("%1-%2").arg(zone.value("firstFrame").toInt()).arg(zone.value("lastFrame").toInt()), zone);
+    }
+    out.flush();
+    for (const QString &error : errors)
+        err() << "weight: " << error << Qt::endl;
+    err() << "weight: " << num(r.value("mass").toDouble()) << " t of longitudinals and their plate strips "
+          << "(no transverse structure or plating outside the YZ rows)" << Qt::endl;
+    return 0;
+}
+
+// ---------------- generate ----------------
+
+bool parseZones(const QString &text, QVector<SyntheticShipGenerator::SpacingZone> &zones)
+{
+    // "-5:0:600,0:180:700,180:210:600" = start:end:spacing per zone
+    zones.clear();
+    const QStringList parts = text.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        const QStringList values = part.split(QLatin1Char(':'));
+        if (values.size() != 3)
+            return false;
+        bool ok1 = false, ok2 = false, ok3 = false;
+        SyntheticShipGenerator::SpacingZone zone{ values.at(0).trimmed().toInt(&ok1),
+                                                  values.at(1).trimmed().toInt(&ok2),
+                                                  values.at(2).trimmed().toInt(&ok3) };
+        if (!ok1 || !ok2 || !ok3 || zone.endFrame < zone.startFrame || zone.spacing <= 0)
+            return false;
+        zones.append(zone);
+    }
+    return !zones.isEmpty();
+}
+
+int runGenerate(const QCommandLineParser &parser)
+{
+    if (!parser.isSet("ship-db") && !parser.isSet("library-db")) {
+        err() << "generate needs --ship-db and/or --library-db" << Qt::endl;
+        return 2;
+    }
+
+    SyntheticShipGenerator::Spec spec;
+    if (parser.isSet("zones") && !parseZones(parser.value("zones"), spec.zones)) {
+        err() << "Invalid --zones, expected start:end:spacing[,start:end:spacing...]" << Qt::endl;
+        return 2;
+    }
+    spec.seed = parser.value("seed").toUInt();
+    spec.rehProfile = parser.value("reh-profile").toDouble();
+    spec.rehBracket = parser.value("reh-bracket").toDouble();
+    if (spec.rehProfile <= 0.0 || spec.rehBracket <= 0.0) {
+        err() << "--reh-profile and --reh-bracket must be positive" << Qt::endl;
+        return 2;
+    }
+    if (parser.isSet("yz-groups"))
+        spec.yzGroupCount = parser.value("yz-groups").toInt();
+    if (parser.isSet("lines-per-group"))
+        spec.linesPerGroup = parser.value("lines-per-group").toInt();
+    if (parser.isSet("yz-frames"))
+        spec.yzFrameCount = parser.value("yz-frames").toInt();
+    if (parser.isSet("prefixes"))
+        spec.prefixes = parser.value("prefixes").split(QLatin1Char(','), Qt::SkipEmptyParts);
+    if (parser.isSet("profile-count"))
+        spec.profileCount = parser.value("profile-count").toInt();
+    if (parser.isSet("material-count"))
+        spec.materialCount = parser.value("material-count").toInt();
+
+    SyntheticShipGenerator generator(spec);
+    if (parser.isSet("ship-db")) {
+        if (!openShipDb(parser.value("ship-db")) || !generator.generateShip()) {
+            err() << "generate: " << generator.lastError() << Qt::endl;
+            return 2;
+        }
+    }
+    if (parser.isSet("library-db")) {
+        if (!openLibraryDb(parser.value("library-db")) || !generator.generateLibrary()) {
+            err() << "generate: " << generator.lastError() << Qt::endl;
+            return 2;
+        }
+    }
+
+    const SyntheticShipGenerator::Summary summary = generator.summary();
+    err() << "generate: " << summary.frames << " frames, " << summary.yzGroups << " YZ groups ("
+          << summary.yzLines << " lines), " << summary.profiles << " profiles, "
+          << summary.materials << " materials" << Qt::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dewaruci-cli");
+    QCoreApplication::setApplicationVersion(APP_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless batch tool for DewaruciCpp profile, bracket and frame arrangement data.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("command", "profiles | brackets | xz-recalc | yz-validate | yz-export | girder | weight | generate");
+    parser.addOptions({
+        { "library-db", "Library database (profiles, materials).", "file" },
+        { "ship-db", "Ship database (frame arrangement XZ/YZ).", "file" },
+        { "csv", "Read input rows from a CSV file with a header line instead of a database.", "file" },
+        { { "o", "output" }, "Write results to file instead of stdout.", "file" },
+        { "threads", "Worker threads (default: all cores).", "n" },
+        { "reh-profile", "ReH of the profile in N/mm2 (brackets, generate).", "n", "235" },
+        { "reh-bracket", "ReH of the bracket in N/mm2 (brackets, generate).", "n", "235" },
+        { "lpp", "Length between perpendiculars in m (xz-recalc).", "m", "87.780" },
+        { "length", "Scantling length L in m (xz-recalc).", "m", "87.7824" },
+        { "write", "Write recomputed XZ coordinates back to the ship database." },
+        { "format", "Drawing format svg | dxf (yz-export).", "format", "svg" },
+        { "out-dir", "Directory for the exported drawings (yz-export).", "dir", "." },
+        { "frame", "Only this frame number (yz-export, girder).", "n" },
+        { "assign", "Save a prefix member PREFIX=PROFILE:THICKNESS[:bottom|deck[:MATNO]], repeatable (girder, weight).", "member" },
+        { "default-material", "Material number of prefixes without one (weight).", "n" },
+        { "zones", "Frame spacing zones start:end:spacing[,...] (generate).", "zones" },
+        { "yz-groups", "Number of YZ longitudinal groups (generate).", "n" },
+        { "lines-per-group", "Lines per YZ group (generate).", "n" },
+        { "yz-frames", "Frames that carry YZ sections (generate).", "n" },
+        { "prefixes", "Comma separated YZ prefixes (generate).", "list" },
+        { "profile-count", "Profiles in the library (generate).", "n" },
+        { "material-count", "Materials in the library (generate).", "n" },
+        { "seed", "Random seed (generate).", "n", "1" },
+        { "verbose", "Keep the debug output of the models." },
+    });
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 1) {
+        err() << parser.helpText();
+        return 2;
+    }
+
+    if (!parser.isSet("verbose"))
+        QLoggingCategory::setFilterRules(QStringLiteral("default.debug=false"));
+
+    if (parser.isSet("threads")) {
+        const int threads = parser.value("threads").toInt();
+        if (threads > 0)
+            QThreadPool::globalInstance()->setMaxThreadCount(threads);
+    }
+
+    QFile outputFile;
+    if (parser.isSet("output")) {
+        outputFile.setFileName(parser.value("output"));
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            err() << "Cannot write " << outputFile.fileName() << ": " << outputFile.errorString() << Qt::endl;
+            return 2;
+        }
+    } else {
+        outputFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    QTextStream out(&outputFile);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString command = positional.first();
+    int result = 2;
+    if (command == "profiles")
+        result = runProfiles(parser, out);
+    else if (command == "brackets")
+        result = runBrackets(parser, out);
+    else if (command == "xz-recalc")
+        result = runXZRecalc(parser, out);
+    else if (command == "yz-validate")
+        result = runYZValidate(parser, out);
+    else if (command == "yz-export")
+        result = runYZExport(parser, out);
+    else if (command == "girder")
+        result = runGirder(parser, out);
+    else if (command == "weight")
+        result = runWeight(parser, out);
+    else if (command == "generate")
+        result = runGenerate(parser);
+    else
+        err() << "Unknown command: " << command << Qt::endl << parser.helpText();
+
+    err() << "done in " << timer.elapsed() << " ms on " << QThreadPool::globalInstance()->maxThreadCount()
+          << " threads" << Qt::endl;
+
+    out.flush();
+    DatabaseConnection::instance().close();
+    DatabaseShipConnection::instance().close();
+    return result;
+}
@@ -7,11 +7,18 @@
 #include "src/database/DatabaseShipConnection.h"
 #include "src/database/models/LinearIsotropicMaterials.h"
 #include "src/database/models/FrameArrangementXZ.h"
+#include "src/database/models/FrameArrangementXZZones.h"
 #include "src/database/models/FrameArrangementYZ.h"
+#include "src/database/models/PrincipalDimensions.h"
+#include "src/database/models/HullOffsets.h"
+#include "src/database/models/PrefixMembers.h"
 #include "src/controllers/StructureProfileTableController.h"
 #include "src/controllers/LinearIsotropicMaterialsController.h"
 #include "src/controllers/FrameArrangementXZController.h"
 #include "src/controllers/FrameArrangementYZController.h"
+#include "src/controllers/HullGirderController.h"
+#include "src/controllers/StructuralWeightController.h"
+#include "src/controllers/RecalculationController.h"
 #include "src/controllers/FrameArrangementYZFrameController.h"
 #include <QQmlEngine>
 
@@ -40,18 +47,44 @@ int main(int argc, char *argv[])
     // Create model instances
     LinearIsotropicMaterials* materialModel = new LinearIsotropicMaterials(&app);
     FrameArrangementXZ* frameXZModel = new FrameArrangementXZ(&app);
+    FrameArrangementXZZones* frameXZZonesModel = new FrameArrangementXZZones(&app);
     FrameArrangementYZ* frameYZModel = new FrameArrangementYZ(&app);
+    PrincipalDimensions* principalDimensions = new PrincipalDimensions(&app);
+    HullOffsets* hullOffsets = new HullOffsets(&app);
+    PrefixMembers* prefixMembers = new PrefixMembers(&app);
     
     // Create controller instances
     LinearIsotropicMaterialsController* materialController = new LinearIsotropicMaterialsController(&app);
     StructureProfileTableController* profileController = new StructureProfileTableController(&app);
     FrameArrangementXZController* frameXZController = new FrameArrangementXZController(&app);
     FrameArrangementYZController* frameYZController = new FrameArrangementYZController(&app);
+    HullGirderController* hullGirderController = new HullGirderController(&app);
+    StructuralWeightController* weightController = new StructuralWeightController(&app);
+    RecalculationController* recalculationController = new RecalculationController(&app);
     
     // Set model for controllers
     materialController->setModel(materialModel);
     frameXZController->setModel(frameXZModel);
     frameYZController->setModel(frameYZModel);
+    hullGirderController->setModel(frameYZModel);
+    hullGirderController->setHullOffsets(hullOffsets);
+    hullGirderController->setPrincipalDimensions(principalDimensions);
+    hullGirderController->setProfileController(profileController);
+    hullGirderController->setPrefixMembers(prefixMembers);
+
+    // Principal dimensions drive the XZ length ratios (one in-memory renormalisation per change)
+    QObject::connect(principalDimensions, &PrincipalDimensions::dimensionsChanged, frameXZController, [=]() {
+        frameXZController->setShipLengths(principalDimensions->lpp(), principalDimensions->length());
+        frameXZZonesModel->setShipLengths(principalDimensions->lpp(), principalDimensions->length());
+    });
+
+    // Hull sections follow the frame positions (frames whose xpCoor is unchanged keep their cache)
+    QObject::connect(frameXZModel, &FrameArrangementXZ::dataChanged, hullOffsets, [=]() {
+        QHash<int, double> xpByFrame;
+        for (const FrameArrangementXZ::FrameData &frame : frameXZModel->frames())
+            xpByFrame.insert(frame.frameNumber, frame.xpCoor);
+        hullOffsets->setFramePositions(xpByFrame);
+    });
     
     // Create tables
     if (DatabaseConnection::instance().isConnected()) {
@@ -63,14 +96,36 @@ int main(int argc, char *argv[])
     if (DatabaseShipConnection::instance().isConnected()) {
         frameXZModel->createTable();
         frameXZModel->loadData();
+        frameXZZonesModel->createTable();
+        frameXZZonesModel->loadData();
         frameYZModel->createTable();
         frameYZModel->loadData();
+        principalDimensions->createTable();
+        principalDimensions->loadData();
+        hullOffsets->createTable();
+        hullOffsets->loadData();
+        prefixMembers->createTable();
+        prefixMembers->loadData();
         
         // Initialize controller data
         frameXZController->getFrameXZList();
     frameYZController->getFrameYZAll();
     }
 
+    // Weight engine is wired once the tables exist (material densities are looked up on assignment)
+    weightController->setMaterials(materialModel);
+    weightController->setProfileController(profileController);
+    weightController->setPrincipalDimensions(principalDimensions);
+    weightController->setFrameModel(frameXZModel);
+    weightController->setModel(frameYZModel);
+    weightController->setHullOffsets(hullOffsets);
+    weightController->setPrefixMembers(prefixMembers);
+
+    // Cross-table recalculation: materials -> bracket sizes, profile dims -> section, spacing -> positions
+    recalculationController->setMaterials(materialModel);
+    recalculationController->setProfileController(profileController);
+    recalculationController->setFrameController(frameXZController);
+
     QQmlApplicationEngine engine;
 
     // Register custom painted item for YZ frame drawing
@@ -80,10 +135,16 @@ int main(int argc, char *argv[])
     engine.rootContext()->setContextProperty("materialModel", materialModel);
     engine.rootContext()->setContextProperty("materialController", materialController);
     engine.rootContext()->setContextProperty("frameXZModel", frameXZModel);
+    engine.rootContext()->setContextProperty("frameXZZonesModel", frameXZZonesModel);
     engine.rootContext()->setContextProperty("frameYZModel", frameYZModel);
+    engine.rootContext()->setContextProperty("principalDimensionsModel", principalDimensions);
+    engine.rootContext()->setContextProperty("hullOffsetsModel", hullOffsets);
     engine.rootContext()->setContextProperty("profileController", profileController);
     engine.rootContext()->setContextProperty("frameXZController", frameXZController);
     engine.rootContext()->setContextProperty("frameYZController", frameYZController);
+    engine.rootContext()->setContextProperty("hullGirderController", hullGirderController);
+    engine.rootContext()->setContextProperty("weightController", weightController);
+    engine.rootContext()->setContextProperty("recalculationController", recalculationController);
     
     QObject::connect(
         &engine,
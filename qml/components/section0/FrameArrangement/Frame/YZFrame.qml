@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import QtQuick.Dialogs
 import DewaruciCpp 1.0
 
 // Reusable Frame Y Z Graph component extracted from FrameArrangement.qml
@@ -29,6 +30,38 @@ Rectangle {
 	property alias graphArea: graphAreaRect
 	signal helpRequested()
 
+	FileDialog {
+		id: offsetsFileDialog
+		title: "Import hull offsets"
+		nameFilters: ["CSV files (*.csv)", "All files (*)"]
+		onAccepted: {
+			if (hullOffsetsModel.importCsv(selectedFile))
+				yzFrameRoot.infoText = "Hull offsets imported: " + hullOffsetsModel.stationCount + " stations"
+		}
+	}
+
+	// Section drawing of the shown frame, same colours and hull clip as on screen
+	FileDialog {
+		id: exportFileDialog
+		title: "Export frame section"
+		fileMode: FileDialog.SaveFile
+		defaultSuffix: "pdf"
+		nameFilters: ["PDF files (*.pdf)", "SVG files (*.svg)", "DXF files (*.dxf)"]
+		onAccepted: {
+			var res = graphAreaRect.exportSection(selectedFile, yzFrameRoot.effectiveFrameNo)
+			yzFrameRoot.infoText = res.success
+				? "Exported " + res.lines + " lines to " + res.path
+				: res.error
+		}
+	}
+
+	Connections {
+		target: typeof hullOffsetsModel !== 'undefined' ? hullOffsetsModel : null
+		function onErrorOccurred(error) {
+			yzFrameRoot.infoText = error
+		}
+	}
+
 	ColumnLayout {
 		anchors.fill: parent
 		anchors.margins: 15
@@ -55,6 +88,25 @@ Rectangle {
 				color: "#2c3e50"
 			}
 			Item { Layout.fillWidth: true }
+			// Hull offset table (station_x, z, half_breadth) that clips the lines to the section
+			Button {
+				text: "Import Offsets"
+				font.pixelSize: 11
+				enabled: typeof hullOffsetsModel !== 'undefined' && hullOffsetsModel !== null
+				onClicked: offsetsFileDialog.open()
+				ToolTip.visible: hovered
+				ToolTip.text: hullOffsetsModel && hullOffsetsModel.stationCount > 0
+					? "Replace the hull offsets (" + hullOffsetsModel.stationCount + " stations loaded)"
+					: "Load hull offsets from a CSV file"
+			}
+			Button {
+				text: "Export Section"
+				font.pixelSize: 11
+				enabled: yzFrameRoot.effectiveFrameNo >= 0
+				onClicked: exportFileDialog.open()
+				ToolTip.visible: hovered
+				ToolTip.text: "Save frame " + yzFrameRoot.effectiveFrameNo + " as PDF, SVG or DXF"
+			}
 			Rectangle {
 				width: 20; height: 20; radius: 10; color: "#3498db"
 				Text { anchors.centerIn: parent; text: "?"; color: "#ffffff"; font.pixelSize: 12; font.bold: true }
@@ -69,8 +121,10 @@ Rectangle {
 			Layout.fillHeight: true
 			clip: true
 			gridSpacing: 20
-			currentFrameNo: -1
+			currentFrameNo: yzFrameRoot.effectiveFrameNo
 			frameController: frameYZController
+			principalDimensions: principalDimensionsModel
+			hullOffsets: hullOffsetsModel
 			greenLineColor: "#00ff00"
 			// Zoom & Pan state
 			scaleFactor: 1.0
@@ -0,0 +1,104 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+
+/*
+ * PrincipalDimensionsInput.qml - Ship principal dimensions (metres)
+ *
+ * Lpp and L drive the X/L and XLL/LLL columns of the XZ table, B and D the
+ * hull outline of the YZ drawing. Apply writes all five values at once.
+ */
+
+ColumnLayout {
+    id: rootDimensions
+    Layout.fillWidth: true
+    spacing: 6
+
+    property string statusText: ""
+
+    // Label and PrincipalDimensions property of each input
+    property var fields: [
+        { label: "Lpp [m]", key: "lpp" },
+        { label: "L [m]", key: "length" },
+        { label: "B [m]", key: "breadth" },
+        { label: "D [m]", key: "depth" },
+        { label: "T [m]", key: "draught" }
+    ]
+
+    function valueOf(key) {
+        return principalDimensionsModel ? principalDimensionsModel[key] : 0
+    }
+
+    function apply() {
+        var values = []
+        for (var i = 0; i < fieldRepeater.count; ++i)
+            values.push(parseFloat(fieldRepeater.itemAt(i).text))
+        for (var k = 0; k < values.length; ++k) {
+            if (isNaN(values[k])) {
+                statusText = rootDimensions.fields[k].label + " is not a number"
+                return
+            }
+        }
+        if (principalDimensionsModel.setDimensions(values[0], values[1], values[2], values[3], values[4]))
+            statusText = ""
+    }
+
+    Connections {
+        target: principalDimensionsModel
+        function onErrorOccurred(error) {
+            rootDimensions.statusText = error
+        }
+    }
+
+    RowLayout {
+        Layout.fillWidth: true
+
+        Text {
+            text: "Principal Dimensions"
+            font.pixelSize: 14
+            font.bold: true
+            color: "#34495e"
+        }
+
+        Item { Layout.fillWidth: true }
+
+        Text {
+            text: rootDimensions.statusText
+            visible: text.length > 0
+            font.pixelSize: 11
+            color: "#c0392b"
+        }
+    }
+
+    RowLayout {
+        Layout.fillWidth: true
+        spacing: 8
+
+        Repeater {
+            id: fieldRepeater
+            model: rootDimensions.fields
+
+            TextField {
+                Layout.fillWidth: true
+                placeholderText: modelData.label
+                // Re-read when the stored dimensions change (load or another editor)
+                text: {
+                    var v = rootDimensions.valueOf(modelData.key)
+                    return v > 0 ? v.toString() : ""
+                }
+                font.pixelSize: 11
+                selectByMouse: true
+                validator: DoubleValidator { bottom: 0.0; decimals: 3; notation: DoubleValidator.StandardNotation }
+                ToolTip.visible: hovered
+                ToolTip.text: modelData.label
+                onAccepted: rootDimensions.apply()
+            }
+        }
+
+        Button {
+            text: "Apply"
+            font.pixelSize: 11
+            onClicked: rootDimensions.apply()
+        }
+    }
+}
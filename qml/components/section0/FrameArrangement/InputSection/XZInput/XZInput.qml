@@ -54,6 +54,19 @@ ColumnLayout {
         }
     }
 
+    // Zone count of the stored spacing zones, refreshed on every reload of the zone model
+    property int zoneCount: frameXZZonesModel.getZoneCount()
+
+    Connections {
+        target: frameXZZonesModel
+        function onModelReset() {
+            rootXZ.zoneCount = frameXZZonesModel.getZoneCount()
+        }
+        function onErrorOccurred(error) {
+            Qt.callLater(function() { console.error("Frame XZ Zones Error:", error) })
+        }
+    }
+
     // --- Delegate recalculation and persistence to C++ controller ---
     function updateRow(id, number, spacing, ml) {
         var n = parseInt(number) || 0
@@ -73,6 +86,41 @@ ColumnLayout {
         }
         
         Item { Layout.fillWidth: true }
+
+        // Spacing zones: store the frame table as zones, or rebuild it from the stored zones
+        Text {
+            text: rootXZ.zoneCount + " zones"
+            font.pixelSize: 10
+            color: "#7f8c8d"
+        }
+
+        Text {
+            text: "Save as zones"
+            font.pixelSize: 10
+            color: "#2196F3"
+            font.bold: true
+            MouseArea {
+                anchors.fill: parent
+                cursorShape: Qt.PointingHandCursor
+                onClicked: frameXZZonesModel.importFromFrameTable()
+            }
+        }
+
+        Text {
+            text: "Load from zones"
+            font.pixelSize: 10
+            color: rootXZ.zoneCount > 0 ? "#2196F3" : "#bdc3c7"
+            font.bold: true
+            MouseArea {
+                anchors.fill: parent
+                enabled: rootXZ.zoneCount > 0
+                cursorShape: enabled ? Qt.PointingHandCursor : Qt.ArrowCursor
+                onClicked: {
+                    if (frameXZZonesModel.exportToFrameTable(frameXZModel))
+                        frameXZController.getFrameXZList()
+                }
+            }
+        }
     }
     
     Rectangle {
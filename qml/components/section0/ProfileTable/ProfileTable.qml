@@ -57,8 +57,6 @@ Rectangle {
     ]
     
     property var tableModel: []
-    property alias rehBrackets: rehBracketsInput.text
-    property alias rehProfiles: rehProfilesInput.text
     
     // Flag untuk membedakan antara initial load dan user changes
     property bool isInitialLoad: true
@@ -520,20 +518,15 @@ Rectangle {
         }
     }
 
-    // Function untuk trigger bracket recalculation di semua rows
-    function triggerBracketRecalculation() {
-        console.log("triggerBracketRecalculation called")
-        
-        // Update shadow row
-        if (shadowRow && shadowRow.updateShadowRowValues) {
-            shadowRow.updateShadowRowValues()
-        }
-        
-        // Update all data rows
-        for (var i = 0; i < profileRepeater.count; i++) {
-            var row = profileRepeater.itemAt(i)
-            if (row && row.updateProfileName) {
-                row.updateProfileName()
+    // Saved rows get their brackets from recalculationController when ReH changes; only the
+    // unsaved shadow row is recalculated here
+    Connections {
+        target: recalculationController
+        function onRehChanged() {
+            rehBracketsInput.text = recalculationController.rehBracket
+            rehProfilesInput.text = recalculationController.rehProfile
+            if (shadowRow && shadowRow.updateShadowRowValues) {
+                shadowRow.updateShadowRowValues()
             }
         }
     }
@@ -702,16 +695,20 @@ Rectangle {
                     id: rehBracketsInput
                     Layout.preferredWidth: 60
                     Layout.preferredHeight: 20
-                    text: "235"
+                    // ReH lives in recalculationController; it resizes and saves every row's brackets.
+                    // The text follows it through the Connections below, not a binding that the
+                    // reset on invalid input would break
+                    Component.onCompleted: text = recalculationController.rehBracket
                     validator: DoubleValidator { bottom: 0; top: 999999 }
                     selectByMouse: true
                     font.pixelSize: 10
                     
-                    onTextChanged: {
-                        // Trigger bracket recalculation for all rows when REH Brackets changes
-                        Qt.callLater(function() {
-                            triggerBracketRecalculation()
-                        })
+                    onEditingFinished: {
+                        var value = parseFloat(text)
+                        if (value > 0)
+                            recalculationController.rehBracket = value
+                        else
+                            text = recalculationController.rehBracket
                     }
                 }
 
@@ -725,16 +722,17 @@ Rectangle {
                     id: rehProfilesInput
                     Layout.preferredWidth: 60
                     Layout.preferredHeight: 20
-                    text: "235"
+                    Component.onCompleted: text = recalculationController.rehProfile
                     validator: DoubleValidator { bottom: 0; top: 999999 }
                     selectByMouse: true
                     font.pixelSize: 10
                     
-                    onTextChanged: {
-                        // Trigger bracket recalculation for all rows when REH Profiles changes
-                        Qt.callLater(function() {
-                            triggerBracketRecalculation()
-                        })
+                    onEditingFinished: {
+                        var value = parseFloat(text)
+                        if (value > 0)
+                            recalculationController.rehProfile = value
+                        else
+                            text = recalculationController.rehProfile
                     }
                 }
 
@@ -1781,8 +1779,8 @@ Rectangle {
                             var bracketValues = calculateBracketValues(
                                 twField.text,
                                 wField.text,
-                                rehProfilesInput.text,
-                                rehBracketsInput.text
+                                recalculationController.rehProfile,
+                                recalculationController.rehBracket
                             )
                             
                             console.log("Row", rowIndex, "calculated bracket values:", bracketValues)
@@ -3095,8 +3093,8 @@ Rectangle {
                         var bracketValues = calculateBracketValues(
                             shadowTwField.text,
                             shadowWField.text,
-                            rehProfilesInput.text,
-                            rehBracketsInput.text
+                            recalculationController.rehProfile,
+                            recalculationController.rehBracket
                         )
                         
                         console.log("Shadow calculated bracket values:", bracketValues)
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import "../components/section0/FrameArrangement/InputSection/PrincipalDimensionsInput"
 import "../components/section0/FrameArrangement/InputSection/XZInput"
 import "../components/section0/FrameArrangement/InputSection/YZInput"
 import "../components/section0/FrameArrangement/Frame" as FrameSection
@@ -37,6 +38,11 @@ Rectangle {
                     color: "#2c3e50"
                 }
                 
+                // Lpp, L, B, D, T
+                PrincipalDimensionsInput {
+                    Layout.fillWidth: true
+                }
+                
                 // Frame X Z Table
                 XZInput {
                     Layout.fillWidth: true
@@ -1,29 +1,21 @@
 #include "FrameArrangementXZController.h"
 #include "../database/models/FrameArrangementXZ.h"
+#include "RecalculationController.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDebug>
 #include <algorithm>
+#include <climits>
+#include <cmath>
+#include <QSet>
+#include <QHash>
 
 FrameArrangementXZController::FrameArrangementXZController(QObject *parent)
-    : QObject(parent), m_model(nullptr)
+    : QObject(parent), m_model(nullptr), m_recalculation(nullptr), m_positionsDirty(true), m_flushScheduled(false), m_pendingFromFrame(INT_MAX)
 {
 }
 
-// Take a snapshot of current rows directly from the model (no QML refresh/sort)
-static QVariantList snapshotRowsFromModel(FrameArrangementXZ* model)
-{
-    QVariantList rows;
-    if (!model) return rows;
-    const int n = model->getRowCount();
-    rows.reserve(n);
-    for (int i = 0; i < n; ++i) {
-        rows.append(model->getFrameAtIndex(i));
-    }
-    return rows;
-}
-
 void FrameArrangementXZController::setFrameXZList(const QJsonArray &list)
 {
     if (m_frameXZList != list) {
@@ -51,19 +43,27 @@ void FrameArrangementXZController::setSecondFrameXZ(const QJsonArray &second)
 void FrameArrangementXZController::setModel(FrameArrangementXZ* model)
 {
     m_model = model;
+    m_positionsDirty = true;
 }
 
 void FrameArrangementXZController::insertFrameXZ(const QString &frameName, int frameNumber, int frameSpacing,
-                                                const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll)
+                                                const QString &ml, double xpCoor)
+{
+    // Coordinates come from the caller, so positions are rebuilt from the model on next use
+    m_positionsDirty = true;
+    insertFrameRow(frameName, frameNumber, frameSpacing, ml, xpCoor);
+}
+
+bool FrameArrangementXZController::insertFrameRow(const QString &frameName, int frameNumber, int frameSpacing,
+                                                  const QString &ml, double xpCoor)
 {
     if (!m_model) {
         qCritical() << "FrameArrangementXZController::insertFrameXZ() - Model not set";
         emit errorOccurred("Model not set");
-        return;
+        return false;
     }
 
-    bool success = m_model->insertFrame(frameName, frameNumber, frameSpacing, 
-                                       ml, xpCoor, xl, xllCoor, xllLll);
+    bool success = m_model->insertFrame(frameName, frameNumber, frameSpacing, ml, xpCoor);
     
     if (success) {
         int lastId = getXZLastId();
@@ -76,6 +76,7 @@ void FrameArrangementXZController::insertFrameXZ(const QString &frameName, int f
         qCritical() << "FrameArrangementXZController::insertFrameXZ() - Failed to insert frame";
         emit errorOccurred("Failed to insert frame");
     }
+    return success;
 }
 
 void FrameArrangementXZController::getFrameXZList()
@@ -110,8 +111,17 @@ void FrameArrangementXZController::deleteFrameXZ(int id)
         return;
     }
 
+    ensurePositions();
+    const int index = m_model->indexOfId(id);
+    const int frameNumber = index >= 0 ? m_model->frames().at(index).frameNumber : 0;
+
     bool success = m_model->deleteFrame(id);
     if (success) {
+        if (index >= 0) {
+            // Frames above the deleted one now continue from its lower neighbour
+            m_positions.removeFrame(frameNumber);
+            schedulePositionFlush(frameNumber);
+        }
             QMetaObject::invokeMethod(this, "getFrameXZList", Qt::QueuedConnection);
         qDebug() << "FrameArrangementXZController::deleteFrameXZ() - Frame deleted successfully";
     } else {
@@ -121,7 +131,7 @@ void FrameArrangementXZController::deleteFrameXZ(int id)
 }
 
 void FrameArrangementXZController::updateFrameXZ(int id, const QString &frameName, int frameNumber, int frameSpacing,
-                                                const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll)
+                                                const QString &ml, double xpCoor)
 {
     if (!m_model) {
             QMetaObject::invokeMethod(this, "getFrameXZList", Qt::QueuedConnection);
@@ -138,23 +148,33 @@ void FrameArrangementXZController::updateFrameXZ(int id, const QString &frameNam
         return;
     }
 
-    bool success = m_model->updateFrame(id, frameName, frameNumber, frameSpacing, 
-                                       ml, xpCoor, xl, xllCoor, xllLll);
+    // Positions as they were before this edit, so the engine can be moved along with the row
+    ensurePositions();
+
+    // A changed xpCoor is a direct position edit: the frame is anchored there and the frames
+    // above are moved along with it
+    const int previousIndex = m_model->indexOfId(id);
+    const int previousFrameNumber = previousIndex >= 0 ? m_model->frames().at(previousIndex).frameNumber : frameNumber;
+    const bool xpEdited = previousIndex >= 0
+        && qAbs(m_model->frames().at(previousIndex).xpCoor - xpCoor) > 1e-9;
+
+    bool success = m_model->updateFrame(id, frameName, frameNumber, frameSpacing, ml, xpCoor);
+    if (previousIndex < 0)
+        m_positionsDirty = true;
     
     if (success) {
         getFrameXZList();
         
-        if (frameNumber >= 0) {
+        if (frameNumber >= 0 || previousFrameNumber >= 0) {
             QVariantMap changedData;
             changedData["id"] = id;
             changedData["frameName"] = frameName;
             changedData["frameNumber"] = frameNumber;
+            changedData["previousFrameNumber"] = previousFrameNumber;
             changedData["frameSpacing"] = frameSpacing;
             changedData["ml"] = ml;
-            changedData["xpCoor"] = xpCoor;
-            changedData["xl"] = xl;
-            changedData["xllCoor"] = xllCoor;
-            changedData["xllLll"] = xllLll;
+            if (xpEdited)
+                changedData["xpCoor"] = xpCoor;
             
             checkChangedFrameXZ(changedData, frameNumber);
         }
@@ -190,10 +210,7 @@ void FrameArrangementXZController::updateFrameXZMl(int id, const QString &ml)
         currentFrame["frameNumber"].toInt(),
         currentFrame["frameSpacing"].toInt(),          // Changed to toInt()
         ml,                                            // Changed to pass ml directly as string
-        currentFrame["xpCoor"].toDouble(),
-        currentFrame["xl"].toDouble(),
-        currentFrame["xllCoor"].toDouble(),
-        currentFrame["xllLll"].toDouble()
+        currentFrame["xpCoor"].toDouble()
     );
 
     if (success) {
@@ -259,6 +276,7 @@ void FrameArrangementXZController::resetFrameXZ()
     }
 
     bool success = m_model->resetDatabase();
+    m_positionsDirty = true;
     if (success) {
             QMetaObject::invokeMethod(this, "getFrameXZList", Qt::QueuedConnection);
         qDebug() << "FrameArrangementXZController::resetFrameXZ() - Database reset successfully";
@@ -277,27 +295,14 @@ void FrameArrangementXZController::addSampleData()
     }
 
     // Add some sample frame data
-    insertFrameXZ("Frame 0", 0, 1820, "FORWARD", 0.0, 0.0, 0.0, 0.0);
-    insertFrameXZ("Frame 1", 1, 1820, "FORWARD", 1.82, 0.0182, 1.82, 0.0173);
-    insertFrameXZ("Frame 2", 2, 1820, "FORWARD", 3.64, 0.0364, 3.64, 0.0347);
-    insertFrameXZ("Frame 3", 3, 1820, "FORWARD", 5.46, 0.0546, 5.46, 0.0520);
+    insertFrameXZ("Frame 0", 0, 1820, "FORWARD", 0.0);
+    insertFrameXZ("Frame 1", 1, 1820, "FORWARD", 1.82);
+    insertFrameXZ("Frame 2", 2, 1820, "FORWARD", 3.64);
+    insertFrameXZ("Frame 3", 3, 1820, "FORWARD", 5.46);
     
     qDebug() << "FrameArrangementXZController::addSampleData() - Sample data added successfully";
 }
 
-// Compute ship lengths from previous row ratios when available, otherwise use controller defaults
-static void deriveLengthsFromPrev(const QVariantMap &prev, double &lpp, double &upperL, double fallbackLpp, double fallbackUpperL)
-{
-    lpp = fallbackLpp;
-    upperL = fallbackUpperL;
-    const double prevXp = prev.value("xpCoor").toDouble();
-    const double prevXl = prev.value("xl").toDouble();
-    const double prevXll = prev.value("xllCoor").toDouble();
-    const double prevXllLll = prev.value("xllLll").toDouble();
-    if (prevXp > 0.0 && prevXl > 0.0) lpp = prevXp / prevXl;
-    if (prevXll > 0.0 && prevXllLll > 0.0) upperL = prevXll / prevXllLll;
-}
-
 void FrameArrangementXZController::recalcAndUpdateRow(int id, int frameNumber, int frameSpacing, const QString &ml)
 {
     if (!m_model) {
@@ -306,72 +311,31 @@ void FrameArrangementXZController::recalcAndUpdateRow(int id, int frameNumber, i
         return;
     }
 
-    // Do NOT refresh/sort while editing. Use a direct snapshot from the model.
-    QVariantList rows = snapshotRowsFromModel(m_model);
-    if (rows.isEmpty()) { emit errorOccurred("No rows available"); return; }
+    ensurePositions();
+    const int index = m_model->indexOfId(id);
+    if (index < 0) { emit errorOccurred("No rows available"); return; }
+    const int oldFrameNumber = m_model->frames().at(index).frameNumber;
 
-    // Find previous row with frameNumber < new frameNumber (max)
-    QVariantMap prev;
-    bool hasPrev = false;
-    for (const QVariant &v : rows) {
-        QVariantMap r = v.toMap();
-        if (r.value("frameNumber").toInt() < frameNumber) {
-            if (!hasPrev || r.value("frameNumber").toInt() > prev.value("frameNumber").toInt()) {
-                prev = r;
-                hasPrev = true;
-            }
-        }
-    }
-
-    // Derive LPP and Upper L
-    double lpp = getShipLength();
-    double upperL = getShipLengthL();
-    if (hasPrev) deriveLengthsFromPrev(prev, lpp, upperL, lpp, upperL);
-
-    // Compute coordinates (match Python logic)
-    // Cases:
-    // - If frameNumber > 0 and there is a previous row: use previous.xpCoor and previous.frame_spacing
-    // - If frameNumber < 0: use current frameSpacing directly
-    // - Else (e.g., first row or frameNumber == 0 or no previous): set to 0
-    double xp = 0.0, xll = 0.0;
-    if (frameNumber > 0 && hasPrev) {
-        const int prevNum = prev.value("frameNumber").toInt();
-        const int prevSpa = prev.value("frameSpacing").toInt(); // mm
-        const int diff = frameNumber - prevNum; // can assume >0 given guard
-        xp = prev.value("xpCoor").toDouble() + (static_cast<double>(diff) * prevSpa) / 1000.0; // m
-        xll = xp;
-    } else if (frameNumber < 0) {
-        xp = (static_cast<double>(frameNumber) * frameSpacing) / 1000.0; // m, use current spacing
-        xll = xp;
+    // Move / re-space the frame in the position engine (O(log n)), then read its position
+    if (oldFrameNumber != frameNumber) {
+        m_positions.removeFrame(oldFrameNumber);
+        m_positions.insertFrame(frameNumber, frameSpacing);
     } else {
-        xp = 0.0;
-        xll = 0.0;
+        m_positions.setSpacing(frameNumber, frameSpacing);
     }
-    const double xl = (lpp > 0.0) ? (xp / lpp) : 0.0;
-    const double xllLll = (upperL > 0.0) ? (xll / upperL) : 0.0;
+
+    const double xp = m_positions.position(frameNumber, frameSpacing);
 
     const QString frameName = QStringLiteral("Frame ") + QString::number(frameNumber);
-    // Update DB directly to avoid double refresh, then cascade and refresh once
-    bool ok = m_model->updateFrame(id, frameName, frameNumber, frameSpacing, ml, xp, xl, xll, xllLll);
+    // Only the edited row is written now; frames above it are written later in one batch
+    bool ok = m_model->updateFrame(id, frameName, frameNumber, frameSpacing, ml, xp);
     if (!ok) {
+        m_positionsDirty = true;
         emit errorOccurred("Failed to update frame");
         return;
     }
 
-    if (frameNumber >= 0) {
-        QVariantMap changedData;
-        changedData["id"] = id;
-        changedData["frameName"] = frameName;
-        changedData["frameNumber"] = frameNumber;
-        changedData["frameSpacing"] = frameSpacing;
-        changedData["ml"] = ml;
-        changedData["xpCoor"] = xp;
-        changedData["xl"] = xl;
-        changedData["xllCoor"] = xll;
-        changedData["xllLll"] = xllLll;
-        checkChangedFrameXZ(changedData, frameNumber);
-    }
-    // Now that update is complete, refresh and cascade as before
+    schedulePositionFlush(std::min(oldFrameNumber, frameNumber));
     getFrameXZList();
     checkIsFrameZero();
     // Note: getFrameXZList triggers view update; sorting happens after commit, not during typing
@@ -385,48 +349,95 @@ void FrameArrangementXZController::insertWithRecalc(const QString &frameName, in
         return;
     }
 
-    // Use a fresh snapshot directly from the model to avoid stale cached list
-    QVariantList rows = snapshotRowsFromModel(m_model);
-    // Sort by frameNumber to ensure correct prev selection
-    std::sort(rows.begin(), rows.end(), [](const QVariant &a, const QVariant &b) {
-        return a.toMap()["frameNumber"].toInt() < b.toMap()["frameNumber"].toInt();
-    });
+    ensurePositions();
+    m_positions.insertFrame(frameNumber, frameSpacing);
+
+    const double xp = m_positions.position(frameNumber, frameSpacing);
+
+    if (!insertFrameRow(frameName, frameNumber, frameSpacing, ml, xp)) {
+        m_positionsDirty = true;
+        return;
+    }
+    schedulePositionFlush(frameNumber);
+}
 
-    // Find previous row with frameNumber < new frameNumber (max)
-    QVariantMap prev;
-    bool hasPrev = false;
-    for (const QVariant &v : rows) {
-        QVariantMap r = v.toMap();
-        if (r.value("frameNumber").toInt() < frameNumber) {
-            if (!hasPrev || r.value("frameNumber").toInt() > prev.value("frameNumber").toInt()) {
-                prev = r;
-                hasPrev = true;
+bool FrameArrangementXZController::generateFrames(const QVariantList &zones, const QString &ml, bool replaceExisting)
+{
+    if (!m_model) {
+        qCritical() << "FrameArrangementXZController::generateFrames() - Model not set";
+        emit errorOccurred("Model not set");
+        return false;
+    }
+
+    QVector<FrameCoordinates::SpacingZone> spacingZones;
+    for (const QVariant &item : zones) {
+        const QVariantMap zone = item.toMap();
+        FrameCoordinates::SpacingZone z{ zone.value("startFrame").toInt(),
+                                         zone.value("endFrame").toInt(),
+                                         zone.value("spacing").toInt() };
+        if (z.endFrame < z.startFrame || z.spacing <= 0) {
+            emit errorOccurred(QString("Invalid spacing zone %1..%2 at %3 mm").arg(z.startFrame).arg(z.endFrame).arg(z.spacing));
+            return false;
+        }
+        spacingZones.append(z);
+    }
+    if (spacingZones.isEmpty()) {
+        emit errorOccurred("No spacing zones given");
+        return false;
+    }
+
+    const double lpp = getShipLength();
+    const double upperL = getShipLengthL();
+    const QString frameMl = ml.isEmpty() ? QStringLiteral("FORWARD") : ml;
+    QVector<FrameCoordinates::FrameRow> rows = FrameCoordinates::rowsFromZones(spacingZones, frameMl, lpp, upperL);
+
+    if (!replaceExisting && m_model->getRowCount() > 0) {
+        // Keep existing frames, add the missing numbers and re-position everything in one pass
+        QSet<int> existingNumbers;
+        QHash<int, double> oldXp;
+        QVector<FrameCoordinates::FrameRow> merged;
+        merged.reserve(m_model->getRowCount() + rows.size());
+        for (const FrameArrangementXZ::FrameData &frame : m_model->frames()) {
+            FrameCoordinates::FrameRow row;
+            row.id = frame.id;
+            row.frameName = frame.frameName;
+            row.frameNumber = frame.frameNumber;
+            row.frameSpacing = frame.frameSpacing;
+            row.ml = frame.ml;
+            merged.append(row);
+            existingNumbers.insert(frame.frameNumber);
+            oldXp.insert(frame.id, frame.xpCoor);
+        }
+        // Positions come from the engine, so hand-entered xp of the kept frames stay anchored
+        ensurePositions();
+        for (const FrameCoordinates::FrameRow &row : rows) {
+            if (!existingNumbers.contains(row.frameNumber)) {
+                merged.append(row);
+                m_positions.insertFrame(row.frameNumber, row.frameSpacing);
             }
         }
+        for (FrameCoordinates::FrameRow &row : merged)
+            row.xpCoor = m_positions.position(row.frameNumber, row.frameSpacing);
+
+        // Existing rows are only rewritten when their position actually moved
+        rows.clear();
+        for (const FrameCoordinates::FrameRow &row : merged) {
+            if (row.id == 0 || std::abs(row.xpCoor - oldXp.value(row.id)) > 1e-9)
+                rows.append(row);
+        }
     }
 
-    double lpp = getShipLength();
-    double upperL = getShipLengthL();
-    if (hasPrev) deriveLengthsFromPrev(prev, lpp, upperL, lpp, upperL);
-
-    double xp = 0.0, xll = 0.0;
-    if (frameNumber > 0 && hasPrev) {
-        const int prevNum = prev.value("frameNumber").toInt();
-        const int prevSpa = prev.value("frameSpacing").toInt(); // mm
-        const int diff = frameNumber - prevNum;
-        xp = prev.value("xpCoor").toDouble() + (static_cast<double>(diff) * prevSpa) / 1000.0; // m
-        xll = xp;
-    } else if (frameNumber < 0) {
-        xp = (static_cast<double>(frameNumber) * frameSpacing) / 1000.0; // m
-        xll = xp;
-    } else {
-        xp = 0.0;
-        xll = 0.0;
+    m_positionsDirty = true;
+    if (!m_model->writeFramesBatch(rows, replaceExisting)) {
+        emit errorOccurred("Failed to generate frames");
+        return false;
     }
-    const double xl = (lpp > 0.0) ? (xp / lpp) : 0.0;
-    const double xllLll = (upperL > 0.0) ? (xll / upperL) : 0.0;
 
-    insertFrameXZ(frameName, frameNumber, frameSpacing, ml, xp, xl, xll, xllLll);
+    m_pendingFromFrame = INT_MAX;
+    getFrameXZList();
+    checkIsFrameZero();
+    qDebug() << "FrameArrangementXZController::generateFrames() - Wrote" << rows.size() << "frames";
+    return true;
 }
 
 void FrameArrangementXZController::checkIsFrameZero()
@@ -450,12 +461,9 @@ void FrameArrangementXZController::checkIsFrameZero()
                 int frameSpacing = firstFrame["frameSpacing"].toInt();  // Changed to toInt()
                 QString ml = "FORWARD";
                 double xpCoor = 0;
-                double xl = 0;
-                double xllCoor = 0;
-                double xllLll = 0;
                 
                 qDebug() << "FrameArrangementXZController::checkIsFrameZero() - Inserting Frame 0";
-                insertFrameXZ(frameName, frameNumber, frameSpacing, ml, xpCoor, xl, xllCoor, xllLll);
+                insertFrameXZ(frameName, frameNumber, frameSpacing, ml, xpCoor);
             }
         }
     } catch (const std::exception &e) {
@@ -465,75 +473,146 @@ void FrameArrangementXZController::checkIsFrameZero()
 
 void FrameArrangementXZController::checkChangedFrameXZ(const QVariantMap &changedData, int changedFrameNumber)
 {
-    QVariantMap defaultData = changedData;
-    // Take fresh snapshot and sort by frameNumber
-    QVariantList listFrameXZ = snapshotRowsFromModel(m_model);
-    std::sort(listFrameXZ.begin(), listFrameXZ.end(), [](const QVariant &a, const QVariant &b) {
-        return a.toMap()["frameNumber"].toInt() < b.toMap()["frameNumber"].toInt();
-    });
+    if (!m_model) {
+        qCritical() << "FrameArrangementXZController::checkChangedFrameXZ() - Model not set";
+        emit errorOccurred("Model not set");
+        return;
+    }
 
-    // Filter data with frame numbers greater than the changed frame number
-    QVariantList filteredData;
-    for (const QVariant &item : listFrameXZ) {
-        QVariantMap frameData = item.toMap();
-        if (frameData["frameNumber"].toInt() > changedFrameNumber) {
-            filteredData.append(frameData);
+    // Frames above the changed one follow from the position engine. Without the recalculation
+    // graph they are written right away; with it, xz:positions writes them in the queued
+    // recalculation, together with whatever else is dirty by then
+    ensurePositions();
+    const int frameSpacing = changedData.value("frameSpacing").toInt();
+    const int previousFrameNumber = changedData.value("previousFrameNumber", changedFrameNumber).toInt();
+    if (previousFrameNumber != changedFrameNumber && m_positions.contains(previousFrameNumber)) {
+        // Renumbered: frames between the old and the new number move too
+        m_positions.removeFrame(previousFrameNumber);
+        m_positions.insertFrame(changedFrameNumber, frameSpacing);
+    } else if (m_positions.contains(changedFrameNumber)) {
+        m_positions.setSpacing(changedFrameNumber, frameSpacing);
+    } else {
+        // Not in the engine (stale), rebuild it from the model rows
+        qWarning() << "FrameArrangementXZController::checkChangedFrameXZ() - Frame" << changedFrameNumber
+                   << "not indexed, rebuilding positions";
+        m_positionsDirty = true;
+        ensurePositions();
+        if (!m_positions.contains(changedFrameNumber)) {
+            qWarning() << "FrameArrangementXZController::checkChangedFrameXZ() - Frame" << changedFrameNumber << "not found";
+            return;
         }
     }
-    
-    if (!filteredData.isEmpty()) {
-        for (const QVariant &item : filteredData) {
-            QVariantMap frameData = item.toMap();
-            
-            // Define variables
-            int id = frameData["id"].toInt();
-            QString frameName = frameData["frameName"].toString();
-            int frameSpacing = frameData["frameSpacing"].toInt();       // Changed to toInt()
-            int frameNumber = frameData["frameNumber"].toInt();
-            QString ml = frameData["ml"].toString();
-            
-            // Calculations
-            int selisihFrame = frameNumber - defaultData["frameNumber"].toInt();
-            double xpCoor = (selisihFrame * defaultData["frameSpacing"].toInt() / 1000.0) + defaultData["xpCoor"].toDouble();  // Changed to toInt()
-            
-            double lpp = getShipLength();
-            double xl = (lpp > 0.0) ? (xpCoor / lpp) : 0.0;
 
-            double xllCoor = xpCoor;
+    // xpCoor is only present when it was edited directly: anchor the frame there, the frames
+    // above keep their offset from it through later spacing edits
+    if (changedData.contains("xpCoor"))
+        m_positions.setAnchor(changedFrameNumber, qRound64(changedData.value("xpCoor").toDouble() * 1000.0));
 
-            double upperL = getShipLengthL();
-            double xllLll = (upperL > 0.0) ? (xllCoor / upperL) : 0.0;
-            
-            // Update frame
-            bool success = m_model->updateFrame(id, frameName, frameNumber, frameSpacing,
-                                               ml, xpCoor, xl, xllCoor, xllLll);   // Changed to pass ml directly as string
-            
-            if (success) {
-                // Set default data for next iteration
-                defaultData["frameNumber"] = frameNumber;
-                defaultData["frameSpacing"] = frameSpacing;
-                defaultData["xpCoor"] = xpCoor;
-                defaultData["xl"] = xl;
-                defaultData["xllCoor"] = xllCoor;
-                defaultData["xllLll"] = xllLll;
-            }
-        }
-        getFrameXZList();
+    m_pendingFromFrame = std::min(m_pendingFromFrame, std::min(previousFrameNumber, changedFrameNumber));
+    if (m_recalculation) {
+        m_recalculation->invalidate(RecalculationController::spacingKey());
+    } else {
+        flushPendingCoordinates();
     }
 }
 
+bool FrameArrangementXZController::flushPendingCoordinates()
+{
+    m_flushScheduled = false;
+    if (!m_model || m_pendingFromFrame == INT_MAX)
+        return false;
+
+    const int fromFrameNumber = m_pendingFromFrame;
+    m_pendingFromFrame = INT_MAX;
+    ensurePositions();
+
+    // Only xp is stored, the derived columns follow from it on read. The changed frame itself
+    // is included: a renumbered row moves even when its neighbours do not
+    QList<FrameArrangementXZ::CoordinateUpdate> updates;
+    for (const FrameArrangementXZ::FrameData &frame : m_model->frames()) {
+        if (frame.frameNumber < fromFrameNumber)
+            continue;
+        const double xp = m_positions.position(frame.frameNumber, frame.frameSpacing);
+        if (qAbs(xp - frame.xpCoor) < 1e-9)
+            continue;
+        updates.append({ frame.id, xp });
+    }
+
+    if (updates.isEmpty())
+        return false;
+
+    qDebug() << "FrameArrangementXZController::flushPendingCoordinates() - Writing" << updates.size() << "frames";
+    if (!m_model->updateCoordinatesBatch(updates)) {
+        m_positionsDirty = true;
+        emit errorOccurred("Failed to update frame coordinates");
+        return false;
+    }
+    getFrameXZList();
+    return true;
+}
+
+void FrameArrangementXZController::schedulePositionFlush(int fromFrameNumber)
+{
+    m_pendingFromFrame = std::min(m_pendingFromFrame, fromFrameNumber);
+    if (m_flushScheduled)
+        return;
+    m_flushScheduled = true;
+    QMetaObject::invokeMethod(this, "flushPendingCoordinates", Qt::QueuedConnection);
+}
+
+void FrameArrangementXZController::ensurePositions()
+{
+    if (!m_positionsDirty || !m_model)
+        return;
+    m_positions.clear();
+    QVector<const FrameArrangementXZ::FrameData *> byNumber;
+    byNumber.reserve(m_model->frames().size());
+    for (const FrameArrangementXZ::FrameData &frame : m_model->frames()) {
+        m_positions.insertFrame(frame.frameNumber, frame.frameSpacing);
+        byNumber.append(&frame);
+    }
+
+    // A stored xp that differs from the spacing sum was entered by hand: anchor it, lowest
+    // frame first so each offset is taken relative to the anchors below it
+    std::stable_sort(byNumber.begin(), byNumber.end(), [](const FrameArrangementXZ::FrameData *a,
+                                                          const FrameArrangementXZ::FrameData *b) {
+        return a->frameNumber < b->frameNumber;
+    });
+    int previousNumber = INT_MIN;
+    for (const FrameArrangementXZ::FrameData *frame : byNumber) {
+        if (frame->frameNumber == previousNumber)
+            continue;
+        previousNumber = frame->frameNumber;
+        const qint64 storedMm = qRound64(frame->xpCoor * 1000.0);
+        if (storedMm != m_positions.positionMm(frame->frameNumber, frame->frameSpacing))
+            m_positions.setAnchor(frame->frameNumber, storedMm);
+    }
+    m_positionsDirty = false;
+}
+
 double FrameArrangementXZController::getShipLength() const
 {
-    // TODO: Implement this based on your ship data source
-    // This should return the ship's LPP (Length between perpendiculars)
-    return 87.780; // Placeholder value
+    // Lpp (length between perpendiculars), owned by the model for its derived columns
+    return m_model ? m_model->shipLength() : 87.780;
 }
 
 double FrameArrangementXZController::getShipLengthL() const
 {
-    // TODO: Implement this based on your ship data source
-    // This should return the ship's overall length
-    return 87.7824000000000; // Placeholder value
+    // Scantling length L
+    return m_model ? m_model->shipLengthL() : 87.7824000000000;
+}
+
+void FrameArrangementXZController::setShipLengths(double lpp, double upperL)
+{
+    if (!m_model) {
+        qCritical() << "FrameArrangementXZController::setShipLengths() - Model not set";
+        emit errorOccurred("Model not set");
+        return;
+    }
+
+    // x/Lpp and x/L are derived on read: no database writes, only a list refresh
+    m_model->setShipLengths(lpp, upperL);
+    getFrameXZList();
 }
 
 QJsonArray FrameArrangementXZController::generateObjectJson(const QVariantList &data)
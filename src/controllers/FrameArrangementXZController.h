@@ -7,8 +7,10 @@
 #include <QVariantList>
 #include <QVariantMap>
 #include <QDebug>
+#include "../core/FramePositionEngine.h"
 
 class FrameArrangementXZ;
+class RecalculationController;
 
 class FrameArrangementXZController : public QObject
 {
@@ -32,15 +34,17 @@ public:
 
     // Initialize with model
     void setModel(FrameArrangementXZ* model);
+    // Re-spacing cascades through the recalculation graph when one is attached
+    void setRecalculation(RecalculationController *recalculation) { m_recalculation = recalculation; }
 
 public slots:
     // Frame XZ operations
     void insertFrameXZ(const QString &frameName, int frameNumber, int frameSpacing, 
-                      const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll);
+                      const QString &ml, double xpCoor);
     void getFrameXZList();
     void deleteFrameXZ(int id);
     void updateFrameXZ(int id, const QString &frameName, int frameNumber, int frameSpacing,
-                      const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll);
+                      const QString &ml, double xpCoor);
     void updateFrameXZMl(int id, const QString &ml);
     int getXZLastId();
     void getFrameXZById(int id);
@@ -50,6 +54,13 @@ public slots:
     Q_INVOKABLE void recalcAndUpdateRow(int id, int frameNumber, int frameSpacing, const QString &ml);
     // Insert a row with C++-side calculation, then cascade if needed
     Q_INVOKABLE void insertWithRecalc(const QString &frameName, int frameNumber, int frameSpacing, const QString &ml);
+    // Generate every frame covered by the spacing zones ([{startFrame, endFrame, spacing}, ...],
+    // the last zone includes endFrame) in one pass and one transaction. Without replaceExisting,
+    // frame numbers already in the table are kept and the rows above them are re-positioned.
+    Q_INVOKABLE bool generateFrames(const QVariantList &zones, const QString &ml, bool replaceExisting);
+    // Write coordinates of frames moved by earlier edits in one batch (normally runs queued);
+    // true when any coordinate was written
+    bool flushPendingCoordinates();
     
     // Sample data
     void addSampleData();
@@ -58,9 +69,10 @@ public slots:
     void checkIsFrameZero();
     void checkChangedFrameXZ(const QVariantMap &changedData, int changedFrameNumber);
     
-    // Ship properties (these should be implemented based on your ship data)
+    // Ship properties: Lpp and scantling length L (m)
     double getShipLength() const;
     double getShipLengthL() const;
+    Q_INVOKABLE void setShipLengths(double lpp, double upperL);
 
 signals:
     void frameXZListChanged();
@@ -70,11 +82,22 @@ signals:
 
 private:
     FrameArrangementXZ* m_model;
+    RecalculationController* m_recalculation;
     QJsonArray m_frameXZList;
     QJsonArray m_foundFrameXZ;
     QJsonArray m_secondFrameXZ;
 
+    // Frame positions, kept in sync with the model; rebuilt from it when marked dirty
+    FramePositionEngine m_positions;
+    bool m_positionsDirty;
+    bool m_flushScheduled;
+    int m_pendingFromFrame;
+
     // Helper functions
+    void ensurePositions();
+    void schedulePositionFlush(int fromFrameNumber);
+    bool insertFrameRow(const QString &frameName, int frameNumber, int frameSpacing,
+                        const QString &ml, double xpCoor);
     QJsonArray generateObjectJson(const QVariantList &data);
     QVariantList sortByFrameNumber(const QVariantList &data);
     QVariantList qjsonArrayToList(const QJsonArray &jsonArray);
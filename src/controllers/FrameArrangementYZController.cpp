@@ -77,8 +77,8 @@ int FrameArrangementYZController::insertFrameYZ(const QString &name, int no, dou
 													const QVariant &y, const QVariant &z, int frameNo, const QString &fa, const QString &sym) {
 	if (!m_model) { emit errorOccurred("Model not set"); return -1; }
 	int lastId = m_model->insertFrame(name, no, spacing, y, z, frameNo, fa, sym);
-	// Reload full list after insert
-	getFrameYZAll();
+	// The model keeps its store current; republish every frame from it
+	publishModelRows();
 	return lastId;
 }
 
@@ -94,7 +94,7 @@ void FrameArrangementYZController::getFrameYZByFrameNo(int frameNumber) {
 void FrameArrangementYZController::deleteFrameYZ(int id) {
 	if (!m_model) { emit errorOccurred("Model not set"); return; }
 	if (m_model->deleteFrame(id)) {
-		getFrameYZAll();
+		publishModelRows();
 	}
 }
 
@@ -102,7 +102,7 @@ void FrameArrangementYZController::updateFrameYZ(int id, const QString &name, in
 												 const QVariant &y, const QVariant &z, int frameNo, const QString &fa, const QString &sym) {
 	if (!m_model) { emit errorOccurred("Model not set"); return; }
 	if (m_model->updateFrame(id, name, no, spacing, y, z, frameNo, fa, sym)) {
-		getFrameYZAll();
+		publishModelRows();
 	}
 }
 
@@ -110,14 +110,14 @@ void FrameArrangementYZController::updateFrameYZFa(int id, const QString &fa) {
 	if (!m_model) { emit errorOccurred("Model not set"); return; }
 	if (m_model->updateFrameFa(id, fa)) {
 		// Python emits frame_arrangement_yz_changed; here we can refresh list or leave to UI
-		getFrameYZAll();
+		publishModelRows();
 	}
 }
 
 void FrameArrangementYZController::updateFrameYZSym(int id, const QString &sym) {
 	if (!m_model) { emit errorOccurred("Model not set"); return; }
 	if (m_model->updateFrameSym(id, sym)) {
-		getFrameYZAll();
+		publishModelRows();
 	}
 }
 
@@ -125,17 +125,15 @@ void FrameArrangementYZController::deleteFrameYZByFrameNumber(int frameNo) {
 	if (!m_model) { emit errorOccurred("Model not set"); return; }
 	if (m_model->deleteFramesByFrameNumber(frameNo)) {
 		// Keep current list refreshed
-		getFrameYZAll();
+		publishModelRows();
 	}
 }
 
 void FrameArrangementYZController::getFrameYZAll() {
 	if (!m_model) { emit errorOccurred("Model not set"); return; }
 	if (!m_model->loadData()) { return; }
-	QVariantList rows;
-	for (int i = 0; i < m_model->getRowCount(); ++i) rows.append(m_model->getFrameAtIndex(i));
 	// Do not auto-overwrite names here: respect manual entries; rows already reflect DB
-	setFrameYZList(generateObjectJson(rows));
+	publishModelRows();
 }
 
 void FrameArrangementYZController::getFrameYZById(int id) {
@@ -179,68 +177,54 @@ int FrameArrangementYZController::getLastSuffixForPrefix(const QString &prefix)
 	return m_model->getLastSuffixForPrefix(prefix);
 }
 
+int FrameArrangementYZController::getNextFreeSuffix(const QString &prefix, int fromSuffix, int count) {
+	if (!m_model) { emit errorOccurred("Model not set"); return -1; }
+	return m_model->getNextFreeSuffix(prefix, fromSuffix, count);
+}
+
 bool FrameArrangementYZController::assignManualNames(int id, const QString &prefix, int startSuffix, int count) {
 	if (!m_model) { emit errorOccurred("Model not set"); return false; }
 	bool ok = m_model->assignManualNames(id, prefix, startSuffix, count);
-	if (ok) getFrameYZAll();
+	if (ok) publishModelRows();
 	return ok;
 }
 
 bool FrameArrangementYZController::assignAutoNamesFrom(int id, const QString &prefix, int continueFromSuffix, int count) {
 	if (!m_model) { emit errorOccurred("Model not set"); return false; }
 	bool ok = m_model->assignAutoNamesFrom(id, prefix, continueFromSuffix, count);
-	if (ok) getFrameYZAll();
+	if (ok) publishModelRows();
 	return ok;
 }
 
-bool FrameArrangementYZController::updateFrameIsManual(int id, bool isManual) {
+bool FrameArrangementYZController::renameFramesYZ(const QVariantList &renames) {
 	if (!m_model) { emit errorOccurred("Model not set"); return false; }
-	bool ok = m_model->updateFrameIsManual(id, isManual);
-	if (ok) getFrameYZAll();
-	return ok;
-}
-
-void FrameArrangementYZController::computeAndPersistNames(const QVariantList &rows) {
-	if (!m_model) return;
-
-	// Strategy: per-prefix 0-based numbering after sorting by prefix.
-	// 1) Build a temp list of {id, prefix} and sort by prefix (A→Z), then by id for stability.
-	struct Item { int id; QString prefix; };
-	QVector<Item> items;
-	items.reserve(rows.size());
-	for (const QVariant &v : rows) {
+	QList<FrameArrangementYZ::NameUpdate> updates;
+	updates.reserve(renames.size());
+	for (const QVariant &v : renames) {
 		const QVariantMap m = v.toMap();
-		const int id = m.value("id").toInt();
-		const QString name = m.value("name").toString();
-		QString prefix;
-		for (int k = 0; k < name.size(); ++k) { const QChar ch = name.at(k); if (ch.isLetter()) prefix.append(ch.toUpper()); else break; }
-		if (prefix.isEmpty()) prefix = QStringLiteral("L");
-		items.push_back({ id, prefix });
-	}
-	std::sort(items.begin(), items.end(), [](const Item &a, const Item &b){
-		if (a.prefix == b.prefix) return a.id < b.id; // stable ordering within prefix
-		return a.prefix < b.prefix;
-	});
-
-	// 2) Assign names: for each prefix, suffix starts at 0 and accumulates by previous row's No in that prefix.
-	// Build a quick lookup from id to No to compute steps.
-	QHash<int,int> idToNo;
-	for (const QVariant &v : rows) {
-		const QVariantMap m = v.toMap();
-		idToNo.insert(m.value("id").toInt(), m.value("no").toInt());
+		const int manual = m.contains("isManual") ? (m.value("isManual").toBool() ? 1 : 0) : -1;
+		updates.append({ m.value("id").toInt(), m.value("name").toString(), manual });
 	}
+	bool ok = m_model->updateFrameNamesBatch(updates);
+	if (ok) publishModelRows();
+	return ok;
+}
 
-	QHash<QString, long long> counters; // suffix per prefix
-	for (const Item &it : items) {
-		long long suffix = counters.value(it.prefix, 0);
-		const QString expectedName = it.prefix + QString::number(suffix);
-		m_model->updateFrameName(it.id, expectedName, /*reloadModel*/ false);
-		long long step = static_cast<long long>(qMax(1, idToNo.value(it.id, 0)));
-		counters.insert(it.prefix, suffix + step);
-	}
+// Rebuilds frameYZList from the rows already in the model (no database round trip)
+void FrameArrangementYZController::publishModelRows() {
+	// frameYZList always holds every frame, whatever frame the model view is filtered to
+	const QList<FrameArrangementYZ::FrameYZData> &frames = m_model->allFrames();
+	QVariantList rows;
+	rows.reserve(frames.size());
+	for (const FrameArrangementYZ::FrameYZData &frame : frames) rows.append(FrameArrangementYZ::frameToMap(frame));
+	setFrameYZList(generateObjectJson(rows));
+}
 
-	// One reload at the end to reflect all updates (model will also sort and renumber consistently)
-	m_model->loadData();
+bool FrameArrangementYZController::updateFrameIsManual(int id, bool isManual) {
+	if (!m_model) { emit errorOccurred("Model not set"); return false; }
+	bool ok = m_model->updateFrameIsManual(id, isManual);
+	if (ok) publishModelRows();
+	return ok;
 }
 
 // ---------------- Frame YZ Drawing (mirrors Python functions) ----------------
@@ -55,9 +55,12 @@ public slots:
     // Conflict helpers exposed to QML
     Q_INVOKABLE QJsonArray checkSuffixConflict(const QString &prefix, int startSuffix, int count);
     Q_INVOKABLE int getLastSuffixForPrefix(const QString &prefix);
+    Q_INVOKABLE int getNextFreeSuffix(const QString &prefix, int fromSuffix, int count);
     Q_INVOKABLE bool assignManualNames(int id, const QString &prefix, int startSuffix, int count);
     Q_INVOKABLE bool assignAutoNamesFrom(int id, const QString &prefix, int continueFromSuffix, int count);
     Q_INVOKABLE bool updateFrameIsManual(int id, bool isManual);
+    // Batch rename: [{id, name, isManual (optional bool)}, ...] in one transaction
+    Q_INVOKABLE bool renameFramesYZ(const QVariantList &renames);
     // Drawing table operations
     Q_INVOKABLE int insertFrameYZDrawing(int frameyzId, const QString &name, int no, double spacing,
                                          double y, double z, int frameNo, const QString &fa, const QString &sym);
@@ -82,7 +85,7 @@ private:
     QJsonArray m_frameYZDrawing;
 
     QJsonArray generateObjectJson(const QVariantList &data);
-    void computeAndPersistNames(const QVariantList &rows);
+    void publishModelRows();
 };
 
 #endif // FRAMEARRANGEMENTYZCONTROLLER_H
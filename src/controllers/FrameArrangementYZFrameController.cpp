@@ -1,123 +1,25 @@
 #include "FrameArrangementYZFrameController.h"
 #include "FrameArrangementYZController.h"
+#include "YZPdfSink.h"
+#include "../database/models/HullOffsets.h"
+#include "../core/YZSectionExport.h"
+#include "../core/YZNaming.h"
 #include <QPainter>
 #include <QPen>
 #include <QMetaObject>
 #include <QDebug>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QRandomGenerator>
+#include <QRegion>
+#include <QImage>
+#include <QFile>
+#include <QFileInfo>
+#include <QUrl>
 #include <QVector>
 #include <QHash>
 #include <cmath>
 #include <algorithm>
-
-// Helper: parse leading letters as prefix and trailing digits as numeric suffix start
-static inline void parsePrefixAndSuffix(const QString &name, QString &outPrefix, long long &outSuffix)
-{
-    outPrefix.clear();
-    outSuffix = 0;
-    int i = 0;
-    while (i < name.size() && name.at(i).isLetter()) {
-        outPrefix.append(name.at(i).toUpper());
-        ++i;
-    }
-    QString digits;
-    while (i < name.size() && name.at(i).isDigit()) {
-        digits.append(name.at(i));
-        ++i;
-    }
-    if (!digits.isEmpty()) {
-        bool ok = false;
-        long long v = digits.toLongLong(&ok);
-        if (ok) outSuffix = v;
-    }
-    if (outPrefix.isEmpty()) outPrefix = QStringLiteral("L");
-}
-
-// Helper: assign high-contrast, well-distributed colors per prefix.
-// Uses golden-angle hue stepping with minimum hue separation and RGB distance checks.
-static inline QColor colorForPrefix(const QString &prefix)
-{
-    const QString key = prefix.isEmpty() ? QStringLiteral("L") : prefix.toUpper();
-
-    struct PaletteState {
-        bool initialized = false;
-        double startHue = 0.0;                // random seed hue per session
-        QVector<QColor> used;                 // colors assigned so far
-        QHash<QString, QColor> map;           // prefix -> color
-    };
-    static PaletteState ps;
-
-    // Return existing mapping
-    if (ps.map.contains(key)) return ps.map.value(key);
-
-    // Initialize with random start hue to vary palette per run
-    if (!ps.initialized) {
-        ps.initialized = true;
-        ps.startHue = QRandomGenerator::global()->bounded(360.0);
-    }
-
-    // Parameters for distribution and contrast
-    const double golden = 137.50776405003785; // degrees, golden-angle
-    const double minHueSeparation = 26.0;     // degrees, avoid near-identical hues
-    const double sat = 0.78;                  // strong saturation for contrast
-    const double light = 0.55;                // mid lightness (avoid pastel and too dark)
-    const double minRgbDistance = 80.0;       // minimum Euclidean distance in RGB (0..441 max)
-
-    auto hueDistanceDeg = [](double a, double b) {
-        double d = std::fabs(a - b);
-        return std::min(d, 360.0 - d);
-    };
-
-    auto farHue = [&](double candHueDeg) {
-        for (const QColor &c : ps.used) {
-            const double ch = (c.hslHueF() < 0) ? 0.0 : c.hslHueF() * 360.0;
-            if (hueDistanceDeg(candHueDeg, ch) < minHueSeparation)
-                return false;
-        }
-        return true;
-    };
-
-    auto rgbDistance = [](const QColor &a, const QColor &b) {
-        const int dr = a.red()   - b.red();
-        const int dg = a.green() - b.green();
-        const int db = a.blue()  - b.blue();
-        return std::sqrt(double(dr*dr + dg*dg + db*db));
-    };
-
-    // Base candidate using golden-angle sequence
-    int n = ps.map.size();
-    double hue = std::fmod(ps.startHue + n * golden, 360.0);
-
-    // If too close by hue, advance further along the sequence (bounded attempts)
-    int attempts = 0;
-    const int maxAttempts = 720;
-    while (!farHue(hue) && attempts++ < maxAttempts) {
-        hue = std::fmod(hue + golden, 360.0);
-    }
-
-    QColor col = QColor::fromHslF(hue / 360.0, sat, light);
-
-    // Ensure RGB distance is also sufficiently large; tweak lightness slightly if needed
-    attempts = 0;
-    while (attempts++ < 24) {
-        bool ok = true;
-        for (const QColor &c : ps.used) {
-            if (rgbDistance(col, c) < minRgbDistance) { ok = false; break; }
-        }
-        if (ok) break;
-        // Alternate lightness around the base value to force separation without changing hue
-        const double step = 0.06 * ((attempts + 1) / 2);
-        const double dir = (attempts % 2) ? -1.0 : 1.0;
-        const double nl = std::clamp(light + dir * step, 0.35, 0.72);
-        col = QColor::fromHslF(hue / 360.0, sat, nl);
-    }
-
-    ps.map.insert(key, col);
-    ps.used.push_back(col);
-    return col;
-}
+#include <memory>
 
 FrameArrangementYZFrameController::FrameArrangementYZFrameController(QQuickItem *parent)
     : QQuickPaintedItem(parent)
@@ -128,9 +30,21 @@ FrameArrangementYZFrameController::FrameArrangementYZFrameController(QQuickItem
     , m_scaleFactor(1.0)
     , m_panX(0.0)
     , m_panY(0.0)
+    , m_lodPixelThreshold(3.0)
+    , m_showLabels(true)
+    , m_dimensions(nullptr)
+    , m_outlineHalfWidthMM(24384.0 / 2.0)
+    , m_outlineHeightMM(5490.0)
+    , m_hullOffsets(nullptr)
+    , m_tiles(nullptr)
+    , m_geometryDirty(true)
+    , m_fetchPending(true)
 {
     setRenderTarget(QQuickPaintedItem::FramebufferObject);
     setAntialiasing(true);
+
+    m_tiles = new YZTileRenderer(this);
+    connect(m_tiles, &YZTileRenderer::tileReady, this, [this]() { update(); });
 }
 
 void FrameArrangementYZFrameController::paint(QPainter *painter)
@@ -145,285 +59,156 @@ void FrameArrangementYZFrameController::paint(QPainter *painter)
     painter->setRenderHint(QPainter::Antialiasing, true);
     painter->fillRect(0, 0, w, h, Qt::white);
 
+    // Line geometry is rebuilt only when the YZ data changed
+    if (m_geometryDirty)
+        rebuildLineGeometry();
+    if (!m_scene.hasData) return;
+
     // Calculate center coordinates
     int centerX = w / 2;
     int centerY = h / 2;
 
-    // Apply view transform: pan then zoom, around the center (zoom about origin after translate)
-    painter->save();
-    // Translate by pan values
-    painter->translate(m_panX, m_panY);
-    // Zoom about the screen center: move origin to center, scale, then move back
-    painter->translate(centerX, centerY);
-    painter->scale(m_scaleFactor, m_scaleFactor);
-    painter->translate(-centerX, -centerY);
-
-    // Only draw frame lines based on table data - no default grid
-    drawFrameLines(painter, centerX, centerY, m_gridSpacing);
-
-    painter->restore();
-}
-
-void FrameArrangementYZFrameController::drawFrameLines(QPainter *p, int centerX, int centerY, int spacing)
-{
-    // Load current frame data
-    loadFrameData();
-    // Reset drawn lines cache so hit-testing reflects current render only
-    m_drawnLines.clear();
-
-    QList<QJsonObject> allFrameData;
-    // Draw ALL lines regardless of frame number (frameNo filter removed)
-    for (auto val : m_frameYZDrawing) {
-        if (val.isObject()) allFrameData.append(val.toObject());
-    }
-    
-    qDebug() << "=== DEBUG DRAW FRAME LINES (Reference Logic) ===";
-    qDebug() << "Total data available:" << allFrameData.size();
-    
-    if (allFrameData.isEmpty()) {
-        qDebug() << "❌ No data available!";
-        return;
+    // Pan then zoom about the center maps mm to pixels as origin + mm * pxPerMM (z upwards).
+    // The origin is pixel aligned so composited tiles stay crisp.
+    const double pxPerMM = m_gridSpacing / 1000.0 * m_scaleFactor;
+    if (pxPerMM <= 0.0) return;
+    const QPointF origin(std::round(m_panX + centerX), std::round(m_panY + centerY));
+    const QRectF view(-origin.x(), -origin.y(), w, h);
+
+    // Composite cached tiles; missing ones are queued on the worker pool
+    const int tileSize = YZTileRenderer::TileSize;
+    const int tx0 = static_cast<int>(std::floor(view.left() / tileSize));
+    const int tx1 = static_cast<int>(std::floor((view.right() - 1) / tileSize));
+    const int ty0 = static_cast<int>(std::floor(view.top() / tileSize));
+    const int ty1 = static_cast<int>(std::floor((view.bottom() - 1) / tileSize));
+    QRegion missing;
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const QPoint topLeft(static_cast<int>(origin.x()) + tx * tileSize, static_cast<int>(origin.y()) + ty * tileSize);
+            const QImage image = m_tiles->tile(pxPerMM, tx, ty);
+            if (!image.isNull())
+                painter->drawImage(topLeft, image);
+            else
+                missing += QRect(topLeft, QSize(tileSize, tileSize));
+        }
     }
 
-    // Draw center lines first (black solid line), infinite length using +/-99999*spacing extents
-    QPen centerPen(Qt::black, 1, Qt::SolidLine);
-    p->setPen(centerPen);
-    // Vertical centerline (Z axis): from very top to very bottom
-    p->drawLine(centerX, centerY - 99999 * spacing, centerX, centerY + 99999 * spacing);
-    // Horizontal centerline (Y axis): from far left to far right
-    p->drawLine(centerX - 99999 * spacing, centerY, centerX + 99999 * spacing, centerY);
-
-    // Generate per-line tasks with sequential names from the row Name + No
-    struct GenItem { bool horizontal; QString sym; QString prefix; QString name; long long suffix; double yCoor; double zCoor; double spacingInLoop; };
-    QVector<GenItem> items;
-    items.reserve(allFrameData.size() * 4);
-
-    for (const auto &entry : allFrameData) {
-        if (!isValidFieldData(entry)) continue;
-        const double yCoor = entry.value("y").toDouble();
-        const double zCoor = entry.value("z").toDouble();
-        const QString thisSym = entry.value("sym").toString();
-        const QString rowName = entry.value("name").toString();
-        QString prefix; long long startSuffix = 0;
-        parsePrefixAndSuffix(rowName, prefix, startSuffix);
-        const double entrySpacing = entry.value("spacing").toDouble();
-        const int lineCount = std::max(0, entry.value("no").toInt());
-
-        // Generate i = 0..No-1 names: prefix+(startSuffix+i)
-        for (int i = 0; i < lineCount; ++i) {
-            const long long suffix = startSuffix + i;
-            const QString lineName = prefix + QString::number(suffix);
-            const double spacingInLoop = i * entrySpacing;
-            if (!hasYValue(entry) && hasZValue(entry)) {
-                items.push_back({ true, thisSym, prefix, lineName, suffix, yCoor, zCoor, spacingInLoop });
-            } else if (!hasZValue(entry) && hasYValue(entry)) {
-                items.push_back({ false, thisSym, prefix, lineName, suffix, yCoor, zCoor, spacingInLoop });
-            }
+    // Warm the ring around the view so a drag finds its tiles ready
+    for (int ty = ty0 - 1; ty <= ty1 + 1; ++ty) {
+        for (int tx = tx0 - 1; tx <= tx1 + 1; ++tx) {
+            if (ty == ty0 - 1 || ty == ty1 + 1 || tx == tx0 - 1 || tx == tx1 + 1)
+                m_tiles->request(pxPerMM, tx, ty);
         }
     }
 
-    // Sort generated lines by prefix (A->Z) then numeric suffix ascending
-    std::sort(items.begin(), items.end(), [](const GenItem &a, const GenItem &b){
-        if (a.prefix == b.prefix) return a.suffix < b.suffix;
-        return a.prefix < b.prefix;
-    });
-
-    // Draw in sorted order; set color per prefix
-    int globalLineIndex = 0;
-    for (const auto &gi : items) {
-        QPen framePen(colorForPrefix(gi.prefix), 1);
-        framePen.setCosmetic(true);
-        p->setPen(framePen);
-        if (gi.horizontal) {
-            drawZCoordinateLines(p, centerX, centerY, spacing, gi.zCoor, gi.spacingInLoop, gi.sym, gi.prefix, gi.name, globalLineIndex);
-        } else {
-            drawYCoordinateLines(p, centerX, centerY, spacing, gi.yCoor, gi.spacingInLoop, gi.sym, gi.prefix, gi.name, globalLineIndex);
-        }
+    // Tiles not rendered yet are drawn directly this once
+    if (!missing.isEmpty()) {
+        painter->save();
+        painter->setClipRegion(missing);
+        painter->translate(origin);
+        YZSceneRenderer::render(painter, m_scene, pxPerMM, view.adjusted(-2, -2, 2, 2));
+        painter->restore();
     }
-    
-    // Draw ship outline last so it stays clearly visible as boundary
-    drawShipOutline(p, centerX, centerY, spacing);
 
-    qDebug() << "=== END DEBUG ===";
+    // Line names on top of the drawing
+    if (m_showLabels)
+        m_labels.paint(painter, m_scene, origin, pxPerMM, view);
 }
 
-// Draw ship outline: black rectangle centered at origin.
-// Width total = 24384 (left/right half = 12192), Height total = 5490.
-// Uses same mm->px scaling as lines: px = (mm/1000) * spacing.
-void FrameArrangementYZFrameController::drawShipOutline(QPainter *p, int centerX, int centerY, int spacing)
+const YZSceneRenderer::Scene &FrameArrangementYZFrameController::scene()
 {
-    // Half-width in mm and full height in mm
-    const double halfWidthMM = 24384.0 / 2.0; // 12192
-    const double heightMM = 5490.0;
-
-    // Convert to pixels based on grid spacing scale (1000 mm per spacing unit)
-    const double scale = spacing / 1000.0;
-    const int halfWidthPx = static_cast<int>(halfWidthMM * scale);
-    const int halfHeightPx = static_cast<int>((heightMM / 2.0) * scale);
-
-    // Points matching the JS reference (draw each side explicitly)
-    const QPoint rightBottom(centerX + halfWidthPx, centerY - static_cast<int>(0 * scale));
-    const QPoint rightTop(centerX + halfWidthPx, centerY - static_cast<int>(heightMM * scale));
-    const QPoint leftBottom(centerX - halfWidthPx, centerY - static_cast<int>(0 * scale));
-    const QPoint leftTop(centerX - halfWidthPx, centerY - static_cast<int>(heightMM * scale));
-
-    QPen prev = p->pen();
-    QPen outlinePen(Qt::black, 2, Qt::SolidLine);
-    outlinePen.setCosmetic(true);
-    p->setPen(outlinePen);
-
-    // Right line
-    p->drawLine(rightBottom, rightTop);
-    // Top line
-    p->drawLine(rightTop, leftTop);
-    // Left line
-    p->drawLine(leftBottom, leftTop);
-    // Bottom line
-    p->drawLine(leftBottom, rightBottom);
-
-    p->setPen(prev);
+    if (m_geometryDirty)
+        rebuildLineGeometry();
+    return m_scene;
 }
 
-// Draw Z coordinate lines (HORIZONTAL lines) - based on reference JavaScript
-void FrameArrangementYZFrameController::drawZCoordinateLines(QPainter *p, int centerX, int centerY, int spacing,
-                                                           double zCoor, double spacingInLoop, const QString &thisSym, const QString &prefix, const QString &name, int &globalIndex)
+// Expand the controller's rows into sorted line geometry (once per YZ data change)
+void FrameArrangementYZFrameController::rebuildLineGeometry()
 {
-    qDebug() << "Drawing Z coordinate (HORIZONTAL) lines - zCoor:" << zCoor << "spacingInLoop:" << spacingInLoop << "sym:" << thisSym;
-
-    // Calculate Y positions for horizontal lines (like reference JavaScript)
-    int firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z;
+    loadFrameData();
 
-    if (thisSym == "P") {
-        // Define first point (left side)
-        firstPoint_y = centerX + -99999 * spacing;
-        firstPoint_z = centerY - static_cast<int>((zCoor + spacingInLoop) / 1000.0 * spacing);
+    QVector<YZLineGeometry::Row> rows;
+    rows.reserve(m_frameYZDrawing.size());
+    for (const auto &val : m_frameYZDrawing) {
+        YZLineGeometry::Row row;
+        if (val.isObject() && geometryRow(val.toObject(), row))
+            rows.append(row);
+    }
 
-        // Define second point (to center)
-        secondPoint_y = centerX + 0 * spacing;
-        secondPoint_z = centerY - static_cast<int>((zCoor + spacingInLoop) / 1000.0 * spacing);
+    m_scene.hasData = !m_frameYZDrawing.isEmpty();
+    m_scene.geometry.build(rows);
+    m_scene.lod.build(m_scene.geometry);
+    applyHullClip();
+    m_geometryDirty = false;
+    qDebug() << "FrameArrangementYZFrameController::rebuildLineGeometry() -" << rows.size() << "rows,"
+             << m_scene.geometry.lineCount() << "lines," << m_scene.geometry.groups().size() << "prefix groups";
+    updateScene();
+}
 
-        // Draw line
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew P side horizontal line from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-        // Record for hit testing
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), true, globalIndex, (zCoor + spacingInLoop), QStringLiteral("Y"), prefix, name });
-        ++globalIndex;
-    }
-    else if (thisSym == "S") {
-        // Define first point (from center)
-        firstPoint_y = centerX + 0 * spacing;
-        firstPoint_z = centerY - static_cast<int>((zCoor + spacingInLoop) / 1000.0 * spacing);
-
-        // Define second point (right side)
-        secondPoint_y = centerX + 99999 * spacing;
-        secondPoint_z = centerY - static_cast<int>((zCoor + spacingInLoop) / 1000.0 * spacing);
-
-        // Draw line
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew S side horizontal line from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), true, globalIndex, (zCoor + spacingInLoop), QStringLiteral("Y"), prefix, name });
-        ++globalIndex;
-    }
-    else if (thisSym == "P+S" || thisSym == "S+P") {
-        // Draw two mirrored halves (left and right) that share the SAME global index
-        const int yPx = centerY - static_cast<int>((zCoor + spacingInLoop) / 1000.0 * spacing);
-
-        // Left half: from far left to center
-        firstPoint_y = centerX + -99999 * spacing;
-        firstPoint_z = yPx;
-        secondPoint_y = centerX;
-        secondPoint_z = yPx;
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew P+S left horizontal half from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), true, globalIndex, (zCoor + spacingInLoop), QStringLiteral("Y"), prefix, name });
-
-        // Right half: from center to far right
-        firstPoint_y = centerX;
-        firstPoint_z = yPx;
-        secondPoint_y = centerX + 99999 * spacing;
-        secondPoint_z = yPx;
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew P+S right horizontal half from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), true, globalIndex, (zCoor + spacingInLoop), QStringLiteral("Y"), prefix, name });
-
-        // Increment ONCE for the logical line
-        ++globalIndex;
+bool FrameArrangementYZFrameController::geometryRow(const QJsonObject &entry, YZLineGeometry::Row &row) const
+{
+    if (!isValidFieldData(entry)) return false;
+
+    // Prefix/suffix come parsed from the model's stored columns
+    row.prefix = entry.value("prefix").toString();
+    row.suffix = entry.value("suffix").toInteger();
+    if (row.prefix.isEmpty()) {
+        int startSuffix = 0;
+        YZNaming::parsePrefixSuffix(entry.value("name").toString(), row.prefix, startSuffix);
+        row.suffix = startSuffix;
     }
+    row.count = std::max(0, entry.value("no").toInt());
+    row.spacing = entry.value("spacing").toDouble();
+    row.y = entry.value("y").toDouble();
+    row.z = entry.value("z").toDouble();
+    row.hasY = hasYValue(entry);
+    row.hasZ = hasZValue(entry);
+    row.sym = entry.value("sym").toString();
+    row.frameNo = entry.value("frameNo").toInt(-1);
+    return true;
 }
 
-// Draw Y coordinate lines (VERTICAL lines) - based on reference JavaScript  
-void FrameArrangementYZFrameController::drawYCoordinateLines(QPainter *p, int centerX, int centerY, int spacing,
-                                                           double yCoor, double spacingInLoop, const QString &thisSym, const QString &prefix, const QString &name, int &globalIndex)
+// Hand the current drawing state to the tile renderer, which drops only the affected tiles
+void FrameArrangementYZFrameController::updateScene()
 {
-    qDebug() << "Drawing Y coordinate (VERTICAL) lines - yCoor:" << yCoor << "spacingInLoop:" << spacingInLoop << "sym:" << thisSym;
-
-    // Calculate positions for vertical lines (like reference JavaScript)
-    int firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z;
-
-    if (thisSym == "P") {
-        // Ensure yCoor is always negative for P side
-        double yCoorNeg = -qAbs(yCoor + spacingInLoop);
+    m_palette.assign(m_scene.geometry.prefixes());
+    m_scene.colors = m_palette.colors();
+    m_scene.pens = m_palette.pens();
+    m_scene.outlineHalfWidthMM = m_outlineHalfWidthMM;
+    m_scene.outlineHeightMM = m_outlineHeightMM;
+    m_scene.lodPixelThreshold = m_lodPixelThreshold;
+    m_tiles->setScene(m_scene);
+    m_labels.setScene(m_scene);
+}
 
-        // Define first point (top)
-        firstPoint_y = centerX + static_cast<int>(yCoorNeg / 1000.0 * spacing);
-        firstPoint_z = centerY - -99999 * spacing;
+// Outline polygon of the current frame, and per-line spans of each line on its own row's
+// frame; the HullOffsets cache keeps both per frame, so re-clipping unchanged lines is a lookup
+void FrameArrangementYZFrameController::applyHullClip()
+{
+    m_scene.hullPolygon.clear();
+    m_scene.hullClip = HullSectionCache::LineClip();
 
-        // Define second point (bottom)
-        secondPoint_y = centerX + static_cast<int>(yCoorNeg / 1000.0 * spacing);
-        secondPoint_z = centerY - 99999 * spacing;
+    HullOffsets *offsets = qobject_cast<HullOffsets*>(m_hullOffsets);
+    if (!offsets)
+        return;
+    m_scene.hullPolygon = offsets->sections().polygon(m_currentFrameNo);
+    m_scene.hullClip = offsets->sections().clipGeometry(m_scene.geometry, m_currentFrameNo);
+}
 
-        // Draw line
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew P side vertical line from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), false, globalIndex, (yCoor + spacingInLoop), QStringLiteral("Z"), prefix, name });
-        ++globalIndex;
-    }
-    else if (thisSym == "S") {
-        // Ensure yCoor is always positive for S side
-        double yCoorPos = qAbs(yCoor + spacingInLoop);
-
-        // Define first point (top)
-        firstPoint_y = centerX + static_cast<int>(yCoorPos / 1000.0 * spacing);
-        firstPoint_z = centerY - -99999 * spacing;
-
-        // Define second point (bottom)
-        secondPoint_y = centerX + static_cast<int>(yCoorPos / 1000.0 * spacing);
-        secondPoint_z = centerY - 99999 * spacing;
-
-        // Draw line
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew S side vertical line from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), false, globalIndex, (yCoor + spacingInLoop), QStringLiteral("Z"), prefix, name });
-        ++globalIndex;
-    }
-    else if (thisSym == "P+S" || thisSym == "S+P") {
-        double yCoorPos = qAbs(yCoor + spacingInLoop);
-        double yCoorNeg = -qAbs(yCoor + spacingInLoop);
-
-        // Use the same global index for both mirrored lines
-        const int sharedIndex = globalIndex;
-
-        // Draw right line (S side)
-        firstPoint_y = centerX + static_cast<int>(yCoorPos / 1000.0 * spacing);
-        firstPoint_z = centerY - -99999 * spacing;
-        secondPoint_y = centerX + static_cast<int>(yCoorPos / 1000.0 * spacing);
-        secondPoint_z = centerY - 99999 * spacing;
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew P+S right vertical line from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), false, sharedIndex, (yCoorPos), QStringLiteral("Z"), prefix, name });
-
-        // Draw left line (P side)
-        firstPoint_y = centerX + static_cast<int>(yCoorNeg / 1000.0 * spacing);
-        firstPoint_z = centerY - -99999 * spacing;
-        secondPoint_y = centerX + static_cast<int>(yCoorNeg / 1000.0 * spacing);
-        secondPoint_z = centerY - 99999 * spacing;
-        p->drawLine(firstPoint_y, firstPoint_z, secondPoint_y, secondPoint_z);
-        qDebug() << "Drew P+S left vertical line from (" << firstPoint_y << "," << firstPoint_z << ") to (" << secondPoint_y << "," << secondPoint_z << ")";
-    m_drawnLines.push_back({ QLineF(QPointF(firstPoint_y, firstPoint_z), QPointF(secondPoint_y, secondPoint_z)), false, sharedIndex, (yCoorNeg), QStringLiteral("Z"), prefix, name });
-
-        // Increment ONCE for the logical line
-        ++globalIndex;
+void FrameArrangementYZFrameController::rebuildHullClip()
+{
+    // A pending geometry rebuild clips as well
+    if (!m_geometryDirty) {
+        applyHullClip();
+        updateScene();
     }
+    update();
+}
+
+void FrameArrangementYZFrameController::invalidateLineGeometry()
+{
+    m_geometryDirty = true;
+    update();
 }
 
 // Validation and calculation helper functions
@@ -434,10 +219,6 @@ bool FrameArrangementYZFrameController::isValidFieldData(const QJsonObject& fiel
     bool hasSpacing = fieldData.contains("spacing");
     bool hasSym = fieldData.contains("sym");
     
-    qDebug() << "Validation - hasNo:" << hasNo << "hasYorZ:" << hasYorZ 
-             << "hasSpacing:" << hasSpacing << "hasSym:" << hasSym;
-    qDebug() << "Field data keys:" << fieldData.keys();
-    
     return hasNo && hasYorZ && hasSpacing && hasSym;
 }
 
@@ -475,13 +256,9 @@ bool FrameArrangementYZFrameController::hasYValue(const QJsonObject& fieldData)
     // Check if Y field is set and not empty string
     QJsonValue yValue = fieldData.value("y");
     if (yValue.isString()) {
-        QString yStr = yValue.toString();
-        bool isEmpty = yStr.isEmpty();
-        qDebug() << "Y value check - string:" << yStr << "isEmpty:" << isEmpty;
-        return !isEmpty; // Return true if not empty string (including "0")
+        return !yValue.toString().isEmpty(); // Return true if not empty string (including "0")
     } else if (yValue.isDouble() || yValue.isNull()) {
         // For numeric values, always return true (including 0.0)
-        qDebug() << "Y value check - numeric:" << yValue.toDouble() << "- returning true";
         return true;
     }
     
@@ -495,13 +272,9 @@ bool FrameArrangementYZFrameController::hasZValue(const QJsonObject& fieldData)
     // Check if Z field is set and not empty string
     QJsonValue zValue = fieldData.value("z");
     if (zValue.isString()) {
-        QString zStr = zValue.toString();
-        bool isEmpty = zStr.isEmpty();
-        qDebug() << "Z value check - string:" << zStr << "isEmpty:" << isEmpty;
-        return !isEmpty; // Return true if not empty string (including "0")
+        return !zValue.toString().isEmpty(); // Return true if not empty string (including "0")
     } else if (zValue.isDouble() || zValue.isNull()) {
         // For numeric values, always return true (including 0.0)
-        qDebug() << "Z value check - numeric:" << zValue.toDouble() << "- returning true";
         return true;
     }
     
@@ -510,11 +283,18 @@ bool FrameArrangementYZFrameController::hasZValue(const QJsonObject& fieldData)
 
 void FrameArrangementYZFrameController::loadFrameData()
 {
-    if (!m_controller) return;
+    if (!m_controller) {
+        m_frameYZDrawing = QJsonArray();
+        return;
+    }
+
+    // Query the main table only when asked to; otherwise reuse the list the controller
+    // already published (frameYZListChanged marks the geometry dirty)
+    if (m_fetchPending) {
+        m_fetchPending = false;
+        QMetaObject::invokeMethod(m_controller, "getFrameYZAll", Qt::DirectConnection);
+    }
 
-    // Get all frame YZ data from main table
-    QMetaObject::invokeMethod(m_controller, "getFrameYZAll", Qt::DirectConnection);
-    
     // Get the frameYZList property (contains all data)
     QVariant allData = m_controller->property("frameYZList");
     if (allData.canConvert<QJsonArray>()) {
@@ -556,14 +336,23 @@ void FrameArrangementYZFrameController::setCurrentFrameNo(int frameNo)
     if (m_currentFrameNo != frameNo) {
         m_currentFrameNo = frameNo;
         emit currentFrameNoChanged();
-        update();
+        if (m_hullOffsets)
+            rebuildHullClip();
+        else
+            update();
     }
 }
 
 void FrameArrangementYZFrameController::setFrameController(QObject* controller)
 {
     if (m_controller != controller) {
+        if (m_controller)
+            disconnect(m_controller, nullptr, this, nullptr);
         m_controller = controller;
+        if (m_controller)
+            connect(m_controller, SIGNAL(frameYZListChanged()), this, SLOT(invalidateLineGeometry()));
+        m_fetchPending = true;
+        m_geometryDirty = true;
         emit frameControllerChanged();
         update();
     }
@@ -607,15 +396,87 @@ void FrameArrangementYZFrameController::setPanY(double y)
     }
 }
 
+void FrameArrangementYZFrameController::setLodPixelThreshold(double px)
+{
+    if (!qFuzzyCompare(m_lodPixelThreshold, px)) {
+        m_lodPixelThreshold = px;
+        emit lodPixelThresholdChanged();
+        updateScene();
+        update();
+    }
+}
+
+void FrameArrangementYZFrameController::setShowLabels(bool show)
+{
+    if (m_showLabels != show) {
+        m_showLabels = show;
+        emit showLabelsChanged();
+        update();
+    }
+}
+
+void FrameArrangementYZFrameController::setPrincipalDimensions(QObject* dimensions)
+{
+    if (m_dimensions == dimensions)
+        return;
+
+    if (m_dimensions)
+        disconnect(m_dimensions, nullptr, this, nullptr);
+    m_dimensions = dimensions;
+    if (m_dimensions)
+        connect(m_dimensions, SIGNAL(dimensionsChanged()), this, SLOT(rebuildOutlineGeometry()));
+
+    emit principalDimensionsChanged();
+    rebuildOutlineGeometry();
+}
+
+void FrameArrangementYZFrameController::setHullOffsets(QObject* offsets)
+{
+    if (m_hullOffsets == offsets)
+        return;
+
+    if (m_hullOffsets)
+        disconnect(m_hullOffsets, nullptr, this, nullptr);
+    m_hullOffsets = offsets;
+    if (m_hullOffsets)
+        connect(m_hullOffsets, SIGNAL(sectionsChanged()), this, SLOT(rebuildHullClip()));
+
+    emit hullOffsetsChanged();
+    rebuildHullClip();
+}
+
+void FrameArrangementYZFrameController::rebuildOutlineGeometry()
+{
+    double halfWidthMM = 24384.0 / 2.0;
+    double heightMM = 5490.0;
+
+    if (m_dimensions) {
+        const double breadth = m_dimensions->property("breadth").toDouble();
+        const double depth = m_dimensions->property("depth").toDouble();
+        if (breadth > 0.0)
+            halfWidthMM = breadth * 1000.0 / 2.0;
+        if (depth > 0.0)
+            heightMM = depth * 1000.0;
+    }
+
+    if (qFuzzyCompare(m_outlineHalfWidthMM, halfWidthMM) && qFuzzyCompare(m_outlineHeightMM, heightMM))
+        return;
+
+    m_outlineHalfWidthMM = halfWidthMM;
+    m_outlineHeightMM = heightMM;
+    updateScene();
+    update();
+}
+
 void FrameArrangementYZFrameController::regenerateDrawingData()
 {
     if (!m_controller) return;
 
-    // Simply refresh data from main table
-    QMetaObject::invokeMethod(m_controller, "getFrameYZAll", Qt::DirectConnection);
-    // Clear cached line records so next paint rebuilds with fresh global indices
-    m_drawnLines.clear();
-    
+    // Refresh data from main table on the next paint; line geometry and hit records
+    // are rebuilt with fresh global indices
+    m_fetchPending = true;
+    m_geometryDirty = true;
+
     // Refresh the display
     update();
 }
@@ -651,16 +512,60 @@ QPointF FrameArrangementYZFrameController::toWorldFromScreen(const QPointF &scre
     return pt;
 }
 
+QRectF FrameArrangementYZFrameController::visibleWorldRect(int centerX, int centerY) const
+{
+    // Item rectangle mapped back through the view transform, padded by a couple of pixels
+    // so cosmetic pens on the border are not cut off
+    const QPointF topLeft = toWorldFromScreen(QPointF(0, 0), centerX, centerY);
+    const QPointF bottomRight = toWorldFromScreen(QPointF(width(), height()), centerX, centerY);
+    const double margin = 2.0 / (qFuzzyIsNull(m_scaleFactor) ? 1.0 : m_scaleFactor);
+    return QRectF(topLeft, bottomRight).normalized().adjusted(-margin, -margin, margin, margin);
+}
+
+// Clipped segments of the individually drawn lines in the current view (prefixes drawn as
+// LOD bands have no per-line records), in world/item coords prior to the view transform
+QVector<FrameArrangementYZFrameController::LineRecord> FrameArrangementYZFrameController::visibleLineRecords(int centerX, int centerY,
+                                                                                                          bool banded) const
+{
+    QVector<LineRecord> records;
+    if (!m_scene.hasData) return records;
+
+    const YZLineGeometry &geometry = m_scene.geometry;
+    const QRectF view = visibleWorldRect(centerX, centerY);
+    const double k = m_gridSpacing / 1000.0;
+    const double thresholdMM = YZSceneRenderer::lodThresholdMM(m_scene, k * m_scaleFactor);
+    QLineF segments[2];
+    double values[2];
+    QVector<QLineF> parts;
+    for (int g = 0; g < geometry.groups().size(); ++g) {
+        if (YZSceneRenderer::isGroupDense(m_scene, g, thresholdMM) != banded) continue;
+        const auto &group = geometry.groups().at(g);
+        for (int i = group.begin; i < group.end; ++i) {
+            const quint8 axis = geometry.axes().at(i);
+            const int n = YZSceneRenderer::lineSegments(axis, geometry.sides().at(i), geometry.positions().at(i),
+                                                        centerX, centerY, k, view, segments, values);
+            for (int s = 0; s < n; ++s) {
+                parts.clear();
+                YZSceneRenderer::hullSegments(m_scene, i, segments[s], centerX, centerY, k, parts);
+                for (const QLineF &part : parts)
+                    records.push_back({ part, axis == YZLineGeometry::Horizontal, i, values[s] });
+            }
+        }
+    }
+    return records;
+}
+
 QVariantMap FrameArrangementYZFrameController::hitTestAt(qreal x, qreal y, qreal pixelTolerance) const
 {
     QVariantMap res;
     res["success"] = false;
-    if (m_drawnLines.isEmpty()) return res;
 
     const int w = static_cast<int>(width());
     const int h = static_cast<int>(height());
     const int centerX = w / 2;
     const int centerY = h / 2;
+    QVector<LineRecord> drawnLines = visibleLineRecords(centerX, centerY);
+
     const QPointF worldPt = toWorldFromScreen(QPointF(x, y), centerX, centerY);
 
     // Because lines are scaled with painter, distance in world must account for scale.
@@ -670,41 +575,125 @@ QVariantMap FrameArrangementYZFrameController::hitTestAt(qreal x, qreal y, qreal
     // Gather all hits within tolerance
     struct Hit { int i; double d; };
     QVector<Hit> hits;
-    hits.reserve(m_drawnLines.size());
-    for (int i = 0; i < m_drawnLines.size(); ++i) {
-        const auto &rec = m_drawnLines[i];
+    hits.reserve(drawnLines.size());
+    for (int i = 0; i < drawnLines.size(); ++i) {
+        const auto &rec = drawnLines[i];
         double d = distancePointToSegment(worldPt, rec.line);
         if (d <= tolWorld) hits.push_back({ i, d });
     }
 
+    // Nothing drawn as a line here: fall back to the nearest line of a LOD band. Lines in a
+    // band are closer than the LOD threshold, so any point on the band is near one of them
+    if (hits.isEmpty()) {
+        drawnLines = visibleLineRecords(centerX, centerY, true);
+        Hit nearest { -1, tolWorld };
+        for (int i = 0; i < drawnLines.size(); ++i) {
+            const double d = distancePointToSegment(worldPt, drawnLines[i].line);
+            if (d <= nearest.d) nearest = { i, d };
+        }
+        if (nearest.i >= 0) hits.push_back(nearest);
+    }
+
     if (!hits.isEmpty()) {
         std::sort(hits.begin(), hits.end(), [](const Hit &a, const Hit &b){ return a.d < b.d; });
         // Build an array of candidate hits with full data; also prepare primary (closest) for backward compatibility
         QJsonArray candidates;
         for (const auto &h : hits) {
-            const auto &rec = m_drawnLines[h.i];
+            const auto &rec = drawnLines[h.i];
             QJsonObject obj;
             obj.insert("index", rec.index);
-            obj.insert("axis", rec.axis);
+            obj.insert("axis", rec.horizontal ? QStringLiteral("Y") : QStringLiteral("Z"));
             obj.insert("valueMM", rec.valueMM);
             obj.insert("horizontal", rec.horizontal);
-            obj.insert("prefix", rec.prefix);
-            obj.insert("name", rec.name);
+            obj.insert("prefix", m_scene.geometry.prefixOf(rec.index));
+            obj.insert("name", m_scene.geometry.lineName(rec.index));
             obj.insert("distance", h.d);
             candidates.push_back(obj);
         }
 
-        const auto &rec = m_drawnLines[hits.first().i];
+        const auto &rec = drawnLines[hits.first().i];
         res["success"] = true;
         res["index"] = rec.index;
-        res["axis"] = rec.axis;
+        res["axis"] = rec.horizontal ? QStringLiteral("Y") : QStringLiteral("Z");
         res["valueMM"] = rec.valueMM;
+        const QString name = m_scene.geometry.lineName(rec.index);
         if (rec.horizontal) {
-            res["text"] = QString("Line %1 coordinate Y: ~ Z: %2").arg(rec.name).arg(rec.valueMM);
+            res["text"] = QString("Line %1 coordinate Y: ~ Z: %2").arg(name).arg(rec.valueMM);
         } else {
-            res["text"] = QString("Line %1 coordinate Y: %2 Z: ~").arg(rec.name).arg(rec.valueMM);
+            res["text"] = QString("Line %1 coordinate Y: %2 Z: ~").arg(name).arg(rec.valueMM);
         }
         res["candidates"] = candidates;
     }
     return res;
 }
+
+QVariantMap FrameArrangementYZFrameController::exportSection(const QString &fileName, int frameNo)
+{
+    QVariantMap res;
+    res["success"] = false;
+
+    // Accept plain paths and file URLs from QML file dialogs
+    const QString path = fileName.startsWith("file:") ? QUrl(fileName).toLocalFile() : fileName;
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (m_geometryDirty)
+        rebuildLineGeometry();
+
+    QFile file(path);
+    std::unique_ptr<YZSectionSink> sink;
+    if (suffix == "pdf") {
+        sink = std::make_unique<YZPdfSink>(path);
+    } else if (suffix == "svg" || suffix == "dxf") {
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            res["error"] = QString("Cannot write %1: %2").arg(path, file.errorString());
+            qCritical() << "FrameArrangementYZFrameController::exportSection() -" << res["error"].toString();
+            return res;
+        }
+        if (suffix == "svg")
+            sink = std::make_unique<YZSvgSink>(&file);
+        else
+            sink = std::make_unique<YZDxfSink>(&file);
+    } else {
+        res["error"] = QString("Unsupported export format: %1").arg(suffix);
+        qCritical() << "FrameArrangementYZFrameController::exportSection() -" << res["error"].toString();
+        return res;
+    }
+
+    // Same colours and outline as on screen; rows stream straight from the drawing list
+    YZSectionExporter exporter(sink.get());
+    exporter.setOutline(m_outlineHalfWidthMM, m_outlineHeightMM);
+    exporter.setShowLabels(m_showLabels);
+    // The hull section is known per frame: one frame is drawn inside its own section; a
+    // sheet with every frame keeps the B x D outline and clips each row to its frame's section
+    HullOffsets *offsets = qobject_cast<HullOffsets*>(m_hullOffsets);
+    if (offsets && frameNo >= 0)
+        exporter.setHullPolygon(offsets->sections().polygon(frameNo));
+    exporter.setPalette(m_palette.prefixColors());
+    if (!exporter.begin()) {
+        res["error"] = QString("Cannot start export to %1").arg(path);
+        qCritical() << "FrameArrangementYZFrameController::exportSection() -" << res["error"].toString();
+        return res;
+    }
+    for (const auto &val : m_frameYZDrawing) {
+        if (!val.isObject()) continue;
+        const QJsonObject entry = val.toObject();
+        if (frameNo >= 0 && entry.value("frameNo").toInt() != frameNo) continue;
+        YZLineGeometry::Row row;
+        if (!geometryRow(entry, row))
+            continue;
+        if (offsets && frameNo < 0)
+            exporter.addRow(row, offsets->sections().polygon(entry.value("frameNo").toInt()));
+        else
+            exporter.addRow(row);
+    }
+    if (!exporter.end()) {
+        res["error"] = QString("Failed to write %1").arg(path);
+        qCritical() << "FrameArrangementYZFrameController::exportSection() -" << res["error"].toString();
+        return res;
+    }
+
+    qDebug() << "FrameArrangementYZFrameController::exportSection() -" << exporter.lineCount() << "lines to" << path;
+    res["success"] = true;
+    res["path"] = path;
+    res["lines"] = exporter.lineCount();
+    return res;
+}
@@ -6,6 +6,13 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QVariant>
+#include <QVector>
+#include <QLineF>
+#include <QRectF>
+#include "YZSceneRenderer.h"
+#include "YZTileRenderer.h"
+#include "YZPalette.h"
+#include "YZLabelLayer.h"
 
 class FrameArrangementYZController;
 
@@ -20,6 +27,15 @@ class FrameArrangementYZFrameController : public QQuickPaintedItem
     Q_PROPERTY(double scaleFactor READ scaleFactor WRITE setScaleFactor NOTIFY scaleFactorChanged)
     Q_PROPERTY(double panX READ panX WRITE setPanX NOTIFY panXChanged)
     Q_PROPERTY(double panY READ panY WRITE setPanY NOTIFY panYChanged)
+    // Lines of one prefix closer than this many pixels are drawn as shaded bands (0 disables)
+    Q_PROPERTY(double lodPixelThreshold READ lodPixelThreshold WRITE setLodPixelThreshold NOTIFY lodPixelThresholdChanged)
+    // Always-on line name labels for the visible, individually drawn lines
+    Q_PROPERTY(bool showLabels READ showLabels WRITE setShowLabels NOTIFY showLabelsChanged)
+    // Principal dimensions object (breadth/depth in metres) driving the hull outline
+    Q_PROPERTY(QObject* principalDimensions READ principalDimensions WRITE setPrincipalDimensions NOTIFY principalDimensionsChanged)
+    // Hull offset table (HullOffsets); when set, the outline is the current frame's section
+    // and each line is clipped to the section of its own row's frame
+    Q_PROPERTY(QObject* hullOffsets READ hullOffsets WRITE setHullOffsets NOTIFY hullOffsetsChanged)
 
 public:
     explicit FrameArrangementYZFrameController(QQuickItem *parent = nullptr);
@@ -34,6 +50,10 @@ public:
     double scaleFactor() const { return m_scaleFactor; }
     double panX() const { return m_panX; }
     double panY() const { return m_panY; }
+    double lodPixelThreshold() const { return m_lodPixelThreshold; }
+    bool showLabels() const { return m_showLabels; }
+    QObject* principalDimensions() const { return m_dimensions; }
+    QObject* hullOffsets() const { return m_hullOffsets; }
 
     // Property setters
     void setGridSpacing(int spacing);
@@ -43,14 +63,31 @@ public:
     void setScaleFactor(double s);
     void setPanX(double x);
     void setPanY(double y);
+    void setLodPixelThreshold(double px);
+    void setShowLabels(bool show);
+    void setPrincipalDimensions(QObject* dimensions);
+    void setHullOffsets(QObject* offsets);
 
 public slots:
     void regenerateDrawingData();
+    void rebuildOutlineGeometry();
+    // Marks the line geometry stale (frame controller's frameYZListChanged)
+    void invalidateLineGeometry();
+    // Re-clips the lines to their frames' hull sections (offsets or frame positions changed)
+    void rebuildHullClip();
 
 public:
     // Hit-test at item coordinates (pixels). Returns a map with keys:
     // success(bool), text(QString), index(int), axis(QString: "Y"|"Z"), orientation(QString), valueMM(double)
     Q_INVOKABLE QVariantMap hitTestAt(qreal x, qreal y, qreal pixelTolerance = 6.0) const;
+    // Streams the section to fileName as SVG, PDF or DXF (by suffix); frameNo < 0 exports
+    // every row. Returns success(bool), path(QString), lines(int) or error(QString)
+    Q_INVOKABLE QVariantMap exportSection(const QString &fileName, int frameNo = -1);
+
+    // Scene as painted, with the line geometry rebuilt first when the YZ data changed
+    const YZSceneRenderer::Scene &scene();
+    // True when every tile asked for by the last paint has been rendered
+    bool tilesIdle() const { return m_tiles->isIdle(); }
 
 signals:
     void gridSpacingChanged();
@@ -60,27 +97,27 @@ signals:
     void scaleFactorChanged();
     void panXChanged();
     void panYChanged();
+    void lodPixelThresholdChanged();
+    void showLabelsChanged();
+    void principalDimensionsChanged();
+    void hullOffsetsChanged();
 
 private:
     struct LineRecord {
         QLineF line;             // in world/item coords prior to painter scaling transform
         bool horizontal;         // true: horizontal (Y line per spec), false: vertical (Z line per spec)
-        int index;               // Global L{index}, zero-based across all rows/lines
+        int index;               // Global L{index}, zero-based across all rows/lines (= geometry line)
         double valueMM;          // value in mm for the axis label
-        QString axis;            // "Y" for horizontal, "Z" for vertical (per requested labeling)
-        QString prefix;          // User-provided prefix from Name column for labeling
-        QString name;            // Full Name from model (e.g., F7) for display
     };
 
-    // Drawing functions
-    void drawFrameLines(QPainter *p, int centerX, int centerY, int spacing);
-    void drawShipOutline(QPainter *p, int centerX, int centerY, int spacing);
-    
-    // Drawing helper functions for Y and Z coordinates (based on reference JavaScript)
-    void drawZCoordinateLines(QPainter *p, int centerX, int centerY, int spacing,
-                              double zCoor, double spacingInLoop, const QString &thisSym, const QString &prefix, const QString &name, int &globalIndex);
-    void drawYCoordinateLines(QPainter *p, int centerX, int centerY, int spacing,
-                              double yCoor, double spacingInLoop, const QString &thisSym, const QString &prefix, const QString &name, int &globalIndex);
+    // Cached line geometry, rebuilt on YZ data change, and the scene handed to the tile renderer
+    void rebuildLineGeometry();
+    bool geometryRow(const QJsonObject &entry, YZLineGeometry::Row &row) const;
+    void updateScene();
+    void applyHullClip();
+    // Visible lines of the groups drawn line by line, or with banded = true of the groups
+    // drawn as LOD bands
+    QVector<LineRecord> visibleLineRecords(int centerX, int centerY, bool banded = false) const;
 
     // Validation and calculation helpers
     bool isValidFieldData(const QJsonObject& fieldData) const;
@@ -97,6 +134,8 @@ private:
     // Geometry helpers
     double distancePointToSegment(const QPointF &pt, const QLineF &seg) const;
     QPointF toWorldFromScreen(const QPointF &screenPt, int centerX, int centerY) const;
+    // Item rectangle in world/item coords before the pan/zoom transform
+    QRectF visibleWorldRect(int centerX, int centerY) const;
 
     // Member variables
     int m_gridSpacing;
@@ -108,9 +147,22 @@ private:
     double m_scaleFactor;
     double m_panX;
     double m_panY;
-
-    // Drawn lines metadata for hit testing (data lines only; exclude centerlines/outline)
-    QVector<LineRecord> m_drawnLines;
+    double m_lodPixelThreshold;
+    bool m_showLabels;
+    // Hull outline geometry, rebuilt only when the principal dimensions change
+    QObject* m_dimensions;
+    double m_outlineHalfWidthMM;
+    double m_outlineHeightMM;
+    QObject* m_hullOffsets;
+
+    // Expanded, prefix-sorted line geometry with LOD bands, palette and outline; rasterised
+    // into tiles in the background, paint only composites them
+    YZSceneRenderer::Scene m_scene;
+    YZPalette m_palette;
+    YZLabelLayer m_labels;
+    YZTileRenderer *m_tiles;
+    bool m_geometryDirty;
+    bool m_fetchPending;
 };
 
 #endif // FRAMEARRANGEMENTYZFRAMECONTROLLER_H
@@ -0,0 +1,224 @@
+#include "HullGirderController.h"
+#include "StructureProfileTableController.h"
+#include "../database/models/FrameArrangementYZ.h"
+#include "../database/models/HullOffsets.h"
+#include "../database/models/PrefixMembers.h"
+#include "../database/models/PrincipalDimensions.h"
+#include "../core/ProfileFormulas.h"
+#include <QSet>
+
+HullGirderController::HullGirderController(QObject *parent)
+    : QObject(parent)
+    , m_frameNo(0)
+    , m_plateThickness(10.0)
+    , m_model(nullptr)
+    , m_hullOffsets(nullptr)
+    , m_dimensions(nullptr)
+    , m_profiles(nullptr)
+    , m_members(nullptr)
+{
+    HullGirderSection::Member plating;
+    plating.plateThicknessMM = m_plateThickness;
+    m_section.setMembers({}, plating);
+}
+
+void HullGirderController::setFrameNo(int frameNo)
+{
+    if (m_frameNo == frameNo)
+        return;
+    m_frameNo = frameNo;
+    emit frameNoChanged();
+
+    // Another frame: other rows and another hull section
+    m_section.clear();
+    refreshBoundary();
+    syncRows();
+}
+
+void HullGirderController::setPlateThickness(double thickness)
+{
+    if (thickness < 0.0 || m_plateThickness == thickness)
+        return;
+    m_plateThickness = thickness;
+    emit plateThicknessChanged();
+    refreshMembers();
+}
+
+void HullGirderController::setModel(FrameArrangementYZ *model)
+{
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+    m_model = model;
+    if (m_model)
+        connect(m_model, &FrameArrangementYZ::dataChanged, this, &HullGirderController::syncRows);
+    syncRows();
+}
+
+void HullGirderController::setHullOffsets(HullOffsets *offsets)
+{
+    if (m_hullOffsets)
+        disconnect(m_hullOffsets, nullptr, this, nullptr);
+    m_hullOffsets = offsets;
+    if (m_hullOffsets)
+        connect(m_hullOffsets, &HullOffsets::sectionsChanged, this, &HullGirderController::refreshBoundary);
+    refreshBoundary();
+}
+
+void HullGirderController::setPrincipalDimensions(PrincipalDimensions *dimensions)
+{
+    if (m_dimensions)
+        disconnect(m_dimensions, nullptr, this, nullptr);
+    m_dimensions = dimensions;
+    if (m_dimensions)
+        connect(m_dimensions, &PrincipalDimensions::dimensionsChanged, this, &HullGirderController::refreshBoundary);
+    refreshBoundary();
+}
+
+void HullGirderController::setProfileController(StructureProfileTableController *profiles)
+{
+    if (m_profiles)
+        disconnect(m_profiles, nullptr, this, nullptr);
+    m_profiles = profiles;
+    if (m_profiles)
+        connect(m_profiles, &StructureProfileTableController::profilesDataChanged, this, &HullGirderController::refreshMembers);
+    refreshMembers();
+}
+
+void HullGirderController::setPrefixMembers(PrefixMembers *members)
+{
+    if (m_members)
+        disconnect(m_members, nullptr, this, nullptr);
+    m_members = members;
+    if (m_members)
+        connect(m_members, &PrefixMembers::membersChanged, this, &HullGirderController::refreshMembers);
+    refreshMembers();
+}
+
+bool HullGirderController::assignProfile(const QString &prefix, const QString &profileName, double plateThickness,
+                                         const QString &placement)
+{
+    if (!m_members) {
+        qCritical() << "HullGirderController::assignProfile() - Prefix members not set";
+        emit errorOccurred("Prefix members not set");
+        return false;
+    }
+    if (prefix.isEmpty() || plateThickness < 0.0) {
+        emit errorOccurred("A prefix and a non-negative plate thickness are required");
+        return false;
+    }
+
+    // Saving emits membersChanged, which refreshes the section
+    PrefixMembers::Member member = m_members->member(prefix);
+    member.profileName = profileName;
+    member.plateThickness = plateThickness;
+    member.placement = PrefixMembers::placementFromString(placement);
+    if (!m_members->setMember(member)) {
+        emit errorOccurred(m_members->lastError());
+        return false;
+    }
+    return true;
+}
+
+void HullGirderController::clearAssignment(const QString &prefix)
+{
+    if (m_members && !m_members->removeMember(prefix))
+        emit errorOccurred(m_members->lastError());
+}
+
+QVariantList HullGirderController::assignments() const
+{
+    return m_members ? m_members->memberList() : QVariantList();
+}
+
+void HullGirderController::syncRows()
+{
+    if (!m_model)
+        return;
+
+    QSet<int> seen;
+    bool changed = false;
+    const QList<FrameArrangementYZ::FrameYZData> &frames = m_model->allFrames();
+    for (int index : m_model->rowsOfFrame(m_frameNo)) {
+        const FrameArrangementYZ::FrameYZData &frame = frames.at(index);
+        changed |= m_section.setRow(frame.id, FrameArrangementYZ::geometryRow(frame));
+        seen.insert(frame.id);
+    }
+    for (int id : m_section.rowIds()) {
+        if (!seen.contains(id))
+            changed |= m_section.removeRow(id);
+    }
+
+    if (changed)
+        updateResult();
+}
+
+void HullGirderController::refreshMembers()
+{
+    HullGirderSection::Member plating;
+    plating.plateThicknessMM = m_plateThickness;
+
+    QHash<QString, HullGirderSection::Member> members;
+    const QHash<QString, PrefixMembers::Member> assigned = m_members ? m_members->members() : QHash<QString, PrefixMembers::Member>();
+    for (auto it = assigned.constBegin(); it != assigned.constEnd(); ++it) {
+        HullGirderSection::Member member;
+        member.plateThicknessMM = it.value().plateThickness;
+        member.placement = it.value().placement;
+        if (m_profiles && !it.value().profileName.isEmpty()) {
+            const QVariantMap profile = m_profiles->getProfileByName(it.value().profileName);
+            if (profile.isEmpty()) {
+                const QString error = QString("Profile %1 of prefix %2 not found").arg(it.value().profileName, it.key());
+                qWarning() << "HullGirderController::refreshMembers() -" << error;
+                emit errorOccurred(error);
+            } else {
+                member.areaCm2 = profile.value("area").toDouble();
+                member.eMM = profile.value("e").toDouble();
+                // upperI includes 40 tw of plating; the section adds its own plate strips
+                member.inertiaCm4 = ProfileFormulas::profileInertia(profile.value("hw").toDouble(), profile.value("tw").toDouble(),
+                                                                    profile.value("bfProfiles").toDouble(), profile.value("tf").toDouble());
+            }
+        }
+        members.insert(it.key(), member);
+    }
+
+    m_section.setMembers(members, plating);
+    updateResult();
+}
+
+void HullGirderController::refreshBoundary()
+{
+    double halfWidthMM = 24384.0 / 2.0;
+    double depthMM = 5490.0;
+    if (m_dimensions) {
+        if (m_dimensions->breadth() > 0.0)
+            halfWidthMM = m_dimensions->breadth() * 1000.0 / 2.0;
+        if (m_dimensions->depth() > 0.0)
+            depthMM = m_dimensions->depth() * 1000.0;
+    }
+    m_section.setOutline(halfWidthMM, depthMM);
+    m_section.setHullPolygon(m_hullOffsets ? m_hullOffsets->sections().polygon(m_frameNo) : QVector<QPointF>());
+    updateResult();
+}
+
+void HullGirderController::updateResult()
+{
+    m_result = m_section.result();
+    qDebug() << "HullGirderController::updateResult() - frame" << m_frameNo << m_section.rowCount() << "rows,"
+             << m_result.elements << "elements," << m_result.unplated << "unplated, NA" << m_result.neutralAxisM
+             << "m, I" << m_result.inertiaM4 << "m4";
+    emit resultChanged();
+}
+
+QVariantMap HullGirderController::result() const
+{
+    QVariantMap map;
+    map["valid"] = m_result.valid;
+    map["elements"] = m_result.elements;
+    map["area"] = m_result.areaM2;
+    map["neutralAxis"] = m_result.neutralAxisM;
+    map["inertia"] = m_result.inertiaM4;
+    map["modulusDeck"] = m_result.modulusDeckM3;
+    map["modulusKeel"] = m_result.modulusKeelM3;
+    map["unplated"] = m_result.unplated;
+    map["scope"] = HullGirderSection::scope();
+    return map;
+}
@@ -0,0 +1,85 @@
+#ifndef HULLGIRDERCONTROLLER_H
+#define HULLGIRDERCONTROLLER_H
+
+#include <QObject>
+#include <QHash>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QDebug>
+#include "../core/HullGirderSection.h"
+
+class FrameArrangementYZ;
+class HullOffsets;
+class PrefixMembers;
+class PrincipalDimensions;
+class StructureProfileTableController;
+
+/**
+ * Hull girder section modulus of one frame, kept up to date from the YZ rows, the prefix
+ * members stored in the ship database, the hull section and the principal dimensions.
+ *
+ * A YZ change only re-expands the rows that differ from the last sync; a profile edit only
+ * the rows of the prefixes using that profile. result holds valid, elements, area (m2),
+ * neutralAxis (m above base), inertia (m4), modulusDeck and modulusKeel (m3), unplated
+ * (longitudinals without a plate strip) and scope, which states what the section includes:
+ * longitudinals and their plate strips only, see HullGirderSection.
+ */
+class HullGirderController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int frameNo READ frameNo WRITE setFrameNo NOTIFY frameNoChanged)
+    // Plating thickness (mm) of prefixes without an assignment
+    Q_PROPERTY(double plateThickness READ plateThickness WRITE setPlateThickness NOTIFY plateThicknessChanged)
+    Q_PROPERTY(QVariantMap result READ result NOTIFY resultChanged)
+
+public:
+    explicit HullGirderController(QObject *parent = nullptr);
+
+    int frameNo() const { return m_frameNo; }
+    double plateThickness() const { return m_plateThickness; }
+    QVariantMap result() const;
+
+    void setFrameNo(int frameNo);
+    void setPlateThickness(double thickness);
+
+    void setModel(FrameArrangementYZ *model);
+    void setHullOffsets(HullOffsets *offsets);
+    void setPrincipalDimensions(PrincipalDimensions *dimensions);
+    void setProfileController(StructureProfileTableController *profiles);
+    void setPrefixMembers(PrefixMembers *members);
+
+    // Stiffener profile (by library name) and plating thickness (mm) of a YZ prefix, saved
+    // in the ship database; placement "deck" puts its vertical lines under the deck,
+    // anything else on the bottom
+    Q_INVOKABLE bool assignProfile(const QString &prefix, const QString &profileName, double plateThickness,
+                                   const QString &placement = QString());
+    Q_INVOKABLE void clearAssignment(const QString &prefix);
+    Q_INVOKABLE QVariantList assignments() const;
+
+public slots:
+    void syncRows();
+    void refreshMembers();
+    void refreshBoundary();
+
+signals:
+    void frameNoChanged();
+    void plateThicknessChanged();
+    void resultChanged();
+    void errorOccurred(const QString &error);
+
+private:
+    int m_frameNo;
+    double m_plateThickness;
+    HullGirderSection m_section;
+    HullGirderSection::Result m_result;
+
+    FrameArrangementYZ *m_model;
+    HullOffsets *m_hullOffsets;
+    PrincipalDimensions *m_dimensions;
+    StructureProfileTableController *m_profiles;
+    PrefixMembers *m_members;
+
+    void updateResult();
+};
+
+#endif // HULLGIRDERCONTROLLER_H
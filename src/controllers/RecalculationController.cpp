@@ -0,0 +1,302 @@
+#include "RecalculationController.h"
+#include "FrameArrangementXZController.h"
+#include "StructureProfileTableController.h"
+#include "../core/ProfileFormulas.h"
+#include "../database/models/LinearIsotropicMaterials.h"
+#include <QElapsedTimer>
+#include <QMetaObject>
+
+static QString profileKey(int id, const char *part)
+{
+    return QStringLiteral("profile:%1:%2").arg(id).arg(QLatin1String(part));
+}
+
+static const char *kRehProfile = "reh:profile";
+static const char *kRehBracket = "reh:bracket";
+// ReH of mild steel, until one is entered or a material is picked
+static const double kDefaultReh = 235.0;
+
+RecalculationController::RecalculationController(QObject *parent)
+    : QObject(parent)
+    , m_materials(nullptr)
+    , m_profiles(nullptr)
+    , m_frames(nullptr)
+    , m_profileMaterial(0)
+    , m_bracketMaterial(0)
+    , m_rehProfile(kDefaultReh)
+    , m_rehBracket(kDefaultReh)
+    , m_scheduled(false)
+{
+    addRehNode(QLatin1String(kRehProfile), m_profileMaterial, &m_rehProfile);
+    addRehNode(QLatin1String(kRehBracket), m_bracketMaterial, &m_rehBracket);
+}
+
+QString RecalculationController::materialKey(int matNo)
+{
+    return QStringLiteral("material:%1").arg(matNo);
+}
+
+void RecalculationController::setProfileMaterial(int matNo)
+{
+    if (m_profileMaterial == matNo)
+        return;
+    m_profileMaterial = matNo;
+    addRehNode(QLatin1String(kRehProfile), m_profileMaterial, &m_rehProfile);
+    emit profileMaterialChanged();
+}
+
+void RecalculationController::setBracketMaterial(int matNo)
+{
+    if (m_bracketMaterial == matNo)
+        return;
+    m_bracketMaterial = matNo;
+    addRehNode(QLatin1String(kRehBracket), m_bracketMaterial, &m_rehBracket);
+    emit bracketMaterialChanged();
+}
+
+void RecalculationController::setRehProfile(double reh)
+{
+    if (m_profileMaterial != 0)
+        setProfileMaterial(0);
+    enterReh(QLatin1String(kRehProfile), reh, &m_rehProfile);
+}
+
+void RecalculationController::setRehBracket(double reh)
+{
+    if (m_bracketMaterial != 0)
+        setBracketMaterial(0);
+    enterReh(QLatin1String(kRehBracket), reh, &m_rehBracket);
+}
+
+// An entered ReH is a root value: its node is taken as given and the brackets follow
+void RecalculationController::enterReh(const QString &key, double value, double *reh)
+{
+    if (value <= 0.0 || value == *reh)
+        return;
+    *reh = value;
+    emit rehChanged();
+    invalidate(key);
+}
+
+// ReH follows the yield stress of one material; without a material (0) it keeps the
+// entered value
+void RecalculationController::addRehNode(const QString &key, int matNo, double *reh)
+{
+    m_graph.addNode(key, { materialKey(matNo) }, [this, matNo, reh]() {
+        const double value = m_yield.value(matNo, 0.0);
+        if (matNo <= 0 || value <= 0.0 || value == *reh)
+            return false;
+        *reh = value;
+        emit rehChanged();
+        return true;
+    });
+    // Re-reads the (new) material on the next run
+    if (matNo > 0)
+        invalidate(materialKey(matNo));
+}
+
+void RecalculationController::setMaterials(LinearIsotropicMaterials *materials)
+{
+    if (m_materials)
+        disconnect(m_materials, nullptr, this, nullptr);
+    m_materials = materials;
+    if (m_materials) {
+        connect(m_materials, &LinearIsotropicMaterials::materialInserted, this, &RecalculationController::syncMaterials);
+        connect(m_materials, &LinearIsotropicMaterials::materialUpdated, this, &RecalculationController::syncMaterials);
+        connect(m_materials, &LinearIsotropicMaterials::materialDeleted, this, &RecalculationController::syncMaterials);
+    }
+    syncMaterials();
+}
+
+void RecalculationController::setProfileController(StructureProfileTableController *profiles)
+{
+    if (m_profiles)
+        disconnect(m_profiles, nullptr, this, nullptr);
+    m_profiles = profiles;
+    if (m_profiles)
+        connect(m_profiles, &StructureProfileTableController::profilesDataChanged, this, &RecalculationController::syncProfiles);
+    syncProfiles();
+}
+
+void RecalculationController::setFrameController(FrameArrangementXZController *frames)
+{
+    if (m_frames)
+        m_frames->setRecalculation(nullptr);
+    m_frames = frames;
+    if (!m_frames) {
+        m_graph.removeNode(positionsKey());
+        return;
+    }
+    // The position engine already knows the re-spaced frame; the node writes what moved
+    m_graph.addNode(positionsKey(), { spacingKey() }, [frames]() { return frames->flushPendingCoordinates(); });
+    m_frames->setRecalculation(this);
+}
+
+void RecalculationController::invalidate(const QString &key)
+{
+    m_graph.invalidate(key);
+    scheduleRecalculation();
+}
+
+void RecalculationController::scheduleRecalculation()
+{
+    if (m_scheduled)
+        return;
+    m_scheduled = true;
+    QMetaObject::invokeMethod(this, "recalculate", Qt::QueuedConnection);
+}
+
+void RecalculationController::syncMaterials()
+{
+    if (!m_materials)
+        return;
+
+    QHash<int, double> yield;
+    for (const MaterialData &material : m_materials->getAllMaterials())
+        yield.insert(material.matNo, material.yieldStress);
+
+    for (auto it = yield.constBegin(); it != yield.constEnd(); ++it) {
+        const auto old = m_yield.constFind(it.key());
+        if (old == m_yield.constEnd() || old.value() != it.value())
+            invalidate(materialKey(it.key()));
+    }
+    for (auto it = m_yield.constBegin(); it != m_yield.constEnd(); ++it) {
+        if (!yield.contains(it.key()))
+            invalidate(materialKey(it.key()));
+    }
+    m_yield = yield;
+}
+
+void RecalculationController::syncProfiles()
+{
+    if (!m_profiles)
+        return;
+
+    // Values written by the last recalculation come back unchanged and invalidate nothing
+    QSet<int> seen;
+    for (const ProfileData &profile : m_profiles->allProfiles()) {
+        seen.insert(profile.id);
+        const auto it = m_profileValues.constFind(profile.id);
+        if (it == m_profileValues.constEnd()) {
+            // New rows arrive with their values already computed by the dialog
+            m_profileValues.insert(profile.id, profile);
+            addProfileNodes(profile.id);
+            continue;
+        }
+
+        const ProfileData &old = it.value();
+        const bool dims = profile.type != old.type || profile.hw != old.hw || profile.tw != old.tw
+                          || profile.bfProfiles != old.bfProfiles || profile.tf != old.tf;
+        const bool section = profile.area != old.area || profile.e != old.e || profile.w != old.w
+                             || profile.upperI != old.upperI;
+        m_profileValues.insert(profile.id, profile);
+        // A section edited together with its dimensions is kept as entered
+        if (section)
+            invalidate(profileKey(profile.id, "section"));
+        else if (dims)
+            invalidate(profileKey(profile.id, "dims"));
+    }
+
+    for (int id : m_profileValues.keys()) {
+        if (!seen.contains(id))
+            removeProfileNodes(id);
+    }
+}
+
+void RecalculationController::addProfileNodes(int id)
+{
+    m_graph.addNode(profileKey(id, "section"), { profileKey(id, "dims") },
+                    [this, id]() { return computeSection(id); });
+    m_graph.addNode(profileKey(id, "brackets"),
+                    { profileKey(id, "section"), QLatin1String(kRehProfile), QLatin1String(kRehBracket) },
+                    [this, id]() { return computeBrackets(id); });
+}
+
+void RecalculationController::removeProfileNodes(int id)
+{
+    m_graph.removeNode(profileKey(id, "section"));
+    m_graph.removeNode(profileKey(id, "brackets"));
+    m_profileValues.remove(id);
+    m_staged.remove(id);
+}
+
+bool RecalculationController::computeSection(int id)
+{
+    auto it = m_profileValues.find(id);
+    if (it == m_profileValues.end())
+        return false;
+    ProfileData &p = it.value();
+    if (p.hw <= 0.0 || p.tw <= 0.0)
+        return false;
+
+    const ProfileFormulas::SectionProperties s = ProfileFormulas::sectionProperties(p.hw, p.tw, p.bfProfiles, p.tf, p.type);
+    if (s.area == p.area && s.e == p.e && s.w == p.w && s.upperI == p.upperI)
+        return false;
+    p.area = s.area;
+    p.e = s.e;
+    p.w = s.w;
+    p.upperI = s.upperI;
+    m_staged.insert(id);
+    return true;
+}
+
+bool RecalculationController::computeBrackets(int id)
+{
+    auto it = m_profileValues.find(id);
+    if (it == m_profileValues.end())
+        return false;
+    ProfileData &p = it.value();
+    // Same guard as the profile table dialog: no tw or W, no brackets
+    if (m_rehProfile <= 0.0 || m_rehBracket <= 0.0 || p.tw <= 0.0 || p.w <= 0.0)
+        return false;
+
+    const ProfileFormulas::BracketSizes b = ProfileFormulas::bracketSizes(p.tw, p.w, m_rehProfile, m_rehBracket);
+    if (b.l == p.lowerL && b.tb == p.tb && b.bf == p.bfBrackets && b.tbf == p.tbf)
+        return false;
+    p.lowerL = b.l;
+    p.tb = b.tb;
+    p.bfBrackets = b.bf;
+    p.tbf = b.tbf;
+    m_staged.insert(id);
+    return true;
+}
+
+bool RecalculationController::recalculate()
+{
+    m_scheduled = false;
+    if (!m_graph.hasDirty())
+        return true;
+
+    QElapsedTimer timer;
+    timer.start();
+    m_lastRecalculated = m_graph.run();
+    const bool ok = writeStaged();
+    qDebug() << "RecalculationController::recalculate() -" << m_lastRecalculated.size() << "nodes in"
+             << timer.elapsed() << "ms";
+    emit recalculated(m_lastRecalculated);
+    return ok;
+}
+
+bool RecalculationController::writeStaged()
+{
+    if (m_staged.isEmpty() || !m_profiles)
+        return true;
+
+    QList<ProfileData> profiles;
+    profiles.reserve(m_staged.size());
+    for (int id : m_staged)
+        profiles.append(m_profileValues.value(id));
+    const QSet<int> staged = m_staged;
+    m_staged.clear();
+
+    if (m_profiles->updateDerivedValues(profiles))
+        return true;
+
+    // Nothing was written; forgetting the values makes the next reload take the table as is
+    const QString error = QString("Failed to write %1 recalculated profiles: %2").arg(profiles.size()).arg(m_profiles->lastError());
+    qCritical() << "RecalculationController::writeStaged() -" << error;
+    for (int id : staged)
+        m_profileValues.remove(id);
+    emit errorOccurred(error);
+    return false;
+}
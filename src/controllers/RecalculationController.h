@@ -0,0 +1,107 @@
+#ifndef RECALCULATIONCONTROLLER_H
+#define RECALCULATIONCONTROLLER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QDebug>
+#include "../core/DependencyGraph.h"
+#include "../database/models/StructureProfileTable.h"
+
+class FrameArrangementXZController;
+class LinearIsotropicMaterials;
+class StructureProfileTableController;
+
+/**
+ * Cross-table recalculation over a DependencyGraph:
+ *
+ *   material:<matNo>   -> reh:profile, reh:bracket (yield stress of the chosen materials)
+ *   profile:<id>:dims  -> profile:<id>:section (area, e, W, I)
+ *   profile:<id>:section, reh:profile, reh:bracket -> profile:<id>:brackets (l, tb, bf, tbf)
+ *   xz:spacing         -> xz:positions (frame coordinates above the re-spaced frame)
+ *
+ * Table edits are diffed against the last seen values and only the changed keys are
+ * invalidated; one recalculation then runs the dirty subgraph and writes every staged
+ * profile value in one transaction. rehProfile and rehBracket are the only ReH the profile
+ * table uses: entered directly, or the yield stress of profileMaterial / bracketMaterial
+ * while one is set (0 keeps the entered value). A new ReH resizes every profile's brackets.
+ */
+class RecalculationController : public QObject
+{
+    Q_OBJECT
+    // Material numbers whose yield stress is ReH of the profiles and of the brackets
+    Q_PROPERTY(int profileMaterial READ profileMaterial WRITE setProfileMaterial NOTIFY profileMaterialChanged)
+    Q_PROPERTY(int bracketMaterial READ bracketMaterial WRITE setBracketMaterial NOTIFY bracketMaterialChanged)
+    // ReH (N/mm2) of the profiles and of the brackets; writing one clears its material
+    Q_PROPERTY(double rehProfile READ rehProfile WRITE setRehProfile NOTIFY rehChanged)
+    Q_PROPERTY(double rehBracket READ rehBracket WRITE setRehBracket NOTIFY rehChanged)
+    Q_PROPERTY(QStringList lastRecalculated READ lastRecalculated NOTIFY recalculated)
+
+public:
+    explicit RecalculationController(QObject *parent = nullptr);
+
+    static QString materialKey(int matNo);
+    static QString spacingKey() { return QStringLiteral("xz:spacing"); }
+    static QString positionsKey() { return QStringLiteral("xz:positions"); }
+
+    int profileMaterial() const { return m_profileMaterial; }
+    int bracketMaterial() const { return m_bracketMaterial; }
+    double rehProfile() const { return m_rehProfile; }
+    double rehBracket() const { return m_rehBracket; }
+    QStringList lastRecalculated() const { return m_lastRecalculated; }
+
+    void setProfileMaterial(int matNo);
+    void setBracketMaterial(int matNo);
+    void setRehProfile(double reh);
+    void setRehBracket(double reh);
+
+    void setMaterials(LinearIsotropicMaterials *materials);
+    void setProfileController(StructureProfileTableController *profiles);
+    void setFrameController(FrameArrangementXZController *frames);
+
+    DependencyGraph &graph() { return m_graph; }
+
+    // Marks a key as edited; the recalculation runs queued, once for a burst of edits
+    void invalidate(const QString &key);
+    void scheduleRecalculation();
+
+public slots:
+    // Runs the dirty subgraph now; false when the batched write failed
+    bool recalculate();
+    void syncMaterials();
+    void syncProfiles();
+
+signals:
+    void profileMaterialChanged();
+    void bracketMaterialChanged();
+    void rehChanged();
+    void recalculated(const QStringList &nodes);
+    void errorOccurred(const QString &error);
+
+private:
+    DependencyGraph m_graph;
+    LinearIsotropicMaterials *m_materials;
+    StructureProfileTableController *m_profiles;
+    FrameArrangementXZController *m_frames;
+
+    int m_profileMaterial;
+    int m_bracketMaterial;
+    double m_rehProfile;
+    double m_rehBracket;
+    QHash<int, double> m_yield;             // by material number
+    QHash<int, ProfileData> m_profileValues; // by id, as last read or computed
+    QSet<int> m_staged;                      // profiles with computed values to write
+    QStringList m_lastRecalculated;
+    bool m_scheduled;
+
+    void addRehNode(const QString &key, int matNo, double *reh);
+    void enterReh(const QString &key, double value, double *reh);
+    void addProfileNodes(int id);
+    void removeProfileNodes(int id);
+    bool computeSection(int id);
+    bool computeBrackets(int id);
+    bool writeStaged();
+};
+
+#endif // RECALCULATIONCONTROLLER_H
@@ -0,0 +1,310 @@
+#include "StructuralWeightController.h"
+#include "StructureProfileTableController.h"
+#include "../database/models/FrameArrangementXZ.h"
+#include "../database/models/FrameArrangementYZ.h"
+#include "../database/models/HullOffsets.h"
+#include "../database/models/LinearIsotropicMaterials.h"
+#include "../database/models/PrefixMembers.h"
+#include "../database/models/PrincipalDimensions.h"
+#include "../core/ProfileFormulas.h"
+#include <QElapsedTimer>
+#include <QSet>
+
+static QVariantMap weightMap(const StructuralWeight::Weight &weight)
+{
+    QVariantMap map;
+    map["mass"] = weight.massKg / 1000.0;
+    map["lcg"] = weight.lcgM;
+    map["vcg"] = weight.vcgM;
+    return map;
+}
+
+StructuralWeightController::StructuralWeightController(QObject *parent)
+    : QObject(parent)
+    , m_plateThickness(10.0)
+    , m_defaultMaterial(1)
+    , m_frames(nullptr)
+    , m_model(nullptr)
+    , m_materials(nullptr)
+    , m_hullOffsets(nullptr)
+    , m_dimensions(nullptr)
+    , m_profiles(nullptr)
+    , m_members(nullptr)
+{
+}
+
+void StructuralWeightController::setPlateThickness(double thickness)
+{
+    if (thickness < 0.0 || m_plateThickness == thickness)
+        return;
+    m_plateThickness = thickness;
+    emit plateThicknessChanged();
+    refreshMembers();
+}
+
+void StructuralWeightController::setDefaultMaterial(int matNo)
+{
+    if (m_defaultMaterial == matNo)
+        return;
+    m_defaultMaterial = matNo;
+    emit defaultMaterialChanged();
+    refreshMembers();
+}
+
+void StructuralWeightController::setFrameModel(FrameArrangementXZ *frames)
+{
+    if (m_frames)
+        disconnect(m_frames, nullptr, this, nullptr);
+    m_frames = frames;
+    if (m_frames)
+        connect(m_frames, &FrameArrangementXZ::dataChanged, this, &StructuralWeightController::syncFrames);
+    syncFrames();
+}
+
+void StructuralWeightController::setModel(FrameArrangementYZ *model)
+{
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+    m_model = model;
+    if (m_model)
+        connect(m_model, &FrameArrangementYZ::dataChanged, this, &StructuralWeightController::syncRows);
+    syncRows();
+}
+
+void StructuralWeightController::setMaterials(LinearIsotropicMaterials *materials)
+{
+    if (m_materials)
+        disconnect(m_materials, nullptr, this, nullptr);
+    m_materials = materials;
+    if (m_materials) {
+        connect(m_materials, &LinearIsotropicMaterials::materialInserted, this, &StructuralWeightController::refreshMembers);
+        connect(m_materials, &LinearIsotropicMaterials::materialUpdated, this, &StructuralWeightController::refreshMembers);
+        connect(m_materials, &LinearIsotropicMaterials::materialDeleted, this, &StructuralWeightController::refreshMembers);
+    }
+    refreshMembers();
+}
+
+void StructuralWeightController::setHullOffsets(HullOffsets *offsets)
+{
+    if (m_hullOffsets)
+        disconnect(m_hullOffsets, nullptr, this, nullptr);
+    m_hullOffsets = offsets;
+    if (m_hullOffsets)
+        connect(m_hullOffsets, &HullOffsets::sectionsChanged, this, &StructuralWeightController::refreshBoundary);
+    refreshBoundary();
+}
+
+void StructuralWeightController::setPrincipalDimensions(PrincipalDimensions *dimensions)
+{
+    if (m_dimensions)
+        disconnect(m_dimensions, nullptr, this, nullptr);
+    m_dimensions = dimensions;
+    if (m_dimensions)
+        connect(m_dimensions, &PrincipalDimensions::dimensionsChanged, this, &StructuralWeightController::refreshBoundary);
+    refreshBoundary();
+}
+
+void StructuralWeightController::setProfileController(StructureProfileTableController *profiles)
+{
+    if (m_profiles)
+        disconnect(m_profiles, nullptr, this, nullptr);
+    m_profiles = profiles;
+    if (m_profiles)
+        connect(m_profiles, &StructureProfileTableController::profilesDataChanged, this, &StructuralWeightController::refreshMembers);
+    refreshMembers();
+}
+
+void StructuralWeightController::setPrefixMembers(PrefixMembers *members)
+{
+    if (m_members)
+        disconnect(m_members, nullptr, this, nullptr);
+    m_members = members;
+    if (m_members)
+        connect(m_members, &PrefixMembers::membersChanged, this, &StructuralWeightController::refreshMembers);
+    refreshMembers();
+}
+
+bool StructuralWeightController::assignMember(const QString &prefix, const QString &profileName, int matNo, double plateThickness,
+                                              const QString &placement)
+{
+    if (!m_members) {
+        qCritical() << "StructuralWeightController::assignMember() - Prefix members not set";
+        emit errorOccurred("Prefix members not set");
+        return false;
+    }
+    if (prefix.isEmpty() || plateThickness < 0.0) {
+        emit errorOccurred("A prefix and a non-negative plate thickness are required");
+        return false;
+    }
+
+    // Saving emits membersChanged, which refreshes the weights
+    PrefixMembers::Member member = m_members->member(prefix);
+    member.profileName = profileName;
+    member.matNo = matNo;
+    member.plateThickness = plateThickness;
+    member.placement = PrefixMembers::placementFromString(placement);
+    if (!m_members->setMember(member)) {
+        emit errorOccurred(m_members->lastError());
+        return false;
+    }
+    return true;
+}
+
+void StructuralWeightController::clearAssignment(const QString &prefix)
+{
+    if (m_members && !m_members->removeMember(prefix))
+        emit errorOccurred(m_members->lastError());
+}
+
+QVariantList StructuralWeightController::assignments() const
+{
+    return m_members ? m_members->memberList() : QVariantList();
+}
+
+void StructuralWeightController::syncFrames()
+{
+    if (!m_frames)
+        return;
+
+    QVector<StructuralWeight::Bay> bays;
+    bays.reserve(m_frames->frames().size());
+    for (const FrameArrangementXZ::FrameData &frame : m_frames->frames())
+        bays.append({ frame.frameNumber, frame.xpCoor, double(frame.frameSpacing) });
+    m_weight.setBays(bays);
+    recompute();
+}
+
+void StructuralWeightController::syncRows()
+{
+    if (!m_model)
+        return;
+
+    // Only rows that differ from the last sync are staged
+    QSet<int> seen;
+    int staged = 0;
+    for (const FrameArrangementYZ::FrameYZData &frame : m_model->allFrames()) {
+        if (m_weight.setRow(frame.frameNo, frame.id, FrameArrangementYZ::geometryRow(frame)))
+            ++staged;
+        seen.insert(frame.id);
+    }
+    for (int id : m_weight.rowIds()) {
+        if (!seen.contains(id) && m_weight.removeRow(id))
+            ++staged;
+    }
+    if (staged == 0)
+        return;
+
+    // Sections that just appeared need their hull section
+    refreshBoundary();
+}
+
+double StructuralWeightController::densityOf(int matNo)
+{
+    if (!m_materials)
+        return 0.0;
+    const MaterialData material = m_materials->findMaterialByMatNo(matNo);
+    if (material.density <= 0) {
+        const QString error = QString("Material %1 not found").arg(matNo);
+        qWarning() << "StructuralWeightController::densityOf() -" << error;
+        emit errorOccurred(error);
+        return 0.0;
+    }
+    return material.density;
+}
+
+void StructuralWeightController::refreshMembers()
+{
+    QHash<int, double> densities;
+    auto density = [&](int matNo) {
+        if (!densities.contains(matNo))
+            densities.insert(matNo, densityOf(matNo));
+        return densities.value(matNo);
+    };
+
+    StructuralWeight::Member plating;
+    plating.section.plateThicknessMM = m_plateThickness;
+    plating.densityKgM3 = density(m_defaultMaterial);
+
+    QHash<QString, StructuralWeight::Member> members;
+    const QHash<QString, PrefixMembers::Member> assigned = m_members ? m_members->members() : QHash<QString, PrefixMembers::Member>();
+    for (auto it = assigned.constBegin(); it != assigned.constEnd(); ++it) {
+        StructuralWeight::Member member;
+        member.section.plateThicknessMM = it.value().plateThickness;
+        member.section.placement = it.value().placement;
+        member.densityKgM3 = density(it.value().matNo > 0 ? it.value().matNo : m_defaultMaterial);
+        if (m_profiles && !it.value().profileName.isEmpty()) {
+            const QVariantMap profile = m_profiles->getProfileByName(it.value().profileName);
+            if (profile.isEmpty()) {
+                const QString error = QString("Profile %1 of prefix %2 not found").arg(it.value().profileName, it.key());
+                qWarning() << "StructuralWeightController::refreshMembers() -" << error;
+                emit errorOccurred(error);
+            } else {
+                member.section.areaCm2 = profile.value("area").toDouble();
+                member.section.eMM = profile.value("e").toDouble();
+                member.section.inertiaCm4 = ProfileFormulas::profileInertia(profile.value("hw").toDouble(), profile.value("tw").toDouble(),
+                                                                            profile.value("bfProfiles").toDouble(), profile.value("tf").toDouble());
+            }
+        }
+        members.insert(it.key(), member);
+    }
+
+    m_weight.setMembers(members, plating);
+    recompute();
+}
+
+void StructuralWeightController::refreshBoundary()
+{
+    double halfWidthMM = 24384.0 / 2.0;
+    double depthMM = 5490.0;
+    if (m_dimensions) {
+        if (m_dimensions->breadth() > 0.0)
+            halfWidthMM = m_dimensions->breadth() * 1000.0 / 2.0;
+        if (m_dimensions->depth() > 0.0)
+            depthMM = m_dimensions->depth() * 1000.0;
+    }
+    m_weight.setOutline(halfWidthMM, depthMM);
+
+    // Polygons come from the (single-threaded) section cache before the parallel update
+    for (int frameNo : m_weight.sectionFrames())
+        m_weight.setHullPolygon(frameNo, m_hullOffsets ? m_hullOffsets->sections().polygon(frameNo) : QVector<QPointF>());
+    recompute();
+}
+
+void StructuralWeightController::recompute()
+{
+    QElapsedTimer timer;
+    timer.start();
+    m_weight.resetExpandedRows();
+    m_weight.update();
+
+    const StructuralWeight::Result &r = m_weight.result();
+    qDebug() << "StructuralWeightController::recompute() -" << m_weight.expandedRows() << "rows expanded,"
+             << r.zones.size() << "zones," << r.total.massKg / 1000.0 << "t in" << timer.elapsed() << "ms";
+    emit resultChanged();
+}
+
+QVariantMap StructuralWeightController::result() const
+{
+    const StructuralWeight::Result &r = m_weight.result();
+    QVariantMap map = weightMap(r.total);
+
+    QVariantList prefixes;
+    for (auto it = r.byPrefix.constBegin(); it != r.byPrefix.constEnd(); ++it) {
+        QVariantMap entry = weightMap(it.value());
+        entry["prefix"] = it.key();
+        prefixes.append(entry);
+    }
+    map["prefixes"] = prefixes;
+
+    QVariantList zones;
+    for (const StructuralWeight::Zone &zone : r.zones) {
+        QVariantMap entry = weightMap(zone.total);
+        entry["frameNo"] = zone.sectionFrame;
+        entry["firstFrame"] = zone.firstFrame;
+        entry["lastFrame"] = zone.lastFrame;
+        entry["length"] = zone.lengthM;
+        zones.append(entry);
+    }
+    map["zones"] = zones;
+    return map;
+}
@@ -0,0 +1,94 @@
+#ifndef STRUCTURALWEIGHTCONTROLLER_H
+#define STRUCTURALWEIGHTCONTROLLER_H
+
+#include <QObject>
+#include <QHash>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QDebug>
+#include "../core/StructuralWeight.h"
+
+class FrameArrangementXZ;
+class FrameArrangementYZ;
+class HullOffsets;
+class LinearIsotropicMaterials;
+class PrefixMembers;
+class PrincipalDimensions;
+class StructureProfileTableController;
+
+/**
+ * Steel weight and centre of gravity of the longitudinals, per frame zone and per prefix.
+ *
+ * Only the YZ longitudinals and their row-spacing plate strips are weighed (see
+ * HullGirderSection): transverse frames, brackets and shell or deck plating outside the
+ * rows are not part of the result.
+ *
+ * Each prefix's member in the ship database (PrefixMembers) gives a library profile, a
+ * material (by material number, 0 = defaultMaterial) and a plating thickness; prefixes
+ * without one get plating of plateThickness in defaultMaterial. A change
+ * of one YZ row, profile, material or the XZ frames only recomputes what depends on it.
+ * result holds mass (t), lcg (m from the AP) and vcg (m above base) of the whole, plus
+ * prefixes [{prefix, mass, lcg, vcg}] and zones [{frameNo, firstFrame, lastFrame, length,
+ * mass, lcg, vcg}].
+ */
+class StructuralWeightController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double plateThickness READ plateThickness WRITE setPlateThickness NOTIFY plateThicknessChanged)
+    Q_PROPERTY(int defaultMaterial READ defaultMaterial WRITE setDefaultMaterial NOTIFY defaultMaterialChanged)
+    Q_PROPERTY(QVariantMap result READ result NOTIFY resultChanged)
+
+public:
+    explicit StructuralWeightController(QObject *parent = nullptr);
+
+    double plateThickness() const { return m_plateThickness; }
+    int defaultMaterial() const { return m_defaultMaterial; }
+    QVariantMap result() const;
+
+    void setPlateThickness(double thickness);
+    void setDefaultMaterial(int matNo);
+
+    void setFrameModel(FrameArrangementXZ *frames);
+    void setModel(FrameArrangementYZ *model);
+    void setMaterials(LinearIsotropicMaterials *materials);
+    void setHullOffsets(HullOffsets *offsets);
+    void setPrincipalDimensions(PrincipalDimensions *dimensions);
+    void setProfileController(StructureProfileTableController *profiles);
+    void setPrefixMembers(PrefixMembers *members);
+
+    // Saved in the ship database; placement "deck" puts the prefix's vertical lines under the deck, anything else on the bottom
+    Q_INVOKABLE bool assignMember(const QString &prefix, const QString &profileName, int matNo, double plateThickness,
+                                  const QString &placement = QString());
+    Q_INVOKABLE void clearAssignment(const QString &prefix);
+    Q_INVOKABLE QVariantList assignments() const;
+
+public slots:
+    void syncFrames();
+    void syncRows();
+    void refreshMembers();
+    void refreshBoundary();
+
+signals:
+    void plateThicknessChanged();
+    void defaultMaterialChanged();
+    void resultChanged();
+    void errorOccurred(const QString &error);
+
+private:
+    double m_plateThickness;
+    int m_defaultMaterial;
+    StructuralWeight m_weight;
+
+    FrameArrangementXZ *m_frames;
+    FrameArrangementYZ *m_model;
+    LinearIsotropicMaterials *m_materials;
+    HullOffsets *m_hullOffsets;
+    PrincipalDimensions *m_dimensions;
+    StructureProfileTableController *m_profiles;
+    PrefixMembers *m_members;
+
+    double densityOf(int matNo);
+    void recompute();
+};
+
+#endif // STRUCTURALWEIGHTCONTROLLER_H
@@ -1,4 +1,5 @@
 #include "StructureProfileTableController.h"
+#include "../core/ProfileFormulas.h"
 #include <QDebug>
 #include <QRegularExpression>
 #include <cmath>
@@ -7,6 +8,8 @@
 StructureProfileTableController::StructureProfileTableController(QObject *parent)
     : QObject(parent)
     , m_model(nullptr)
+    , m_sectionCache(512)
+    , m_bracketCache(512)
     , m_isLoading(false)
     , m_lastInsertedId(0)
 {
@@ -544,102 +547,25 @@ bool StructureProfileTableController::isValidProfileData(const QString& type, co
     return true;
 }
 
-// Calculation functions
+// Calculation functions (formulas live in src/core/ProfileFormulas so dewaruci-cli can share them)
 QVariantList StructureProfileTableController::countingFormula(double hw, double tw, double bf, double tf, const QString& type)
 {
-    double hw_cm = hw / 10.0;
-    double tw_cm = tw / 10.0;
-    double bf_cm = bf / 10.0;
-    double tf_cm = tf / 10.0;
-    double attch_plate_cm = tw / 10.0;
-    double AttchX = 40.0 * attch_plate_cm;
-
-    // Count area
-    double FaceX = bf_cm;
-    double WebX = tw_cm;
-    
-    double FaceY = tf_cm;
-    double WebY = hw_cm - tf_cm;
-    
-    double AttchY = tw / 10.0;
-    double FaceZ = (0.5 * FaceY) + WebY;
-    double WebZ = 0.5 * WebY;
-    double FaceZ2 = (0.5 * FaceY) + WebY + AttchY;
-    double WebZ2 = 0.5 * WebY + AttchY;
-    
-    double AttchZ = 0.5 * AttchY;
-    double FaceA = FaceX * FaceY;
-    double FaceAZ = FaceA * FaceZ;
-    double FaceAZ2 = FaceA * FaceZ2;
-    double FaceAzZ = FaceAZ2 * FaceZ2;
-    double FaceI = (FaceX * pow(FaceY, 3.0)) / 12.0;
-    
-    double WebA = WebX * WebY;
-    double WebAZ = WebA * WebZ;
-    double WebAZ2 = WebA * WebZ2;
-    double WebAzZ = WebAZ2 * WebZ2;
-    
-    double WebI = (WebX * pow(WebY, 3.0)) / 12.0;
-    double AttchA = AttchX * AttchY;
-    double AttchAZ = AttchA * AttchZ;
-    double AttchAzZ = AttchAZ * AttchZ;
-    double AttchI = (AttchX * pow(AttchY, 3.0)) / 12.0;
-
-    // Final area
-    double area = FaceA + WebA;
-
-    // Count e
-    double z1 = 10.0 * (FaceAZ + WebAZ) / (FaceA + WebA);
-
-    // Final e
-    double e = z1;
-
-    // Count upper_i
-    double z12 = (FaceAZ2 + WebAZ2 + AttchAZ) / (FaceA + WebA + AttchA);
-    double z2 = hw_cm + attch_plate_cm - z12;
-    double sigmaAzz = FaceAzZ + WebAzZ + AttchAzZ;
-    double sigmaUpperI = FaceI + WebI + AttchI;
-    double sigmaA = FaceA + WebA + AttchA;
-    double inertia_section = (sigmaAzz + sigmaUpperI) - (sigmaA * pow(z12, 2.0));
-
-    // Final upper_i
-    double upper_i = inertia_section;
-
-    // Count moduli actual
-    double moduli_actual;
-    if (type == "HP") {
-        moduli_actual = 2.1445 * std::min(inertia_section / z12, inertia_section / z2);
-    } else {
-        moduli_actual = std::min(inertia_section / z12, inertia_section / z2);
+    // NaN never equals itself, so such inputs would only fill the cache
+    const SectionKey key { hw, tw, bf, tf, type };
+    const bool cacheable = std::isfinite(hw) && std::isfinite(tw) && std::isfinite(bf) && std::isfinite(tf);
+    if (cacheable) {
+        if (const QVariantList *cached = m_sectionCache.find(key))
+            return *cached;
     }
 
-    // Count moduli ksp
-    double moduli_ksp;
-    if (type == "Bar" || type == "T" || type == "FB") {
-        moduli_ksp = moduli_actual / 1.0;
-    } else if (type == "HP") {
-        moduli_ksp = moduli_actual / 1.03;
-    } else if (type == "L") {
-        moduli_ksp = moduli_actual / 1.15;
-    } else {
-        moduli_ksp = 0.0;
-    }
+    const ProfileFormulas::SectionProperties section = ProfileFormulas::sectionProperties(hw, tw, bf, tf, type);
+
+    qDebug() << "counting_formula (rounded)" << section.area << section.e << section.w << section.upperI;
 
-    // Final w
-    double w = moduli_ksp;
-    
-    qDebug() << "counting_formula" << area << e << w << upper_i;
-    
-    // Round all results to 2 decimal places for consistency
-    area = std::round(area * 100.0) / 100.0;
-    e = std::round(e * 100.0) / 100.0;
-    w = std::round(w * 100.0) / 100.0;
-    upper_i = std::round(upper_i * 100.0) / 100.0;
-    
-    qDebug() << "counting_formula (rounded)" << area << e << w << upper_i;
-    
     QVariantList result;
-    result << area << e << w << upper_i;
+    result << section.area << section.e << section.w << section.upperI;
+    if (cacheable)
+        m_sectionCache.insert(key, result);
     return result;
 }
 
@@ -647,312 +573,86 @@ QVariantList StructureProfileTableController::countingFormulaEdit(double hw, dou
                                                                  double area, double e, double w, double upperI, 
                                                                  const QString& type)
 {
-    double hw_cm = hw / 10.0;
-    double tw_cm = tw / 10.0;
-    double bf_cm = bf / 10.0;
-    double tf_cm = tf / 10.0;
-    double attch_plate_cm = tw / 10.0;
-    double AttchX = 40.0 * attch_plate_cm;
-    
-    // Count area
-    double FaceX = bf_cm;
-    double WebX = tw_cm;
-    
-    double FaceY = tf_cm;
-    double WebY = hw_cm - tf_cm;
-    
-    double AttchY = tw / 10.0;
-    double FaceZ = (0.5 * FaceY) + WebY;
-    double WebZ = 0.5 * WebY;
-    double FaceZ2 = (0.5 * FaceY) + WebY + AttchY;
-    double WebZ2 = 0.5 * WebY + AttchY;
-    
-    double AttchZ = 0.5 * AttchY;
-    double FaceA = FaceX * FaceY;
-    double FaceAZ = FaceA * FaceZ;
-    double FaceAZ2 = FaceA * FaceZ2;
-    double FaceAzZ = FaceAZ2 * FaceZ2;
-    double FaceI = (FaceX * pow(FaceY, 3.0)) / 12.0;
-    
-    double WebA = WebX * WebY;
-    double WebAZ = WebA * WebZ;
-    double WebAZ2 = WebA * WebZ2;
-    double WebAzZ = WebAZ2 * WebZ2;
-    
-    double WebI = (WebX * pow(WebY, 3.0)) / 12.0;
-    double AttchA = AttchX * AttchY;
-    double AttchAZ = AttchA * AttchZ;
-    double AttchAzZ = AttchAZ * AttchZ;
-    double AttchI = (AttchX * pow(AttchY, 3.0)) / 12.0;
-
-    // Use existing area or calculate new one
-    double final_area;
-    if (area == 0.0) {
-        final_area = FaceA + WebA;
-    } else {
-        final_area = area;
-    }
-
-    // Count e
-    double z1 = 10.0 * (FaceAZ + WebAZ) / (FaceA + WebA);
-
-    // Use existing e or calculate new one
-    double final_e;
-    if (e == 0.0) {
-        final_e = z1;
-    } else {
-        final_e = e;
-    }
-
-    // Count upper_i
-    double z12 = (FaceAZ2 + WebAZ2 + AttchAZ) / (FaceA + WebA + AttchA);
-    double z2 = hw_cm + attch_plate_cm - z12;
-    double sigmaAzz = FaceAzZ + WebAzZ + AttchAzZ;
-    double sigmaUpperI = FaceI + WebI + AttchI;
-    double sigmaA = FaceA + WebA + AttchA;
-    double inertia_section = (sigmaAzz + sigmaUpperI) - (sigmaA * pow(z12, 2.0));
-
-    // Use existing upper_i or calculate new one
-    double final_upperI;
-    if (upperI == 0.0) {
-        final_upperI = inertia_section;
-    } else {
-        final_upperI = upperI;
-    }
-
-    // Count moduli actual
-    double moduli_actual;
-    if (type == "HP") {
-        moduli_actual = 2.1445 * std::min(inertia_section / z12, inertia_section / z2);
-    } else {
-        moduli_actual = std::min(inertia_section / z12, inertia_section / z2);
-    }
+    ProfileFormulas::SectionProperties existing;
+    existing.area = area;
+    existing.e = e;
+    existing.w = w;
+    existing.upperI = upperI;
+    const ProfileFormulas::SectionProperties section = ProfileFormulas::sectionPropertiesEdit(hw, tw, bf, tf, existing, type);
 
-    // Count moduli ksp
-    double moduli_ksp;
-    if (type == "Bar" || type == "T" || type == "FB") {
-        moduli_ksp = moduli_actual / 1.0;
-    } else if (type == "HP") {
-        moduli_ksp = moduli_actual / 1.03;
-    } else if (type == "L") {
-        moduli_ksp = moduli_actual / 1.15;
-    } else {
-        moduli_ksp = 0.0;
-    }
+    qDebug() << "counting_formula_edit (rounded)" << section.area << section.e << section.w << section.upperI;
 
-    // Use existing w or calculate new one
-    double final_w;
-    if (w == 0.0) {
-        final_w = moduli_ksp;
-    } else {
-        final_w = w;
-    }
-    
-    qDebug() << "counting_formula_edit" << final_area << final_e << final_w << final_upperI;
-    
-    // Round all results to 2 decimal places for consistency
-    final_area = std::round(final_area * 100.0) / 100.0;
-    final_e = std::round(final_e * 100.0) / 100.0;
-    final_w = std::round(final_w * 100.0) / 100.0;
-    final_upperI = std::round(final_upperI * 100.0) / 100.0;
-    
-    qDebug() << "counting_formula_edit (rounded)" << final_area << final_e << final_w << final_upperI;
-    
     QVariantList result;
-    result << final_area << final_e << final_w << final_upperI;
+    result << section.area << section.e << section.w << section.upperI;
     return result;
 }
 
 // Bracket calculation functions
 QVariantList StructureProfileTableController::profileTableCountingFormulaBrackets(double tw, double W, double rehProfile, double rehBracket)
 {
-    // Convert inputs to double to match Python behavior
-    double Reh_profile = static_cast<double>(rehProfile);
-    double Reh_bracket = static_cast<double>(rehBracket);
-    double W_val = static_cast<double>(W);
-    double tw_val = static_cast<double>(tw);
-    
-    // Coefficients
-    double k1 = 235.0 / Reh_profile;
-    double k2 = 235.0 / Reh_bracket;
-    double c = 1.2;
-    double ct = 1.0;
-    
-    double tmax = tw_val;
-    double bmin = 50.0;
-    double bmax = 90.0;
-
-    // t bracket, tb=tbf
-    double tnet = c * pow(W_val / (double)k1, 1.0/3.0);
-    
-    // tk = Piecewise((1.5,tnet<10),((Min(3,0.1*tnet/sqrt(k1))),True))
-    double tk;
-    if (tnet < 10.0) {
-        tk = 1.5;
-    } else {
-        tk = std::min(3.0, 0.1 * tnet / sqrt(k1));
-    }
-    
-    double tmin = 5.0 + tk;
-    double a = tnet + tk;
-    double tfull = ceil(a * 10.0) / 10.0;
-
-    // Output t yang diambil - t = Piecewise((tmin, tfull < tmin), (tmax, tfull > tmax), (tfull, True))
-    double t;
-    if (tfull < tmin) {
-        t = tmin;
-    } else if (tfull > tmax) {
-        t = tmax;
-    } else {
-        t = tfull;
+    const BracketKey key { tw, W, rehProfile, rehBracket };
+    const bool cacheable = std::isfinite(tw) && std::isfinite(W) && std::isfinite(rehProfile) && std::isfinite(rehBracket);
+    if (cacheable) {
+        if (const QVariantList *cached = m_bracketCache.find(key))
+            return *cached;
     }
-    
-    double tb = t;
-    double tbf = t;
-
-    // l bracket
-    double lreq = 46.2 * pow(W_val / (double)k1, 1.0/3.0) * sqrt(k2) * ct;
 
-    // Output l bracket yang diambil - l = ceiling(lreq)
-    double l = ceil(lreq);
+    const ProfileFormulas::BracketSizes brackets = ProfileFormulas::bracketSizes(tw, W, rehProfile, rehBracket);
 
-    // bf bracket
-    double breq = 40.0 + W_val / 30.0;
+    qDebug() << "profile_table_counting_formula_brackets (rounded)" << brackets.l << brackets.tb << brackets.bf << brackets.tbf;
 
-    // Output bf yang diambil - bf = Piecewise((bmin,breq<bmin),(bmax,breq>bmax),(breq,True))
-    double bf;
-    if (breq < bmin) {
-        bf = bmin;
-    } else if (breq > bmax) {
-        bf = bmax;
-    } else {
-        bf = breq;
-    }
-    
-    // Convert to float to match Python behavior
-    double l_result = static_cast<double>(l);
-    double tb_result = static_cast<double>(tb);
-    double bf_result = static_cast<double>(bf);
-    double tbf_result = static_cast<double>(tbf);
-    
-    qDebug() << "profile_table_counting_formula_brackets" << l_result << tb_result << bf_result << tbf_result;
-    
-    // Round all results to 2 decimal places for consistency
-    l_result = std::round(l_result * 100.0) / 100.0;
-    tb_result = std::round(tb_result * 100.0) / 100.0;
-    bf_result = std::round(bf_result * 100.0) / 100.0;
-    tbf_result = std::round(tbf_result * 100.0) / 100.0;
-    
-    qDebug() << "profile_table_counting_formula_brackets (rounded)" << l_result << tb_result << bf_result << tbf_result;
-    
     QVariantList result;
-    result << l_result << tb_result << bf_result << tbf_result;
+    result << brackets.l << brackets.tb << brackets.bf << brackets.tbf;
+    if (cacheable)
+        m_bracketCache.insert(key, result);
     return result;
 }
 
 QVariantList StructureProfileTableController::profileTableCountingFormulaBracketsEdit(double tw, double W, double rehProfile, double rehBracket,
                                                                                      double l, double tb, double bf, double tbf)
 {
-    // Convert inputs to double to match Python behavior
-    double Reh_profile = static_cast<double>(rehProfile);
-    double Reh_bracket = static_cast<double>(rehBracket);
-    double W_val = static_cast<double>(W);
-    double tw_val = static_cast<double>(tw);
-    
-    // Coefficients
-    double k1 = 235.0 / Reh_profile;
-    double k2 = 235.0 / Reh_bracket;
-    double c = 1.2;
-    double ct = 1.0;
-    
-    double tmax = tw_val;
-    double bmin = 50.0;
-    double bmax = 90.0;
-
-    // t bracket, tb=tbf
-    double tnet = c * pow(W_val / k1, 1.0/3.0);
-    
-    // tk = Piecewise((1.5,tnet<10),((Min(3,0.1*tnet/sqrt(k1))),True))
-    double tk;
-    if (tnet < 10.0) {
-        tk = 1.5;
-    } else {
-        tk = std::min(3.0, 0.1 * tnet / sqrt(k1));
-    }
-    
-    double tmin = 5.0 + tk;
-    double a = tnet + tk;
-    double tfull = ceil(a * 10.0) / 10.0;
+    ProfileFormulas::BracketSizes existing;
+    existing.l = l;
+    existing.tb = tb;
+    existing.bf = bf;
+    existing.tbf = tbf;
+    const ProfileFormulas::BracketSizes brackets = ProfileFormulas::bracketSizesEdit(tw, W, rehProfile, rehBracket, existing);
 
-    // Output t yang diambil - t = Piecewise((tmin, tfull < tmin), (tmax, tfull > tmax), (tfull, True))
-    double t;
-    if (tfull < tmin) {
-        t = tmin;
-    } else if (tfull > tmax) {
-        t = tmax;
-    } else {
-        t = tfull;
-    }
-    
-    // Use existing tb or calculated value
-    double final_tb;
-    if (tb == 0.0) {
-        final_tb = t;
-    } else {
-        final_tb = tb;
-    }
-    
-    // Use existing tbf or calculated value
-    double final_tbf;
-    if (tbf == 0.0) {
-        final_tbf = t;
-    } else {
-        final_tbf = tbf;
-    }
+    qDebug() << "profile_table_counting_formula_brackets_edit (rounded)" << brackets.l << brackets.tb << brackets.bf << brackets.tbf;
 
-    // l bracket
-    double lreq = 46.2 * pow(W_val / k1, 1.0/3.0) * sqrt(k2) * ct;
+    QVariantList result;
+    result << brackets.l << brackets.tb << brackets.bf << brackets.tbf;
+    return result;
+}
 
-    // Output l bracket yang diambil - l = ceiling(lreq)
-    double final_l;
-    if (l == 0.0) {
-        final_l = ceil(lreq);
-    } else {
-        final_l = l;
-    }
+QVariantMap StructureProfileTableController::formulaCacheStats() const
+{
+    auto stats = [](auto &cache) {
+        QVariantMap map;
+        map["hits"] = cache.hits();
+        map["misses"] = cache.misses();
+        map["hitRate"] = cache.hitRate();
+        map["size"] = cache.size();
+        map["capacity"] = cache.capacity();
+        return map;
+    };
 
-    // bf bracket
-    double breq = 40.0 + W_val / 30.0;
-
-    // Output bf yang diambil - bf = Piecewise((bmin,breq<bmin),(bmax,breq>bmax),(breq,True))
-    double final_bf;
-    if (bf == 0.0) {
-        if (breq < bmin) {
-            final_bf = bmin;
-        } else if (breq > bmax) {
-            final_bf = bmax;
-        } else {
-            final_bf = breq;
-        }
-    } else {
-        final_bf = bf;
-    }
-    
-    qDebug() << "profile_table_counting_formula_brackets_edit" << final_l << final_tb << final_bf << final_tbf;
-    
-    // Round all results to 2 decimal places for consistency
-    final_l = std::round(final_l * 100.0) / 100.0;
-    final_tb = std::round(final_tb * 100.0) / 100.0;
-    final_bf = std::round(final_bf * 100.0) / 100.0;
-    final_tbf = std::round(final_tbf * 100.0) / 100.0;
-    
-    qDebug() << "profile_table_counting_formula_brackets_edit (rounded)" << final_l << final_tb << final_bf << final_tbf;
-    
-    QVariantList result;
-    result << final_l << final_tb << final_bf << final_tbf;
+    QVariantMap result;
+    result["section"] = stats(m_sectionCache);
+    result["brackets"] = stats(m_bracketCache);
     return result;
 }
 
+void StructureProfileTableController::clearFormulaCache()
+{
+    qDebug() << "StructureProfileTableController::clearFormulaCache() - section hit rate" << m_sectionCache.hitRate()
+             << ", bracket hit rate" << m_bracketCache.hitRate();
+    m_sectionCache.clear();
+    m_sectionCache.resetCounters();
+    m_bracketCache.clear();
+    m_bracketCache.resetCounters();
+}
+
 // Data management functions implementation
 QVariantList StructureProfileTableController::getProfilesData() const
 {
@@ -1001,3 +701,24 @@ QString StructureProfileTableController::getLastError() const
 {
     return lastError();
 }
+
+QList<ProfileData> StructureProfileTableController::allProfiles()
+{
+    return m_model->getAllProfiles();
+}
+
+bool StructureProfileTableController::updateDerivedValues(const QList<ProfileData>& profiles)
+{
+    if (profiles.isEmpty())
+        return true;
+
+    setLastError("");
+    if (!m_model->updateDerivedBatch(profiles)) {
+        setLastError(m_model->getLastError());
+        return false;
+    }
+
+    // One reload for the whole batch instead of one per row
+    refreshProfiles();
+    return true;
+}
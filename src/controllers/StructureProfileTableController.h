@@ -5,6 +5,7 @@
 #include <QVariantList>
 #include <QVariantMap>
 #include "../database/models/StructureProfileTable.h"
+#include "../core/LruCache.h"
 
 class StructureProfileTableController : public QObject
 {
@@ -73,6 +74,11 @@ public:
     Q_INVOKABLE QVariantList profileTableCountingFormulaBrackets(double tw, double W, double rehProfile, double rehBracket);
     Q_INVOKABLE QVariantList profileTableCountingFormulaBracketsEdit(double tw, double W, double rehProfile, double rehBracket,
                                                                      double l, double tb, double bf, double tbf);
+
+    // countingFormula / profileTableCountingFormulaBrackets results are memoised per exact
+    // input tuple, shared by the add and edit dialogs; hits, misses, hitRate and size per cache
+    Q_INVOKABLE QVariantMap formulaCacheStats() const;
+    Q_INVOKABLE void clearFormulaCache();
     
     // Data management functions (similar to LinearIsotropicMaterials)
     Q_INVOKABLE QVariantList getAllProfilesData();
@@ -85,6 +91,10 @@ public:
     Q_INVOKABLE bool removeProfileData(int id);
     Q_INVOKABLE QString getLastError() const;
 
+    // C++ side of the recalculation graph: every row, and one batched write of derived values
+    QList<ProfileData> allProfiles();
+    bool updateDerivedValues(const QList<ProfileData>& profiles);
+
 public slots:
     void initialize();
 
@@ -106,7 +116,25 @@ private slots:
     void onModelError(const QString& error);
 
 private:
+    struct SectionKey {
+        double hw, tw, bf, tf;
+        QString type;
+        bool operator==(const SectionKey &o) const {
+            return hw == o.hw && tw == o.tw && bf == o.bf && tf == o.tf && type == o.type;
+        }
+        friend size_t qHash(const SectionKey &k, size_t seed = 0) { return qHashMulti(seed, k.hw, k.tw, k.bf, k.tf, k.type); }
+    };
+    struct BracketKey {
+        double tw, w, rehProfile, rehBracket;
+        bool operator==(const BracketKey &o) const {
+            return tw == o.tw && w == o.w && rehProfile == o.rehProfile && rehBracket == o.rehBracket;
+        }
+        friend size_t qHash(const BracketKey &k, size_t seed = 0) { return qHashMulti(seed, k.tw, k.w, k.rehProfile, k.rehBracket); }
+    };
+
     StructureProfileTable* m_model;
+    LruCache<SectionKey, QVariantList> m_sectionCache;
+    LruCache<BracketKey, QVariantList> m_bracketCache;
     QVariantList m_profiles;
     QString m_lastError;
     bool m_isLoading;
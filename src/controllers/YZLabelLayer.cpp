@@ -0,0 +1,150 @@
+#include "YZLabelLayer.h"
+#include <QTransform>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Item pixels between a label and the view edge or the centerline, and between labels
+static const double kLabelPadding = 4.0;
+static const double kLabelGap = 2.0;
+
+YZLabelLayer::YZLabelLayer()
+    : m_layoutZoom(-1)
+{
+    m_font.setPixelSize(10);
+}
+
+void YZLabelLayer::setScene(const YZSceneRenderer::Scene &scene)
+{
+    // Keep the prepared texts of names that still exist, lay out only new ones
+    const QHash<QString, QStaticText> previous = m_texts;
+    m_texts.clear();
+    m_horizontal.clear();
+    m_vertical.clear();
+    m_layoutZoom = -1;
+
+    const YZLineGeometry &geometry = scene.geometry;
+    for (int g = 0; g < geometry.groups().size(); ++g) {
+        const auto &group = geometry.groups().at(g);
+        for (int i = group.begin; i < group.end; ++i) {
+            const QString name = geometry.lineName(i);
+            QStaticText text = m_texts.value(name, previous.value(name));
+            if (text.text().isEmpty()) {
+                text.setText(name);
+                text.setTextFormat(Qt::PlainText);
+                text.setPerformanceHint(QStaticText::AggressiveCaching);
+                text.prepare(QTransform(), m_font);
+            }
+            m_texts.insert(name, text);
+
+            Entry entry;
+            entry.line = i;
+            entry.group = g;
+            entry.sides = geometry.sides().at(i);
+            entry.text = text;
+            entry.size = text.size();
+            const double pos = geometry.positions().at(i);
+            if (geometry.axes().at(i) == YZLineGeometry::Horizontal) {
+                entry.coord = pos;
+                m_horizontal.append(entry);
+            } else {
+                // One label per drawn half of a P+S line
+                if (entry.sides & YZLineGeometry::Starboard) {
+                    entry.coord = std::fabs(pos);
+                    m_vertical.append(entry);
+                }
+                if (entry.sides & YZLineGeometry::Port) {
+                    entry.coord = -std::fabs(pos);
+                    m_vertical.append(entry);
+                }
+            }
+        }
+    }
+
+    auto byCoord = [](const Entry &a, const Entry &b) { return a.coord < b.coord; };
+    std::stable_sort(m_horizontal.begin(), m_horizontal.end(), byCoord);
+    std::stable_sort(m_vertical.begin(), m_vertical.end(), byCoord);
+}
+
+void YZLabelLayer::layout(const YZSceneRenderer::Scene &scene, double pxPerMM)
+{
+    m_keptHorizontal.clear();
+    m_keptVertical.clear();
+
+    // Prefixes drawn as LOD bands at this zoom get no line labels
+    const double thresholdMM = YZSceneRenderer::lodThresholdMM(scene, pxPerMM);
+    QVector<bool> dense(scene.geometry.groups().size());
+    for (int g = 0; g < dense.size(); ++g)
+        dense[g] = YZSceneRenderer::isGroupDense(scene, g, thresholdMM);
+
+    // Greedy along the coordinate: keep a label unless it overlaps the last kept one
+    auto keep = [&](const QVector<Entry> &entries, bool horizontal, QVector<int> &kept) {
+        double lastEnd = -std::numeric_limits<double>::infinity();
+        for (int i = 0; i < entries.size(); ++i) {
+            const Entry &entry = entries.at(i);
+            if (dense.at(entry.group)) continue;
+            const double center = entry.coord * pxPerMM;
+            const double half = (horizontal ? entry.size.height() : entry.size.width()) / 2.0;
+            if (center - half < lastEnd + kLabelGap) continue;
+            kept.append(i);
+            lastEnd = center + half;
+        }
+    };
+    keep(m_horizontal, true, m_keptHorizontal);
+    keep(m_vertical, false, m_keptVertical);
+
+    m_layoutZoom = qRound64(pxPerMM * 1e6);
+}
+
+void YZLabelLayer::paint(QPainter *p, const YZSceneRenderer::Scene &scene, const QPointF &origin, double pxPerMM, const QRectF &view)
+{
+    if (!scene.hasData || pxPerMM <= 0.0) return;
+    if (qRound64(pxPerMM * 1e6) != m_layoutZoom)
+        layout(scene, pxPerMM);
+
+    p->save();
+    p->setFont(m_font);
+    int currentGroup = -1;
+    auto usePen = [&](int group) {
+        if (group == currentGroup) return;
+        currentGroup = group;
+        p->setPen(scene.colors.at(scene.geometry.groups().at(group).prefixId));
+    };
+
+    // Visible slice of a kept list: coord * pxPerMM within [lo, hi] (margin for the text size)
+    auto visible = [pxPerMM](const QVector<Entry> &entries, const QVector<int> &kept, double lo, double hi) {
+        auto below = [&](int idx, double v) { return entries.at(idx).coord * pxPerMM < v; };
+        auto above = [&](double v, int idx) { return v < entries.at(idx).coord * pxPerMM; };
+        return qMakePair(std::lower_bound(kept.begin(), kept.end(), lo, below),
+                         std::upper_bound(kept.begin(), kept.end(), hi, above));
+    };
+    const double margin = 64.0;
+
+    // Horizontal lines (scene y = -z): labels at the left view edge, or right of the
+    // centerline for starboard-only lines
+    const auto rows = visible(m_horizontal, m_keptHorizontal, -view.bottom() - margin, -view.top() + margin);
+    for (auto it = rows.first; it != rows.second; ++it) {
+        const Entry &entry = m_horizontal.at(*it);
+        double x = kLabelPadding;
+        if (!(entry.sides & YZLineGeometry::Port)) {
+            if (origin.x() >= view.width()) continue;
+            x = std::max(kLabelPadding, origin.x() + kLabelPadding);
+        } else if (!(entry.sides & YZLineGeometry::Starboard)) {
+            if (origin.x() <= 0.0) continue;
+        }
+        const double y = origin.y() - entry.coord * pxPerMM - entry.size.height() / 2.0;
+        usePen(entry.group);
+        p->drawStaticText(QPointF(x, y), entry.text);
+    }
+
+    // Vertical lines: labels centred on the line along the top view edge
+    const auto columns = visible(m_vertical, m_keptVertical, view.left() - margin, view.right() + margin);
+    for (auto it = columns.first; it != columns.second; ++it) {
+        const Entry &entry = m_vertical.at(*it);
+        const double x = origin.x() + entry.coord * pxPerMM - entry.size.width() / 2.0;
+        usePen(entry.group);
+        p->drawStaticText(QPointF(x, kLabelPadding), entry.text);
+    }
+
+    p->restore();
+}
@@ -0,0 +1,55 @@
+#ifndef YZLABELLAYER_H
+#define YZLABELLAYER_H
+
+#include <QFont>
+#include <QHash>
+#include <QPainter>
+#include <QPointF>
+#include <QRectF>
+#include <QStaticText>
+#include <QString>
+#include <QVector>
+#include "YZSceneRenderer.h"
+
+/**
+ * Always-on line name labels for the YZ canvas, painted on the GUI thread over the tiles.
+ *
+ * Label texts are QStaticText objects cached by line name, so only new names are laid out
+ * when the rows change. Which labels are shown is decided once per zoom: labels of
+ * horizontal lines stack in one column and labels of vertical lines in one row, and a label
+ * overlapping the previous kept one is dropped. The cross position follows the view edge,
+ * so panning only selects the visible part of that layout by binary search.
+ */
+class YZLabelLayer
+{
+public:
+    YZLabelLayer();
+
+    void setScene(const YZSceneRenderer::Scene &scene);
+    // origin: item position of the scene origin; view: visible scene pixels
+    void paint(QPainter *p, const YZSceneRenderer::Scene &scene, const QPointF &origin, double pxPerMM, const QRectF &view);
+
+private:
+    struct Entry {
+        int line = 0;           // geometry line index
+        int group = 0;          // geometry group (colour, LOD)
+        double coord = 0.0;     // z (horizontal) or signed y (vertical), mm
+        quint8 sides = 0;       // horizontal lines: which halves the line covers
+        QStaticText text;
+        QSizeF size;
+    };
+
+    QFont m_font;
+    QVector<Entry> m_horizontal;        // sorted by coord
+    QVector<Entry> m_vertical;          // sorted by coord
+    QHash<QString, QStaticText> m_texts;
+
+    // Kept entries for one zoom, ascending coord
+    qint64 m_layoutZoom;
+    QVector<int> m_keptHorizontal;
+    QVector<int> m_keptVertical;
+
+    void layout(const YZSceneRenderer::Scene &scene, double pxPerMM);
+};
+
+#endif // YZLABELLAYER_H
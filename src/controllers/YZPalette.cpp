@@ -0,0 +1,28 @@
+#include "YZPalette.h"
+
+void YZPalette::reset()
+{
+    m_prefixColors.reset();
+    m_colors.clear();
+    m_pens.clear();
+}
+
+void YZPalette::assign(const QVector<QString> &prefixes)
+{
+    // Colours from this prefix set alone, as the CLI export assigns them, not from every
+    // prefix seen since the canvas was created
+    m_prefixColors.reset();
+    m_prefixColors.assign(prefixes);
+
+    m_colors.clear();
+    m_pens.clear();
+    m_colors.reserve(prefixes.size());
+    m_pens.reserve(prefixes.size());
+    for (const QString &prefix : prefixes) {
+        const QColor col = QColor::fromRgb(m_prefixColors.rgb(prefix));
+        QPen pen(col, 1);
+        pen.setCosmetic(true);
+        m_colors.append(col);
+        m_pens.append(pen);
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef YZPALETTE_H
+#define YZPALETTE_H
+
+#include <QColor>
+#include <QPen>
+#include <QString>
+#include <QVector>
+#include "../core/YZPrefixPalette.h"
+
+/**
+ * Colours and pens per YZ name prefix, owned by one canvas.
+ *
+ * The colours come from YZPrefixPalette, the same assignment the CLI export uses. Every
+ * assign() starts over from the sorted prefix set of the whole YZ table, so the canvas and
+ * the exported files agree; adding or removing a prefix may recolour the ones after it.
+ */
+class YZPalette
+{
+public:
+    YZPalette() = default;
+
+    // Colours and pens of prefixes (indexed like the vector, i.e. by prefix id), replacing
+    // any earlier assignment
+    void assign(const QVector<QString> &prefixes);
+    void reset();
+
+    const QVector<QColor> &colors() const { return m_colors; }
+    // Cosmetic 1 px pens, one per prefix id
+    const QVector<QPen> &pens() const { return m_pens; }
+    QColor color(const QString &prefix) const { return QColor::fromRgb(m_prefixColors.rgb(prefix)); }
+    const YZPrefixPalette &prefixColors() const { return m_prefixColors; }
+
+private:
+    YZPrefixPalette m_prefixColors;
+    QVector<QColor> m_colors;
+    QVector<QPen> m_pens;
+};
+
+#endif // YZPALETTE_H
@@ -0,0 +1,68 @@
+#include "YZPdfSink.h"
+#include <QColor>
+#include <QFontMetricsF>
+#include <QPageLayout>
+#include <QPageSize>
+#include <QPen>
+#include <algorithm>
+
+YZPdfSink::YZPdfSink(const QString &fileName, double scale)
+    : m_fileName(fileName), m_scale(scale > 0.0 ? scale : 1.0), m_unitsPerMM(1.0)
+{
+}
+
+YZPdfSink::~YZPdfSink()
+{
+    if (m_painter.isActive()) m_painter.end();
+}
+
+bool YZPdfSink::begin(const QRectF &extent)
+{
+    m_extent = extent;
+    m_writer = std::make_unique<QPdfWriter>(m_fileName);
+    m_writer->setCreator(QStringLiteral("DewaruciCpp"));
+    m_writer->setPageSize(QPageSize(QSizeF(extent.width() / m_scale, extent.height() / m_scale),
+                                    QPageSize::Millimeter));
+    m_writer->setPageMargins(QMarginsF(0, 0, 0, 0), QPageLayout::Millimeter);
+    if (!m_painter.begin(m_writer.get())) return false;
+
+    // Device units per section mm: resolution is per inch of paper
+    m_unitsPerMM = m_writer->resolution() / 25.4 / m_scale;
+    return true;
+}
+
+// Section mm (z up) to page units (y down)
+QPointF YZPdfSink::toDevice(const QPointF &section) const
+{
+    return QPointF((section.x() - m_extent.left()) * m_unitsPerMM,
+                   (m_extent.bottom() - section.y()) * m_unitsPerMM);
+}
+
+void YZPdfSink::line(const QLineF &segment, const QString &layer, quint32 rgb)
+{
+    Q_UNUSED(layer);
+    // 0.25 mm on paper
+    m_painter.setPen(QPen(QColor::fromRgb(rgb), 0.25 * m_scale * m_unitsPerMM));
+    m_painter.drawLine(toDevice(segment.p1()), toDevice(segment.p2()));
+}
+
+void YZPdfSink::text(const QPointF &at, const QString &value, double heightMM, bool centered,
+                     const QString &layer, quint32 rgb)
+{
+    Q_UNUSED(layer);
+    const double pixelSize = heightMM * m_unitsPerMM;
+    if (m_font.pixelSize() != qRound(pixelSize)) {
+        m_font.setPixelSize(std::max(1, qRound(pixelSize)));
+        m_painter.setFont(m_font);
+    }
+    QPointF p = toDevice(at);
+    if (centered)
+        p.rx() -= QFontMetricsF(m_font, m_writer.get()).horizontalAdvance(value) / 2.0;
+    m_painter.setPen(QColor::fromRgb(rgb));
+    m_painter.drawText(p, value);
+}
+
+bool YZPdfSink::end()
+{
+    return m_painter.isActive() && m_painter.end();
+}
@@ -0,0 +1,40 @@
+#ifndef YZPDFSINK_H
+#define YZPDFSINK_H
+
+#include <QFont>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QString>
+#include <memory>
+#include "../core/YZSectionExport.h"
+
+/**
+ * PDF output of the YZ section export (QtGui, so application only; dewaruci-cli writes
+ * SVG and DXF). One page sized to the exported extent at 1:scale; each element is painted
+ * into the PDF stream as it arrives.
+ */
+class YZPdfSink : public YZSectionSink
+{
+public:
+    explicit YZPdfSink(const QString &fileName, double scale = 50.0);
+    ~YZPdfSink() override;
+
+    bool begin(const QRectF &extent) override;
+    void line(const QLineF &segment, const QString &layer, quint32 rgb) override;
+    void text(const QPointF &at, const QString &value, double heightMM, bool centered,
+              const QString &layer, quint32 rgb) override;
+    bool end() override;
+
+private:
+    QString m_fileName;
+    double m_scale;
+    std::unique_ptr<QPdfWriter> m_writer;
+    QPainter m_painter;
+    QRectF m_extent;
+    double m_unitsPerMM;    // device units per section mm
+    QFont m_font;
+
+    QPointF toDevice(const QPointF &section) const;
+};
+
+#endif // YZPDFSINK_H
@@ -0,0 +1,304 @@
+#include "YZSceneRenderer.h"
+#include <QPen>
+#include <QPolygonF>
+#include <cmath>
+#include <algorithm>
+
+// Segments of one logical line (1, or 2 for P+S) clipped to the visible
+// world rectangle, with the mm value reported for each segment. Horizontal lines run from/to
+// the centerline, vertical lines are mirrored to -|v| (P) and +|v| (S). pxPerMM converts mm to
+// pixels. Lines outside the view produce no segment.
+int YZSceneRenderer::lineSegments(quint8 axis, quint8 sides, double pos, double centerX, double centerY,
+                                  double pxPerMM, const QRectF &view, QLineF out[2], double values[2])
+{
+    int n = 0;
+    if (axis == YZLineGeometry::Horizontal) {
+        const double yPx = centerY - pos * pxPerMM;
+        if (yPx < view.top() || yPx > view.bottom()) return 0;
+        if ((sides & YZLineGeometry::Port) && view.left() <= centerX) {
+            out[n] = QLineF(view.left(), yPx, std::min(centerX, view.right()), yPx);
+            values[n++] = pos;
+        }
+        if ((sides & YZLineGeometry::Starboard) && view.right() >= centerX) {
+            out[n] = QLineF(std::max(centerX, view.left()), yPx, view.right(), yPx);
+            values[n++] = pos;
+        }
+        return n;
+    }
+
+    const bool both = (sides & YZLineGeometry::Port) && (sides & YZLineGeometry::Starboard);
+    if (sides & YZLineGeometry::Starboard) {
+        const double xPx = centerX + std::fabs(pos) * pxPerMM;
+        if (xPx >= view.left() && xPx <= view.right()) {
+            out[n] = QLineF(xPx, view.bottom(), xPx, view.top());
+            values[n++] = both ? std::fabs(pos) : pos;
+        }
+    }
+    if (sides & YZLineGeometry::Port) {
+        const double xPx = centerX - std::fabs(pos) * pxPerMM;
+        if (xPx >= view.left() && xPx <= view.right()) {
+            out[n] = QLineF(xPx, view.bottom(), xPx, view.top());
+            values[n++] = both ? -std::fabs(pos) : pos;
+        }
+    }
+    return n;
+}
+
+void YZSceneRenderer::hullSegments(const Scene &scene, int line, const QLineF &segment, double centerX, double centerY,
+                                   double pxPerMM, QVector<QLineF> &out)
+{
+    const HullSectionCache::LineClip &clip = scene.hullClip;
+    if (clip.isEmpty()) {
+        out.append(segment);
+        return;
+    }
+
+    const bool horizontal = scene.geometry.axes().at(line) == YZLineGeometry::Horizontal;
+    for (int k = clip.offsets.at(line); k < clip.offsets.at(line + 1); ++k) {
+        const HullSection::Span &span = clip.spans.at(k);
+        if (horizontal) {
+            // Spans run along y: x = centerX + y * pxPerMM
+            const double a = std::max(std::min(segment.x1(), segment.x2()), centerX + span.from * pxPerMM);
+            const double b = std::min(std::max(segment.x1(), segment.x2()), centerX + span.to * pxPerMM);
+            if (a < b) out.append(QLineF(a, segment.y1(), b, segment.y1()));
+        } else {
+            // Spans run along z: y = centerY - z * pxPerMM, segments go bottom to top
+            const double a = std::max(std::min(segment.y1(), segment.y2()), centerY - span.to * pxPerMM);
+            const double b = std::min(std::max(segment.y1(), segment.y2()), centerY - span.from * pxPerMM);
+            if (a < b) out.append(QLineF(segment.x1(), b, segment.x1(), a));
+        }
+    }
+}
+
+// Shape of one LOD band clipped to the view. A single-line band gives
+// a line (returns 1), a merged band a rectangle at least minThickness wide (returns 2),
+// a band outside the view nothing (returns 0).
+int YZSceneRenderer::bandShape(const YZLineLod::Track &track, const YZLineLod::Band &band, double centerX, double centerY,
+                               double pxPerMM, const QRectF &view, double minThickness, QLineF &line, QRectF &rect)
+{
+    double x1, x2, y1, y2;
+    if (track.axis == YZLineGeometry::Horizontal) {
+        y1 = centerY - band.to * pxPerMM;
+        y2 = centerY - band.from * pxPerMM;
+        if (track.side == YZLineGeometry::Port) {
+            x1 = view.left();
+            x2 = std::min(centerX, view.right());
+        } else {
+            x1 = std::max(centerX, view.left());
+            x2 = view.right();
+        }
+    } else {
+        x1 = centerX + band.from * pxPerMM;
+        x2 = centerX + band.to * pxPerMM;
+        y1 = view.top();
+        y2 = view.bottom();
+    }
+    if (x2 < view.left() || x1 > view.right() || y2 < view.top() || y1 > view.bottom() || x1 > x2)
+        return 0;
+
+    if (band.count == 1) {
+        line = (track.axis == YZLineGeometry::Horizontal) ? QLineF(x1, y1, x2, y1) : QLineF(x1, view.bottom(), x1, view.top());
+        return 1;
+    }
+
+    if (track.axis == YZLineGeometry::Horizontal && y2 - y1 < minThickness) {
+        const double mid = (y1 + y2) / 2.0;
+        y1 = mid - minThickness / 2.0;
+        y2 = mid + minThickness / 2.0;
+    } else if (track.axis == YZLineGeometry::Vertical && x2 - x1 < minThickness) {
+        const double mid = (x1 + x2) / 2.0;
+        x1 = mid - minThickness / 2.0;
+        x2 = mid + minThickness / 2.0;
+    }
+    rect = QRectF(QPointF(x1, y1), QPointF(x2, y2));
+    return 2;
+}
+
+QVector<YZSceneRenderer::TrackLine> YZSceneRenderer::trackLines(const Scene &scene, int group, const YZLineLod::Track &track)
+{
+    // Same coordinates as YZLineLod::build(): z per side for horizontal tracks, signed y
+    // (-|y| port, +|y| starboard) for the vertical one
+    const YZLineGeometry &geometry = scene.geometry;
+    const auto &g = geometry.groups().at(group);
+    QVector<TrackLine> lines;
+    for (int i = g.begin; i < g.end; ++i) {
+        if (geometry.axes().at(i) != track.axis) continue;
+        const quint8 sides = geometry.sides().at(i);
+        const double pos = geometry.positions().at(i);
+        if (track.axis == YZLineGeometry::Horizontal) {
+            if (sides & track.side) lines.append({ pos, i });
+        } else {
+            if (sides & YZLineGeometry::Starboard) lines.append({ std::fabs(pos), i });
+            if (sides & YZLineGeometry::Port) lines.append({ -std::fabs(pos), i });
+        }
+    }
+    std::sort(lines.begin(), lines.end(), [](const TrackLine &a, const TrackLine &b) { return a.coord < b.coord; });
+    return lines;
+}
+
+bool YZSceneRenderer::bandHullSpans(const Scene &scene, const QVector<TrackLine> &lines, const YZLineLod::Band &band,
+                                    QVector<HullSection::Span> &out)
+{
+    out.clear();
+    const HullSectionCache::LineClip &clip = scene.hullClip;
+    if (clip.isEmpty()) return false;
+
+    auto first = std::lower_bound(lines.constBegin(), lines.constEnd(), band.from,
+                                  [](const TrackLine &l, double v) { return l.coord < v; });
+    for (auto it = first; it != lines.constEnd() && it->coord <= band.to; ++it) {
+        for (int k = clip.offsets.at(it->line); k < clip.offsets.at(it->line + 1); ++k)
+            out.append(clip.spans.at(k));
+    }
+
+    std::sort(out.begin(), out.end(), [](const HullSection::Span &a, const HullSection::Span &b) { return a.from < b.from; });
+    int merged = 0;
+    for (int k = 0; k < out.size(); ++k) {
+        if (merged > 0 && out.at(k).from <= out.at(merged - 1).to)
+            out[merged - 1].to = std::max(out.at(merged - 1).to, out.at(k).to);
+        else
+            out[merged++] = out.at(k);
+    }
+    out.resize(merged);
+    return true;
+}
+
+double YZSceneRenderer::lodThresholdMM(const Scene &scene, double pxPerMM)
+{
+    if (scene.lodPixelThreshold <= 0.0 || pxPerMM <= 0.0) return 0.0;
+    return scene.lodPixelThreshold / pxPerMM;
+}
+
+bool YZSceneRenderer::isGroupDense(const Scene &scene, int group, double thresholdMM)
+{
+    for (int t = scene.lod.groupBegin(group); t < scene.lod.groupEnd(group); ++t) {
+        if (scene.lod.tracks().at(t).minGap < thresholdMM)
+            return true;
+    }
+    return false;
+}
+
+void YZSceneRenderer::render(QPainter *p, const Scene &scene, double pxPerMM, const QRectF &view)
+{
+    if (!scene.hasData) return;
+
+    // Center lines first (black solid line), spanning the view
+    QPen centerPen(Qt::black, 1, Qt::SolidLine);
+    centerPen.setCosmetic(true);
+    p->setPen(centerPen);
+    if (view.left() <= 0.0 && view.right() >= 0.0)
+        p->drawLine(QLineF(0.0, view.top(), 0.0, view.bottom()));
+    if (view.top() <= 0.0 && view.bottom() >= 0.0)
+        p->drawLine(QLineF(view.left(), 0.0, view.right(), 0.0));
+
+    // One pen and one drawLines() call per prefix group; dense groups become shaded bands
+    const YZLineGeometry &geometry = scene.geometry;
+    const double thresholdMM = lodThresholdMM(scene, pxPerMM);
+    const quint8 *axes = geometry.axes().constData();
+    const quint8 *sides = geometry.sides().constData();
+    const double *positions = geometry.positions().constData();
+    QVector<QLineF> lines;
+    QVector<QRectF> bands;
+    QVector<TrackLine> bandLines;
+    QVector<HullSection::Span> spans;
+    QLineF segments[2];
+    double values[2];
+    for (int g = 0; g < geometry.groups().size(); ++g) {
+        const auto &group = geometry.groups().at(g);
+
+        lines.clear();
+        if (isGroupDense(scene, g, thresholdMM)) {
+            bands.clear();
+            QLineF line;
+            QRectF rect;
+            for (int t = scene.lod.groupBegin(g); t < scene.lod.groupEnd(g); ++t) {
+                const auto &track = scene.lod.tracks().at(t);
+                const bool horizontal = track.axis == YZLineGeometry::Horizontal;
+                if (!scene.hullClip.isEmpty())
+                    bandLines = trackLines(scene, g, track);
+                for (const auto &band : track.levels.at(YZLineLod::levelFor(track, thresholdMM))) {
+                    const int shape = bandShape(track, band, 0.0, 0.0, pxPerMM, view, 1.0, line, rect);
+                    if (shape == 0) continue;
+                    if (!bandHullSpans(scene, bandLines, band, spans)) {
+                        if (shape == 1) lines.append(line);
+                        else bands.append(rect);
+                        continue;
+                    }
+                    // Only the parts of the band inside the hull, like its lines are drawn:
+                    // along x (y in mm) for horizontal bands, along y (-z in mm) for vertical ones
+                    const QRectF box = shape == 1 ? QRectF(line.p1(), line.p2()).normalized() : rect;
+                    for (const HullSection::Span &span : spans) {
+                        const double a = horizontal ? std::max(box.left(), span.from * pxPerMM)
+                                                    : std::max(box.top(), -span.to * pxPerMM);
+                        const double b = horizontal ? std::min(box.right(), span.to * pxPerMM)
+                                                    : std::min(box.bottom(), -span.from * pxPerMM);
+                        if (a >= b) continue;
+                        if (shape == 1)
+                            lines.append(horizontal ? QLineF(a, line.y1(), b, line.y1()) : QLineF(line.x1(), b, line.x1(), a));
+                        else
+                            bands.append(horizontal ? QRectF(a, box.top(), b - a, box.height())
+                                                    : QRectF(box.left(), a, box.width(), b - a));
+                    }
+                }
+            }
+            if (!bands.isEmpty()) {
+                QColor fill = scene.colors.at(group.prefixId);
+                fill.setAlpha(110);
+                p->setPen(Qt::NoPen);
+                p->setBrush(fill);
+                p->drawRects(bands);
+                p->setBrush(Qt::NoBrush);
+            }
+        } else {
+            for (int i = group.begin; i < group.end; ++i) {
+                const int n = lineSegments(axes[i], sides[i], positions[i], 0.0, 0.0, pxPerMM, view, segments, values);
+                for (int s = 0; s < n; ++s)
+                    hullSegments(scene, i, segments[s], 0.0, 0.0, pxPerMM, lines);
+            }
+        }
+        if (lines.isEmpty()) continue;
+
+        p->setPen(scene.pens.at(group.prefixId));
+        p->drawLines(lines);
+    }
+
+    // Ship outline last so it stays clearly visible as boundary: the hull section of the
+    // frame, or B wide and D high with the keel at z = 0 when there is no offset table
+    QPen outlinePen(Qt::black, 2, Qt::SolidLine);
+    outlinePen.setCosmetic(true);
+    if (!scene.hullPolygon.isEmpty()) {
+        QPolygonF hull;
+        hull.reserve(scene.hullPolygon.size());
+        for (const QPointF &point : scene.hullPolygon)
+            hull.append(QPointF(point.x() * pxPerMM, -point.y() * pxPerMM));
+        if (hull.boundingRect().adjusted(-2, -2, 2, 2).intersects(view)) {
+            p->setPen(outlinePen);
+            p->setBrush(Qt::NoBrush);
+            p->drawPolygon(hull);
+        }
+        return;
+    }
+
+    const double halfWidthPx = scene.outlineHalfWidthMM * pxPerMM;
+    const double heightPx = scene.outlineHeightMM * pxPerMM;
+    const QRectF outline(QPointF(-halfWidthPx, -heightPx), QPointF(halfWidthPx, 0.0));
+    if (outline.adjusted(-2, -2, 2, 2).intersects(view)) {
+        p->setPen(outlinePen);
+        p->setBrush(Qt::NoBrush);
+        p->drawRect(outline);
+    }
+}
+
+QImage YZSceneRenderer::renderTile(const Scene &scene, double pxPerMM, int tx, int ty, int size)
+{
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.translate(-double(tx) * size, -double(ty) * size);
+    // Small margin so lines and band edges crossing the tile border are not cut short
+    const QRectF view = QRectF(double(tx) * size, double(ty) * size, size, size).adjusted(-2, -2, 2, 2);
+    render(&painter, scene, pxPerMM, view);
+    painter.end();
+    return image;
+}
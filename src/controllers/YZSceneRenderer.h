@@ -0,0 +1,75 @@
+#ifndef YZSCENERENDERER_H
+#define YZSCENERENDERER_H
+
+#include <QPainter>
+#include <QColor>
+#include <QPen>
+#include <QImage>
+#include <QLineF>
+#include <QRectF>
+#include <QVector>
+#include "../core/YZLineGeometry.h"
+#include "../core/YZLineLod.h"
+#include "../core/HullSection.h"
+
+/**
+ * Stateless renderer of the YZ section drawing.
+ *
+ * Works in scene pixels: the origin is the centerline intersection, x grows to starboard,
+ * y grows downwards and one mm is pxPerMM pixels (grid spacing / 1000 x zoom). Everything
+ * it needs is in a Scene value whose containers are implicitly shared, so a copy can be
+ * handed to a worker thread and rendered there with the raster engine.
+ */
+class YZSceneRenderer
+{
+public:
+    struct Scene {
+        bool hasData = false;               // no rows: nothing is drawn, not even centerlines
+        YZLineGeometry geometry;
+        YZLineLod lod;
+        QVector<QColor> colors;             // per prefix id (band fill)
+        QVector<QPen> pens;                 // per prefix id, cosmetic line pens
+        double outlineHalfWidthMM = 24384.0 / 2.0;
+        double outlineHeightMM = 5490.0;
+        double lodPixelThreshold = 3.0;     // 0 disables LOD bands
+        // Hull section of the current frame (mm, y/z) and the parts of each line inside it;
+        // both empty without an offset table: B x D rectangle, lines unclipped
+        QVector<QPointF> hullPolygon;
+        HullSectionCache::LineClip hullClip;
+    };
+
+    // Draws the part of the scene inside view (scene pixels); the painter maps scene pixels
+    static void render(QPainter *p, const Scene &scene, double pxPerMM, const QRectF &view);
+    // One size x size tile whose top-left corner is scene pixel (tx * size, ty * size)
+    static QImage renderTile(const Scene &scene, double pxPerMM, int tx, int ty, int size);
+
+    // LOD merge distance in mm at this zoom, 0 when disabled
+    static double lodThresholdMM(const Scene &scene, double pxPerMM);
+    // True when a prefix group is drawn as LOD bands at this merge distance
+    static bool isGroupDense(const Scene &scene, int group, double thresholdMM);
+
+    // Segments of one logical line (1, or 2 for P+S) clipped to view, with the mm value
+    // reported for each segment. Coordinates are relative to (centerX, centerY).
+    static int lineSegments(quint8 axis, quint8 sides, double pos, double centerX, double centerY,
+                            double pxPerMM, const QRectF &view, QLineF out[2], double values[2]);
+    // Appends the parts of segment (a lineSegments() result of line) inside the hull section,
+    // or segment itself when the scene has no hull
+    static void hullSegments(const Scene &scene, int line, const QLineF &segment, double centerX, double centerY,
+                             double pxPerMM, QVector<QLineF> &out);
+    // One LOD band clipped to view: 1 = line, 2 = rectangle at least minThickness wide, 0 = hidden
+    static int bandShape(const YZLineLod::Track &track, const YZLineLod::Band &band, double centerX, double centerY,
+                         double pxPerMM, const QRectF &view, double minThickness, QLineF &line, QRectF &rect);
+
+    // Lines of one LOD track of a group: (track coordinate, geometry line), ascending
+    struct TrackLine {
+        double coord;
+        int line;
+    };
+    static QVector<TrackLine> trackLines(const Scene &scene, int group, const YZLineLod::Track &track);
+    // Union of the hull spans of the lines inside band, sorted and disjoint (mm along the
+    // band: y for horizontal tracks, z for vertical ones); false when the scene has no hull
+    static bool bandHullSpans(const Scene &scene, const QVector<TrackLine> &lines, const YZLineLod::Band &band,
+                              QVector<HullSection::Span> &out);
+};
+
+#endif // YZSCENERENDERER_H
@@ -0,0 +1,272 @@
+#include "YZTileRenderer.h"
+#include <QtConcurrent/QtConcurrentRun>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// More changed bands than this in one track invalidate the track's whole span instead
+static const int kMaxChangedRanges = 64;
+// Scene pixels around a line or band that its antialiased, cosmetic pen may touch
+static const double kTileMargin = 3.0;
+
+YZTileRenderer::YZTileRenderer(QObject *parent)
+    : QObject(parent)
+    , m_activeZoom(-1)
+    , m_generation(0)
+    , m_tick(0)
+    , m_maxTiles(256)
+{
+    // Leave one core to the GUI thread
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+YZTileRenderer::~YZTileRenderer()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+YZTileRenderer::TileKey YZTileRenderer::keyFor(double pxPerMM, int tx, int ty)
+{
+    TileKey key;
+    key.zoom = qRound64(pxPerMM * 1e6);
+    key.tx = tx;
+    key.ty = ty;
+    return key;
+}
+
+void YZTileRenderer::setMaxTiles(int count)
+{
+    m_maxTiles = std::max(1, count);
+    evict();
+}
+
+void YZTileRenderer::clear()
+{
+    m_pool.clear();
+    m_pending.clear();
+    m_tiles.clear();
+    ++m_generation;
+}
+
+void YZTileRenderer::setScene(const YZSceneRenderer::Scene &scene)
+{
+    const YZSceneRenderer::Scene before = m_scene;
+    m_scene = scene;
+
+    // Results of renders started from the previous scene are dropped when they arrive
+    m_pool.clear();
+    m_pending.clear();
+    ++m_generation;
+
+    if (before.hasData != scene.hasData
+        || !qFuzzyCompare(before.outlineHalfWidthMM, scene.outlineHalfWidthMM)
+        || !qFuzzyCompare(before.outlineHeightMM, scene.outlineHeightMM)
+        || !qFuzzyCompare(before.lodPixelThreshold + 1.0, scene.lodPixelThreshold + 1.0)
+        || before.hullPolygon != scene.hullPolygon
+        || before.hullClip != scene.hullClip) {
+        m_tiles.clear();
+        return;
+    }
+
+    invalidateChanges(before, scene);
+}
+
+QImage YZTileRenderer::tile(double pxPerMM, int tx, int ty)
+{
+    const TileKey key = keyFor(pxPerMM, tx, ty);
+    activateZoom(key.zoom);
+
+    auto it = m_tiles.find(key);
+    if (it != m_tiles.end()) {
+        it->lastUsed = ++m_tick;
+        return it->image;
+    }
+    request(pxPerMM, tx, ty);
+    return QImage();
+}
+
+void YZTileRenderer::request(double pxPerMM, int tx, int ty)
+{
+    const TileKey key = keyFor(pxPerMM, tx, ty);
+    activateZoom(key.zoom);
+    if (m_tiles.contains(key) || m_pending.contains(key)) return;
+
+    m_pending.insert(key);
+    const quint64 generation = m_generation;
+    QtConcurrent::run(&m_pool, &YZSceneRenderer::renderTile, m_scene, pxPerMM, tx, ty, int(TileSize))
+        .then(this, [this, key, pxPerMM, generation](const QImage &image) {
+            // Scene or zoom changed while rendering
+            if (generation != m_generation) return;
+            m_pending.remove(key);
+
+            Tile tile;
+            tile.image = image;
+            tile.pxPerMM = pxPerMM;
+            tile.lastUsed = ++m_tick;
+            m_tiles.insert(key, tile);
+            evict();
+            emit tileReady();
+        });
+}
+
+void YZTileRenderer::activateZoom(qint64 zoom)
+{
+    if (zoom == m_activeZoom) return;
+    // Queued renders for the previous zoom are no longer wanted
+    m_activeZoom = zoom;
+    m_pool.clear();
+    m_pending.clear();
+    ++m_generation;
+}
+
+void YZTileRenderer::evict()
+{
+    if (m_tiles.size() <= m_maxTiles) return;
+
+    // Drop the least recently used tiles
+    QVector<QPair<quint64, TileKey>> byAge;
+    byAge.reserve(m_tiles.size());
+    for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it)
+        byAge.append(qMakePair(it->lastUsed, it.key()));
+    const int excess = m_tiles.size() - m_maxTiles;
+    std::nth_element(byAge.begin(), byAge.begin() + excess, byAge.end(),
+                     [](const QPair<quint64, TileKey> &a, const QPair<quint64, TileKey> &b) { return a.first < b.first; });
+    for (int i = 0; i < excess; ++i)
+        m_tiles.remove(byAge.at(i).second);
+}
+
+void YZTileRenderer::invalidateChanges(const YZSceneRenderer::Scene &before, const YZSceneRenderer::Scene &after)
+{
+    if (m_tiles.isEmpty()) return;
+
+    // Tracks and groups of every prefix in both scenes
+    struct PrefixTracks {
+        int groupBefore = -1;
+        int groupAfter = -1;
+        QColor colorBefore;
+        QColor colorAfter;
+        QHash<int, const YZLineLod::Track *> tracksBefore;  // axis * 4 + side
+        QHash<int, const YZLineLod::Track *> tracksAfter;
+    };
+    QHash<QString, PrefixTracks> prefixes;
+    auto collect = [&prefixes](const YZSceneRenderer::Scene &scene, bool isBefore) {
+        for (int g = 0; g < scene.geometry.groups().size(); ++g) {
+            const int prefixId = scene.geometry.groups().at(g).prefixId;
+            PrefixTracks &entry = prefixes[scene.geometry.prefixes().at(prefixId)];
+            (isBefore ? entry.groupBefore : entry.groupAfter) = g;
+            (isBefore ? entry.colorBefore : entry.colorAfter) = scene.colors.value(prefixId);
+            for (int t = scene.lod.groupBegin(g); t < scene.lod.groupEnd(g); ++t) {
+                const YZLineLod::Track &track = scene.lod.tracks().at(t);
+                (isBefore ? entry.tracksBefore : entry.tracksAfter).insert(track.axis * 4 + track.side, &track);
+            }
+        }
+    };
+    collect(before, true);
+    collect(after, false);
+
+    // Zoom levels present in the cache
+    QHash<qint64, double> zooms;
+    for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it)
+        zooms.insert(it.key().zoom, it->pxPerMM);
+
+    auto span = [](const YZLineLod::Track *track) {
+        const auto &lines = track->levels.first();
+        return qMakePair(lines.first().from, lines.last().to);
+    };
+
+    for (auto pit = prefixes.cbegin(); pit != prefixes.cend(); ++pit) {
+        const PrefixTracks &entry = pit.value();
+
+        // Changed line ranges per track key (level 0 bands that differ between the scenes)
+        QHash<int, QVector<QPair<double, double>>> changed;
+        QSet<int> keys;
+        for (auto it = entry.tracksBefore.cbegin(); it != entry.tracksBefore.cend(); ++it) keys.insert(it.key());
+        for (auto it = entry.tracksAfter.cbegin(); it != entry.tracksAfter.cend(); ++it) keys.insert(it.key());
+        const bool recolored = entry.colorBefore != entry.colorAfter;
+
+        for (int key : keys) {
+            const YZLineLod::Track *a = entry.tracksBefore.value(key, nullptr);
+            const YZLineLod::Track *b = entry.tracksAfter.value(key, nullptr);
+            QVector<QPair<double, double>> ranges;
+            if (!a || !b || recolored) {
+                if (a) ranges.append(span(a));
+                if (b) ranges.append(span(b));
+            } else {
+                const auto &la = a->levels.first();
+                const auto &lb = b->levels.first();
+                int i = 0, j = 0;
+                while (i < la.size() || j < lb.size()) {
+                    if (i < la.size() && j < lb.size()
+                        && la.at(i).from == lb.at(j).from && la.at(i).to == lb.at(j).to && la.at(i).count == lb.at(j).count) {
+                        ++i; ++j;
+                    } else if (j >= lb.size() || (i < la.size() && la.at(i).from <= lb.at(j).from)) {
+                        ranges.append(qMakePair(la.at(i).from, la.at(i).to));
+                        ++i;
+                    } else {
+                        ranges.append(qMakePair(lb.at(j).from, lb.at(j).to));
+                        ++j;
+                    }
+                }
+                if (ranges.size() > kMaxChangedRanges) {
+                    const auto sa = span(a), sb = span(b);
+                    ranges = { qMakePair(std::min(sa.first, sb.first), std::max(sa.second, sb.second)) };
+                }
+            }
+            if (!ranges.isEmpty()) changed.insert(key, ranges);
+        }
+        if (changed.isEmpty()) continue;
+
+        for (auto zit = zooms.cbegin(); zit != zooms.cend(); ++zit) {
+            const double thresholdMM = YZSceneRenderer::lodThresholdMM(after, zit.value());
+            const bool dense = (entry.groupBefore >= 0 && YZSceneRenderer::isGroupDense(before, entry.groupBefore, thresholdMM))
+                               || (entry.groupAfter >= 0 && YZSceneRenderer::isGroupDense(after, entry.groupAfter, thresholdMM));
+            if (dense) {
+                // Bands may merge across the change, and the group may switch between lines and bands
+                for (const YZLineLod::Track *track : entry.tracksBefore) {
+                    const auto s = span(track);
+                    invalidateTrackRange(zit.key(), zit.value(), *track, s.first, s.second);
+                }
+                for (const YZLineLod::Track *track : entry.tracksAfter) {
+                    const auto s = span(track);
+                    invalidateTrackRange(zit.key(), zit.value(), *track, s.first, s.second);
+                }
+                continue;
+            }
+            for (auto cit = changed.cbegin(); cit != changed.cend(); ++cit) {
+                const YZLineLod::Track *track = entry.tracksAfter.value(cit.key(), nullptr);
+                if (!track) track = entry.tracksBefore.value(cit.key(), nullptr);
+                for (const auto &range : cit.value())
+                    invalidateTrackRange(zit.key(), zit.value(), *track, range.first, range.second);
+            }
+        }
+    }
+}
+
+void YZTileRenderer::invalidateTrackRange(qint64 zoom, double pxPerMM, const YZLineLod::Track &track, double fromMM, double toMM)
+{
+    // Affected scene pixel rectangle (scene y grows downwards, z upwards)
+    const double inf = std::numeric_limits<double>::infinity();
+    double x1 = -inf, x2 = inf, y1 = -inf, y2 = inf;
+    if (track.axis == YZLineGeometry::Horizontal) {
+        y1 = -toMM * pxPerMM - kTileMargin;
+        y2 = -fromMM * pxPerMM + kTileMargin;
+        if (track.side == YZLineGeometry::Port) x2 = kTileMargin;
+        else x1 = -kTileMargin;
+    } else {
+        x1 = fromMM * pxPerMM - kTileMargin;
+        x2 = toMM * pxPerMM + kTileMargin;
+    }
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ) {
+        const TileKey &key = it.key();
+        const double left = double(key.tx) * TileSize;
+        const double top = double(key.ty) * TileSize;
+        if (key.zoom == zoom && left <= x2 && left + TileSize >= x1 && top <= y2 && top + TileSize >= y1)
+            it = m_tiles.erase(it);
+        else
+            ++it;
+    }
+}
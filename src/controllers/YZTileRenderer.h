@@ -0,0 +1,86 @@
+#ifndef YZTILERENDERER_H
+#define YZTILERENDERER_H
+
+#include <QObject>
+#include <QImage>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include "YZSceneRenderer.h"
+
+/**
+ * Background rasteriser of the YZ drawing into cached QImage tiles.
+ *
+ * Tiles are TileSize scene pixels square and keyed by zoom (pixels per mm) and tile column
+ * and row, so panning reuses them and only a zoom change needs new ones. Missing tiles are
+ * rendered on a private thread pool with the raster engine; tileReady() is emitted on the
+ * owner's thread when one arrives. setScene() drops only the tiles the change can affect.
+ */
+class YZTileRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int TileSize = 256;
+
+    explicit YZTileRenderer(QObject *parent = nullptr);
+    ~YZTileRenderer() override;
+
+    const YZSceneRenderer::Scene &scene() const { return m_scene; }
+    void setScene(const YZSceneRenderer::Scene &scene);
+    void clear();
+
+    // Cached tile, or a null image after scheduling its render
+    QImage tile(double pxPerMM, int tx, int ty);
+    // Schedules a tile render unless it is cached or already queued
+    void request(double pxPerMM, int tx, int ty);
+    // True when no tile render is queued or running
+    bool isIdle() const { return m_pending.isEmpty(); }
+
+    int maxTiles() const { return m_maxTiles; }
+    void setMaxTiles(int count);
+
+signals:
+    void tileReady();
+
+private:
+    struct TileKey {
+        qint64 zoom = 0;    // pxPerMM quantised to 1e-6
+        int tx = 0;
+        int ty = 0;
+
+        bool operator==(const TileKey &other) const
+        {
+            return zoom == other.zoom && tx == other.tx && ty == other.ty;
+        }
+        friend size_t qHash(const TileKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.zoom, key.tx, key.ty);
+        }
+    };
+
+    struct Tile {
+        QImage image;
+        double pxPerMM = 0.0;
+        quint64 lastUsed = 0;
+    };
+
+    YZSceneRenderer::Scene m_scene;
+    QHash<TileKey, Tile> m_tiles;
+    QSet<TileKey> m_pending;
+    QThreadPool m_pool;
+    qint64 m_activeZoom;
+    quint64 m_generation;
+    quint64 m_tick;
+    int m_maxTiles;
+
+    static TileKey keyFor(double pxPerMM, int tx, int ty);
+    void activateZoom(qint64 zoom);
+    void evict();
+
+    // Selective invalidation between two scenes with the same outline and LOD settings
+    void invalidateChanges(const YZSceneRenderer::Scene &before, const YZSceneRenderer::Scene &after);
+    void invalidateTrackRange(qint64 zoom, double pxPerMM, const YZLineLod::Track &track, double fromMM, double toMM);
+};
+
+#endif // YZTILERENDERER_H
@@ -0,0 +1,151 @@
+#include "DependencyGraph.h"
+#include <algorithm>
+
+bool DependencyGraph::addNode(const QString &key, const QStringList &inputs, const Compute &compute)
+{
+    // A cycle closes when one of the inputs is the key itself or downstream of it
+    const QSet<QString> targets(inputs.begin(), inputs.end());
+    if (targets.contains(key) || reaches(key, targets))
+        return false;
+
+    // order() counts one pending input per edge, so a repeated input would never be released
+    QStringList unique = inputs;
+    unique.removeDuplicates();
+
+    removeNode(key);
+    m_nodes.insert(key, { unique, compute });
+    for (const QString &input : unique)
+        m_dependents[input].insert(key);
+    return true;
+}
+
+void DependencyGraph::removeNode(const QString &key)
+{
+    const auto it = m_nodes.constFind(key);
+    if (it == m_nodes.constEnd())
+        return;
+    for (const QString &input : it.value().inputs) {
+        auto dependents = m_dependents.find(input);
+        if (dependents == m_dependents.end())
+            continue;
+        dependents.value().remove(key);
+        if (dependents.value().isEmpty())
+            m_dependents.erase(dependents);
+    }
+    m_nodes.remove(key);
+    m_dirty.remove(key);
+}
+
+void DependencyGraph::invalidate(const QString &key)
+{
+    m_dirty.insert(key);
+}
+
+bool DependencyGraph::reaches(const QString &from, const QSet<QString> &targets) const
+{
+    QSet<QString> seen;
+    QStringList stack { from };
+    while (!stack.isEmpty()) {
+        const QString key = stack.takeLast();
+        for (const QString &next : m_dependents.value(key)) {
+            if (targets.contains(next))
+                return true;
+            if (!seen.contains(next)) {
+                seen.insert(next);
+                stack.append(next);
+            }
+        }
+    }
+    return false;
+}
+
+// Roots and every node downstream of them, inputs before the nodes using them. Ties are
+// broken by key so the order does not depend on hash seeds.
+QStringList DependencyGraph::order(const QSet<QString> &roots) const
+{
+    QSet<QString> affected = roots;
+    QStringList stack(roots.begin(), roots.end());
+    while (!stack.isEmpty()) {
+        const QString key = stack.takeLast();
+        for (const QString &next : m_dependents.value(key)) {
+            if (!affected.contains(next)) {
+                affected.insert(next);
+                stack.append(next);
+            }
+        }
+    }
+
+    QHash<QString, int> pending;
+    for (const QString &key : affected) {
+        int count = 0;
+        for (const QString &input : m_nodes.value(key).inputs) {
+            if (affected.contains(input))
+                ++count;
+        }
+        pending.insert(key, count);
+    }
+
+    QStringList ready;
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        if (it.value() == 0)
+            ready.append(it.key());
+    }
+    std::sort(ready.begin(), ready.end(), std::greater<QString>());
+
+    QStringList sorted;
+    sorted.reserve(affected.size());
+    while (!ready.isEmpty()) {
+        const QString key = ready.takeLast();
+        sorted.append(key);
+        QStringList released;
+        for (const QString &next : m_dependents.value(key)) {
+            int &count = pending[next];
+            if (--count == 0)
+                released.append(next);
+        }
+        if (!released.isEmpty()) {
+            ready += released;
+            std::sort(ready.begin(), ready.end(), std::greater<QString>());
+        }
+    }
+    return sorted;
+}
+
+QStringList DependencyGraph::dirtyOrder() const
+{
+    QStringList nodes;
+    for (const QString &key : order(m_dirty)) {
+        if (m_nodes.contains(key) && !m_dirty.contains(key))
+            nodes.append(key);
+    }
+    return nodes;
+}
+
+QStringList DependencyGraph::run()
+{
+    // Invalidations raised by compute functions belong to the next run
+    QSet<QString> roots;
+    roots.swap(m_dirty);
+
+    QSet<QString> changed = roots;
+    QStringList computed;
+    for (const QString &key : order(roots)) {
+        const auto node = m_nodes.constFind(key);
+        if (node == m_nodes.constEnd() || !node.value().compute)
+            continue;
+        // An edited derived value is taken as given
+        if (roots.contains(key))
+            continue;
+        bool needed = false;
+        for (const QString &input : node.value().inputs)
+            needed = needed || changed.contains(input);
+        if (!needed)
+            continue;
+
+        const Compute compute = node.value().compute;
+        computed.append(key);
+        if (compute())
+            changed.insert(key);
+    }
+    return computed;
+}
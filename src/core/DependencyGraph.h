@@ -0,0 +1,60 @@
+#ifndef DEPENDENCYGRAPH_H
+#define DEPENDENCYGRAPH_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+/**
+ * Recalculation graph over named values ("material:1", "profile:7:section", ...).
+ *
+ * A derived node declares its inputs and a compute function that refreshes the value it
+ * owns and returns whether that value changed. Keys that are never added as nodes are
+ * plain sources. invalidate() marks a key as changed from outside (an edit); run() then
+ * computes only the nodes downstream of it, each once and after all of its inputs
+ * (topological order). An invalidated derived node keeps the value it was given and is not
+ * recomputed in that run. A node whose inputs all came out unchanged is skipped, so an
+ * edit that does not change a derived value stops there.
+ *
+ * The graph owns no values and does no I/O: compute functions stage their writes and the
+ * caller flushes them after run(), in one transaction.
+ */
+class DependencyGraph
+{
+public:
+    using Compute = std::function<bool()>;
+
+    // Adds or replaces a node; false (and nothing added) when it would close a cycle
+    bool addNode(const QString &key, const QStringList &inputs, const Compute &compute);
+    // Drops the node; nodes using it as input keep the edge and see it as a source again
+    void removeNode(const QString &key);
+    bool contains(const QString &key) const { return m_nodes.contains(key); }
+    QStringList inputs(const QString &key) const { return m_nodes.value(key).inputs; }
+    int nodeCount() const { return m_nodes.size(); }
+
+    void invalidate(const QString &key);
+    bool hasDirty() const { return !m_dirty.isEmpty(); }
+
+    // Nodes the next run() would visit, in the order it would visit them
+    QStringList dirtyOrder() const;
+    // Computes the dirty subgraph; returns the nodes whose compute ran. Keys invalidated
+    // while it runs are left for the next run.
+    QStringList run();
+
+private:
+    struct Node {
+        QStringList inputs;
+        Compute compute;
+    };
+
+    QHash<QString, Node> m_nodes;
+    QHash<QString, QSet<QString>> m_dependents;     // key -> nodes listing it as input
+    QSet<QString> m_dirty;
+
+    bool reaches(const QString &from, const QSet<QString> &targets) const;
+    QStringList order(const QSet<QString> &roots) const;
+};
+
+#endif // DEPENDENCYGRAPH_H
@@ -0,0 +1,78 @@
+#include "FrameCoordinates.h"
+#include <algorithm>
+
+namespace FrameCoordinates {
+
+void recompute(QVector<FrameRow> &rows, double lpp, double upperL)
+{
+    std::stable_sort(rows.begin(), rows.end(), [](const FrameRow &a, const FrameRow &b) {
+        return a.frameNumber < b.frameNumber;
+    });
+
+    // prev = last row with a strictly lower frame number
+    int prevIndex = -1;
+    for (int i = 0; i < rows.size(); ++i) {
+        if (i > 0 && rows[i].frameNumber != rows[i - 1].frameNumber)
+            prevIndex = i - 1;
+
+        FrameRow &row = rows[i];
+        double xp = 0.0;
+        if (row.frameNumber > 0 && prevIndex >= 0) {
+            const FrameRow &prev = rows[prevIndex];
+            xp = prev.xpCoor + (static_cast<double>(row.frameNumber - prev.frameNumber) * prev.frameSpacing) / 1000.0;
+        } else if (row.frameNumber < 0) {
+            xp = (static_cast<double>(row.frameNumber) * row.frameSpacing) / 1000.0;
+        }
+
+        row.xpCoor = xp;
+        row.xllCoor = xp;
+        row.xl = (lpp > 0.0) ? (xp / lpp) : 0.0;
+        row.xllLll = (upperL > 0.0) ? (xp / upperL) : 0.0;
+    }
+}
+
+int spacingForFrame(const QVector<SpacingZone> &zones, int frameNumber)
+{
+    for (int i = 0; i < zones.size(); ++i) {
+        const SpacingZone &zone = zones.at(i);
+        const bool isLast = (i == zones.size() - 1);
+        if (frameNumber >= zone.startFrame
+            && (frameNumber < zone.endFrame || (isLast && frameNumber == zone.endFrame)))
+            return zone.spacing;
+    }
+    return 0;
+}
+
+QVector<int> frameNumbers(const QVector<SpacingZone> &zones)
+{
+    QVector<int> numbers;
+    for (int i = 0; i < zones.size(); ++i) {
+        const SpacingZone &zone = zones.at(i);
+        const int last = (i == zones.size() - 1) ? zone.endFrame : zone.endFrame - 1;
+        for (int n = zone.startFrame; n <= last; ++n)
+            numbers.append(n);
+    }
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+    return numbers;
+}
+
+QVector<FrameRow> rowsFromZones(const QVector<SpacingZone> &zones, const QString &ml, double lpp, double upperL)
+{
+    const QVector<int> numbers = frameNumbers(zones);
+    QVector<FrameRow> rows;
+    rows.reserve(numbers.size());
+    for (int n : numbers) {
+        FrameRow row;
+        row.frameName = QStringLiteral("Frame ") + QString::number(n);
+        row.frameNumber = n;
+        row.frameSpacing = spacingForFrame(zones, n);
+        row.ml = ml;
+        rows.append(row);
+    }
+    // Numbers are already ascending, so this is a single linear pass
+    recompute(rows, lpp, upperL);
+    return rows;
+}
+
+} // namespace FrameCoordinates
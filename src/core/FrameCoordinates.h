@@ -0,0 +1,48 @@
+#ifndef FRAMECOORDINATES_H
+#define FRAMECOORDINATES_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * XZ frame coordinate rules, shared by FrameArrangementXZController and dewaruci-cli.
+ *
+ * - frame n > 0: xp = xp(prev) + (n - prev) * spacing(prev) / 1000, prev = closest lower frame
+ * - frame n < 0: xp = n * own spacing / 1000
+ * - frame 0 (or no lower frame): xp = 0
+ * xl = xp / Lpp, xll = xp, xllLll = xll / L
+ */
+namespace FrameCoordinates {
+
+struct FrameRow {
+    int id = 0;
+    QString frameName;
+    int frameNumber = 0;
+    int frameSpacing = 0;   // mm
+    QString ml;
+    double xpCoor = 0.0;    // m
+    double xl = 0.0;
+    double xllCoor = 0.0;   // m
+    double xllLll = 0.0;
+};
+
+// Frames [startFrame, endFrame) use spacing (mm); the last zone also includes endFrame
+struct SpacingZone {
+    int startFrame;
+    int endFrame;
+    int spacing;
+};
+
+// Sorts rows by frame number and recomputes every coordinate in one pass
+void recompute(QVector<FrameRow> &rows, double lpp, double upperL);
+
+// Spacing (mm) of frame number n under the given zones; 0 when no zone covers n
+int spacingForFrame(const QVector<SpacingZone> &zones, int frameNumber);
+// All frame numbers covered by the zones, ascending and without duplicates
+QVector<int> frameNumbers(const QVector<SpacingZone> &zones);
+// One row per covered frame ("Frame n", given ml) with coordinates already computed
+QVector<FrameRow> rowsFromZones(const QVector<SpacingZone> &zones, const QString &ml, double lpp, double upperL);
+
+} // namespace FrameCoordinates
+
+#endif // FRAMECOORDINATES_H
@@ -0,0 +1,196 @@
+#include "FramePositionEngine.h"
+#include <algorithm>
+
+namespace {
+const int InitialCapacity = 256;
+}
+
+FramePositionEngine::FramePositionEngine()
+    : m_capacity(0)
+{
+    rebuild(InitialCapacity);
+}
+
+void FramePositionEngine::clear()
+{
+    m_frames.clear();
+    rebuild(InitialCapacity);
+}
+
+void FramePositionEngine::insertFrame(int frameNumber, int spacing)
+{
+    auto it = m_frames.find(frameNumber);
+    if (it != m_frames.end()) {
+        ++it->second.count;
+        setSpacing(frameNumber, spacing);
+        return;
+    }
+
+    ensureCapacity(frameNumber);
+    // Steps from this frame up to the next one used the lower neighbour's spacing so far
+    const int previous = stepSpacing(frameNumber);
+    it = m_frames.emplace(frameNumber, Entry{ spacing, 1, 0 }).first;
+    auto next = std::next(it);
+    const int last = (next == m_frames.end()) ? m_capacity - 1 : next->first - 1;
+    addSteps(std::max(frameNumber, 0), last, static_cast<qint64>(spacing) - previous);
+}
+
+void FramePositionEngine::removeFrame(int frameNumber)
+{
+    auto it = m_frames.find(frameNumber);
+    if (it == m_frames.end())
+        return;
+    if (--it->second.count > 0)
+        return;
+
+    const int removed = it->second.spacing;
+    if (it->second.offset != 0 && frameNumber >= 0)
+        addPoint(m_offsets, frameNumber + 1, -it->second.offset);
+    auto next = std::next(it);
+    const int last = (next == m_frames.end()) ? m_capacity - 1 : next->first - 1;
+    const int previous = (it == m_frames.begin()) ? 0 : std::prev(it)->second.spacing;
+    m_frames.erase(it);
+    addSteps(std::max(frameNumber, 0), last, static_cast<qint64>(previous) - removed);
+}
+
+void FramePositionEngine::setSpacing(int frameNumber, int spacing)
+{
+    auto it = m_frames.find(frameNumber);
+    if (it == m_frames.end()) {
+        insertFrame(frameNumber, spacing);
+        return;
+    }
+
+    const int old = it->second.spacing;
+    if (old == spacing)
+        return;
+    it->second.spacing = spacing;
+    auto next = std::next(it);
+    const int last = (next == m_frames.end()) ? m_capacity - 1 : next->first - 1;
+    addSteps(std::max(frameNumber, 0), last, static_cast<qint64>(spacing) - old);
+}
+
+bool FramePositionEngine::contains(int frameNumber) const
+{
+    return m_frames.find(frameNumber) != m_frames.end();
+}
+
+int FramePositionEngine::spacingOf(int frameNumber) const
+{
+    auto it = m_frames.find(frameNumber);
+    return it == m_frames.end() ? 0 : it->second.spacing;
+}
+
+void FramePositionEngine::setAnchor(int frameNumber, qint64 xpMm)
+{
+    auto it = m_frames.find(frameNumber);
+    if (it == m_frames.end())
+        return;
+
+    const qint64 delta = xpMm - positionMm(frameNumber);
+    if (delta == 0)
+        return;
+    it->second.offset += delta;
+    if (frameNumber >= 0)
+        addPoint(m_offsets, frameNumber + 1, delta);
+}
+
+qint64 FramePositionEngine::anchorOffset(int frameNumber) const
+{
+    auto it = m_frames.find(frameNumber);
+    return it == m_frames.end() ? 0 : it->second.offset;
+}
+
+double FramePositionEngine::position(int frameNumber, int ownSpacing) const
+{
+    return positionMm(frameNumber, ownSpacing) / 1000.0;
+}
+
+qint64 FramePositionEngine::positionMm(int frameNumber, int ownSpacing) const
+{
+    if (frameNumber < 0) {
+        auto it = m_frames.find(frameNumber);
+        if (it == m_frames.end())
+            return static_cast<qint64>(frameNumber) * ownSpacing;
+        // Frames below 0 do not chain, an anchor only moves its own frame
+        return static_cast<qint64>(frameNumber) * it->second.spacing + it->second.offset;
+    }
+    if (frameNumber <= m_capacity)
+        return prefixSteps(frameNumber) + prefixOffsets(frameNumber);
+
+    // Every known frame is below the capacity, so the steps beyond it use the highest frame
+    const qint64 tailSpacing = m_frames.empty() ? 0 : m_frames.rbegin()->second.spacing;
+    return prefixSteps(m_capacity) + prefixOffsets(m_capacity)
+        + (static_cast<qint64>(frameNumber) - m_capacity) * tailSpacing;
+}
+
+int FramePositionEngine::stepSpacing(int k) const
+{
+    auto it = m_frames.upper_bound(k);
+    if (it == m_frames.begin())
+        return 0;
+    return std::prev(it)->second.spacing;
+}
+
+void FramePositionEngine::addSteps(int first, int last, qint64 delta)
+{
+    last = std::min(last, m_capacity - 1);
+    if (delta == 0 || first > last)
+        return;
+    addRange(first + 1, last + 1, delta);
+}
+
+void FramePositionEngine::addRange(int l, int r, qint64 delta)
+{
+    addPoint(m_b1, l, delta);
+    addPoint(m_b1, r + 1, -delta);
+    addPoint(m_b2, l, delta * (l - 1));
+    addPoint(m_b2, r + 1, -delta * r);
+}
+
+void FramePositionEngine::addPoint(QVector<qint64> &tree, int index, qint64 delta)
+{
+    for (; index <= m_capacity; index += index & -index)
+        tree[index] += delta;
+}
+
+qint64 FramePositionEngine::sumPoint(const QVector<qint64> &tree, int index) const
+{
+    qint64 sum = 0;
+    for (; index > 0; index -= index & -index)
+        sum += tree[index];
+    return sum;
+}
+
+qint64 FramePositionEngine::prefixSteps(int n) const
+{
+    return sumPoint(m_b1, n) * n - sumPoint(m_b2, n);
+}
+
+qint64 FramePositionEngine::prefixOffsets(int n) const
+{
+    return sumPoint(m_offsets, std::min(n + 1, m_capacity));
+}
+
+void FramePositionEngine::ensureCapacity(int frameNumber)
+{
+    if (frameNumber < m_capacity)
+        return;
+    rebuild(std::max(m_capacity * 2, frameNumber + InitialCapacity));
+}
+
+void FramePositionEngine::rebuild(int capacity)
+{
+    m_capacity = capacity;
+    m_b1.fill(0, capacity + 1);
+    m_b2.fill(0, capacity + 1);
+    m_offsets.fill(0, capacity + 1);
+
+    for (auto it = m_frames.begin(); it != m_frames.end(); ++it) {
+        auto next = std::next(it);
+        const int last = (next == m_frames.end()) ? m_capacity - 1 : next->first - 1;
+        addSteps(std::max(it->first, 0), last, it->second.spacing);
+        if (it->second.offset != 0 && it->first >= 0)
+            addPoint(m_offsets, it->first + 1, it->second.offset);
+    }
+}
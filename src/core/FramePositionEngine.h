@@ -0,0 +1,73 @@
+#ifndef FRAMEPOSITIONENGINE_H
+#define FRAMEPOSITIONENGINE_H
+
+#include <QVector>
+#include <map>
+
+/**
+ * In-memory XZ frame position engine.
+ *
+ * Every integer step k >= 0 between frame k and k + 1 has a spacing g(k): the spacing of
+ * the closest existing frame at or below k (0 below the lowest frame). The position of a
+ * frame n > 0 is then the prefix sum g(0) + ... + g(n - 1), which gives exactly the
+ * FrameCoordinates rules (previous frame position plus (n - prev) * prev spacing).
+ * Frames n < 0 sit at n * own spacing and frame 0 at 0.
+ *
+ * A frame can also be anchored at a given position (a hand-entered xp): its offset from
+ * that spacing sum is kept per frame and carried by every frame above it, so later spacing
+ * edits move the frames around it without losing the hand-entered offset.
+ *
+ * g is kept in a range-update / range-query Fenwick tree over frame numbers and the
+ * anchor offsets in a second one, so adding, removing or re-spacing a frame, anchoring it
+ * and querying a position are O(log n). Sums are kept in integer millimetres to avoid
+ * accumulating rounding errors.
+ */
+class FramePositionEngine
+{
+public:
+    FramePositionEngine();
+
+    void clear();
+
+    // Frame numbers may repeat; a number stays known until every occurrence is removed
+    void insertFrame(int frameNumber, int spacing);
+    void removeFrame(int frameNumber);
+    void setSpacing(int frameNumber, int spacing);
+    bool contains(int frameNumber) const;
+    int spacingOf(int frameNumber) const;
+    // Moves a known frame to xpMm by an offset it keeps; removing the frame drops it
+    void setAnchor(int frameNumber, qint64 xpMm);
+    // Offset (mm) of an anchored frame from the position its spacings alone would give
+    qint64 anchorOffset(int frameNumber) const;
+    int frameCount() const { return static_cast<int>(m_frames.size()); }
+
+    // xp (m) of frameNumber; ownSpacing is only used for frames below 0 that are not known yet
+    double position(int frameNumber, int ownSpacing = 0) const;
+    // Same as position() in millimetres
+    qint64 positionMm(int frameNumber, int ownSpacing = 0) const;
+
+private:
+    struct Entry {
+        int spacing;
+        int count;
+        qint64 offset;
+    };
+
+    std::map<int, Entry> m_frames;
+    QVector<qint64> m_b1;
+    QVector<qint64> m_b2;
+    QVector<qint64> m_offsets;              // anchor offsets by frame number + 1 (frames >= 0)
+    int m_capacity;
+
+    int stepSpacing(int k) const;           // g(k)
+    void addSteps(int first, int last, qint64 delta);
+    void addRange(int l, int r, qint64 delta);  // 1-based Fenwick indices
+    void addPoint(QVector<qint64> &tree, int index, qint64 delta);
+    qint64 sumPoint(const QVector<qint64> &tree, int index) const;
+    qint64 prefixSteps(int n) const;        // g(0) + ... + g(n - 1) for 0 <= n <= capacity
+    qint64 prefixOffsets(int n) const;      // anchor offsets of frames 0 .. n
+    void ensureCapacity(int frameNumber);
+    void rebuild(int capacity);
+};
+
+#endif // FRAMEPOSITIONENGINE_H
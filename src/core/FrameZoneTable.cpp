@@ -0,0 +1,151 @@
+#include "FrameZoneTable.h"
+#include <algorithm>
+
+void FrameZoneTable::setZones(const QVector<Zone> &zones)
+{
+    m_zones = zones;
+    std::stable_sort(m_zones.begin(), m_zones.end(), [](const Zone &a, const Zone &b) {
+        return a.startFrame < b.startFrame;
+    });
+
+    // Clip overlaps so every frame number belongs to exactly one zone
+    QVector<Zone> clipped;
+    clipped.reserve(m_zones.size());
+    for (Zone zone : m_zones) {
+        if (!clipped.isEmpty())
+            zone.startFrame = std::max(zone.startFrame, clipped.last().endFrame + 1);
+        if (zone.endFrame < zone.startFrame)
+            continue;
+        if (zone.startFrame != zone.endFrame)
+            zone.frameName.clear();
+        clipped.append(zone);
+    }
+    m_zones = clipped;
+
+    const int n = m_zones.size();
+    m_firstRow.resize(n);
+    m_startXp.resize(n);
+    m_rowCount = 0;
+    for (int i = 0; i < n; ++i) {
+        const Zone &zone = m_zones.at(i);
+        m_firstRow[i] = m_rowCount;
+        m_rowCount += zone.endFrame - zone.startFrame + 1;
+
+        // First frame of a zone continues from the last frame of the previous zone
+        double xp = 0.0;
+        if (zone.startFrame < 0) {
+            xp = (static_cast<double>(zone.startFrame) * zone.spacing) / 1000.0;
+        } else if (zone.startFrame > 0 && i > 0) {
+            const Zone &prev = m_zones.at(i - 1);
+            xp = positionInZone(i - 1, prev.endFrame)
+                 + (static_cast<double>(zone.startFrame - prev.endFrame) * prev.spacing) / 1000.0;
+        }
+        m_startXp[i] = xp;
+    }
+}
+
+double FrameZoneTable::positionInZone(int zoneIndex, int frameNumber) const
+{
+    const Zone &zone = m_zones.at(zoneIndex);
+    if (frameNumber < 0)
+        return (static_cast<double>(frameNumber) * zone.spacing) / 1000.0;
+    if (frameNumber == 0)
+        return 0.0;
+    // Positive frames accumulate the zone spacing from frame 0 or from the zone start
+    if (zone.startFrame <= 0)
+        return (static_cast<double>(frameNumber) * zone.spacing) / 1000.0;
+    return m_startXp.at(zoneIndex) + (static_cast<double>(frameNumber - zone.startFrame) * zone.spacing) / 1000.0;
+}
+
+int FrameZoneTable::zoneOfRow(int index) const
+{
+    const auto it = std::upper_bound(m_firstRow.cbegin(), m_firstRow.cend(), index);
+    return int(it - m_firstRow.cbegin()) - 1;
+}
+
+FrameCoordinates::FrameRow FrameZoneTable::row(int index, double lpp, double upperL) const
+{
+    FrameCoordinates::FrameRow row;
+    if (index < 0 || index >= m_rowCount)
+        return row;
+
+    const int z = zoneOfRow(index);
+    const Zone &zone = m_zones.at(z);
+    row.frameNumber = zone.startFrame + (index - m_firstRow.at(z));
+    row.frameName = zone.frameName.isEmpty() ? defaultFrameName(row.frameNumber) : zone.frameName;
+    row.frameSpacing = zone.spacing;
+    row.ml = zone.ml;
+    row.xpCoor = positionInZone(z, row.frameNumber);
+    row.xllCoor = row.xpCoor;
+    row.xl = (lpp > 0.0) ? (row.xpCoor / lpp) : 0.0;
+    row.xllLll = (upperL > 0.0) ? (row.xpCoor / upperL) : 0.0;
+    return row;
+}
+
+int FrameZoneTable::indexOfFrame(int frameNumber) const
+{
+    const auto it = std::upper_bound(m_zones.cbegin(), m_zones.cend(), frameNumber, [](int n, const Zone &zone) {
+        return n < zone.startFrame;
+    });
+    if (it == m_zones.cbegin())
+        return -1;
+    const int z = int(it - m_zones.cbegin()) - 1;
+    if (frameNumber > m_zones.at(z).endFrame)
+        return -1;
+    return m_firstRow.at(z) + (frameNumber - m_zones.at(z).startFrame);
+}
+
+FrameZoneTable FrameZoneTable::fromRows(QVector<FrameCoordinates::FrameRow> rows, bool *lossless)
+{
+    std::stable_sort(rows.begin(), rows.end(), [](const FrameCoordinates::FrameRow &a, const FrameCoordinates::FrameRow &b) {
+        return a.frameNumber < b.frameNumber;
+    });
+
+    bool complete = true;
+    QVector<Zone> zones;
+    for (const FrameCoordinates::FrameRow &row : rows) {
+        const bool customName = row.frameName != defaultFrameName(row.frameNumber);
+        if (!zones.isEmpty()) {
+            Zone &last = zones.last();
+            if (row.frameNumber == last.endFrame) {
+                complete = false;   // duplicate frame number
+                continue;
+            }
+            if (!customName && last.frameName.isEmpty() && row.frameNumber == last.endFrame + 1
+                && row.frameSpacing == last.spacing && row.ml == last.ml) {
+                last.endFrame = row.frameNumber;
+                continue;
+            }
+        }
+
+        Zone zone;
+        zone.startFrame = row.frameNumber;
+        zone.endFrame = row.frameNumber;
+        zone.spacing = row.frameSpacing;
+        zone.ml = row.ml;
+        if (customName)
+            zone.frameName = row.frameName;
+        zones.append(zone);
+    }
+
+    if (lossless)
+        *lossless = complete;
+
+    FrameZoneTable table;
+    table.setZones(zones);
+    return table;
+}
+
+QVector<FrameCoordinates::FrameRow> FrameZoneTable::toRows(double lpp, double upperL) const
+{
+    QVector<FrameCoordinates::FrameRow> rows;
+    rows.reserve(m_rowCount);
+    for (int i = 0; i < m_rowCount; ++i)
+        rows.append(row(i, lpp, upperL));
+    return rows;
+}
+
+QString FrameZoneTable::defaultFrameName(int frameNumber)
+{
+    return QStringLiteral("Frame ") + QString::number(frameNumber);
+}
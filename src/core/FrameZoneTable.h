@@ -0,0 +1,56 @@
+#ifndef FRAMEZONETABLE_H
+#define FRAMEZONETABLE_H
+
+#include <QString>
+#include <QVector>
+#include "FrameCoordinates.h"
+
+/**
+ * Compact XZ frame table: runs of consecutive frames sharing spacing and ML.
+ *
+ * Rows are expanded on demand (row(i) is O(log zones)), so memory and edit cost scale
+ * with the number of zones. fromRows()/toRows() convert losslessly to and from the
+ * per-frame table: frame numbers, names, spacings and ML survive, coordinates are
+ * recomputed by the FrameCoordinates rules. Frames whose name is not the default
+ * "Frame n" are kept as single-frame zones carrying that name. Duplicate frame numbers
+ * cannot be represented; fromRows() keeps the first and reports the loss.
+ */
+class FrameZoneTable
+{
+public:
+    struct Zone {
+        int startFrame = 0;
+        int endFrame = 0;       // inclusive
+        int spacing = 0;        // mm
+        QString ml;
+        QString frameName;      // only for single-frame zones with a custom name, empty otherwise
+    };
+
+    FrameZoneTable() = default;
+
+    void setZones(const QVector<Zone> &zones);
+    const QVector<Zone> &zones() const { return m_zones; }
+    int zoneCount() const { return m_zones.size(); }
+    int rowCount() const { return m_rowCount; }
+
+    // Row i of the expanded table (ascending frame numbers), coordinates included
+    FrameCoordinates::FrameRow row(int index, double lpp, double upperL) const;
+    // Expanded row index of a frame number, -1 when no zone covers it
+    int indexOfFrame(int frameNumber) const;
+
+    static FrameZoneTable fromRows(QVector<FrameCoordinates::FrameRow> rows, bool *lossless = nullptr);
+    QVector<FrameCoordinates::FrameRow> toRows(double lpp, double upperL) const;
+
+    static QString defaultFrameName(int frameNumber);
+
+private:
+    QVector<Zone> m_zones;          // sorted by startFrame, non-overlapping
+    QVector<int> m_firstRow;        // expanded row index of each zone's first frame
+    QVector<double> m_startXp;      // xp (m) of each zone's first frame
+    int m_rowCount = 0;
+
+    int zoneOfRow(int index) const;
+    double positionInZone(int zoneIndex, int frameNumber) const;
+};
+
+#endif // FRAMEZONETABLE_H
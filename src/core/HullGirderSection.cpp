@@ -0,0 +1,218 @@
+#include "HullGirderSection.h"
+#include <algorithm>
+#include <cmath>
+
+HullGirderSection::HullGirderSection()
+    : m_halfWidthMM(24384.0 / 2.0),
+      m_depthMM(5490.0),
+      m_keelZ(0.0),
+      m_deckZ(5490.0),
+      m_expanded(0)
+{
+}
+
+void HullGirderSection::setOutline(double halfWidthMM, double depthMM)
+{
+    if (halfWidthMM == m_halfWidthMM && depthMM == m_depthMM) return;
+    m_halfWidthMM = halfWidthMM;
+    m_depthMM = depthMM;
+    if (m_hull.isEmpty()) {
+        m_keelZ = 0.0;
+        m_deckZ = m_depthMM;
+        expandAll();
+    }
+}
+
+void HullGirderSection::setHullPolygon(const QVector<QPointF> &polygon)
+{
+    if (polygon == m_hull) return;
+    m_hull = polygon;
+    m_keelZ = 0.0;
+    m_deckZ = m_depthMM;
+    if (!m_hull.isEmpty()) {
+        const auto [lo, hi] = std::minmax_element(m_hull.begin(), m_hull.end(),
+                                                  [](const QPointF &a, const QPointF &b) { return a.y() < b.y(); });
+        m_keelZ = lo->y();
+        m_deckZ = hi->y();
+    }
+    expandAll();
+}
+
+void HullGirderSection::setMembers(const QHash<QString, Member> &byPrefix, const Member &defaultMember)
+{
+    const QHash<QString, Member> oldMembers = m_members;
+    const Member oldDefault = m_default;
+    m_members = byPrefix;
+    m_default = defaultMember;
+
+    // Only rows whose prefix now maps to a different member are expanded again
+    for (auto it = m_rows.constBegin(); it != m_rows.constEnd(); ++it) {
+        const QString &prefix = it.value().prefix;
+        if (oldMembers.value(prefix, oldDefault) != memberOf(prefix))
+            m_sums.insert(it.key(), expand(it.value()));
+    }
+}
+
+bool HullGirderSection::setRow(int id, const YZLineGeometry::Row &row)
+{
+    const auto it = m_rows.constFind(id);
+    if (it != m_rows.constEnd() && it.value() == row) return false;
+    m_rows.insert(id, row);
+    m_sums.insert(id, expand(row));
+    return true;
+}
+
+bool HullGirderSection::removeRow(int id)
+{
+    m_sums.remove(id);
+    return m_rows.remove(id) > 0;
+}
+
+void HullGirderSection::clear()
+{
+    m_rows.clear();
+    m_sums.clear();
+}
+
+HullGirderSection::Member HullGirderSection::memberOf(const QString &prefix) const
+{
+    return m_members.value(prefix, m_default);
+}
+
+// Parts of a line inside the boundary: the hull section, or the B x D rectangle
+QVector<HullSection::Span> HullGirderSection::boundarySpans(quint8 axis, double pos) const
+{
+    if (!m_hull.isEmpty())
+        return HullSection::clipLine(m_hull, axis, pos);
+
+    QVector<HullSection::Span> spans;
+    if (axis == YZLineGeometry::Horizontal) {
+        if (pos >= 0.0 && pos <= m_depthMM)
+            spans.append({ -m_halfWidthMM, m_halfWidthMM });
+    } else if (std::fabs(pos) <= m_halfWidthMM) {
+        spans.append({ 0.0, m_depthMM });
+    }
+    return spans;
+}
+
+HullGirderSection::Sums HullGirderSection::expand(const YZLineGeometry::Row &row)
+{
+    ++m_expanded;
+    Sums sums;
+    const quint8 sides = YZLineGeometry::sideMask(row.sym);
+    if (row.count <= 0 || sides == 0 || row.hasY == row.hasZ) return sums;
+
+    const Member member = memberOf(row.prefix);
+    const double stiffenerArea = member.areaCm2 * 100.0;       // cm2 -> mm2
+    const double stiffenerOwn = member.inertiaCm4 * 1.0e4;     // cm4 -> mm4
+    const double t = member.plateThicknessMM;
+    const double width = std::max(0.0, row.spacing);
+    const double plateArea = t * width;
+
+    m_area.clear();
+    m_lever.clear();
+    m_own.clear();
+    auto add = [this](double area, double lever, double own) {
+        if (area <= 0.0) return;
+        m_area.append(area);
+        m_lever.append(lever);
+        m_own.append(own);
+    };
+
+    const double start = row.hasZ ? row.z : row.y;
+    for (int i = 0; i < row.count; ++i) {
+        const double pos = start + i * row.spacing;
+        const QVector<HullSection::Span> spans = boundarySpans(row.hasZ ? YZLineGeometry::Horizontal
+                                                                        : YZLineGeometry::Vertical,
+                                                               row.hasZ ? pos : std::fabs(pos));
+        if (spans.isEmpty()) continue;
+        if (row.hasZ) {
+            // Side longitudinals at height pos, at the outermost crossing of each side; plating
+            // is a vertical strip, the stiffener web is horizontal and its own inertia about a
+            // horizontal axis is neglected
+            const double port = spans.first().from;
+            const double starboard = spans.last().to;
+            const int copies = ((sides & YZLineGeometry::Port) && port < 0.0 ? 1 : 0)
+                             + ((sides & YZLineGeometry::Starboard) && starboard > 0.0 ? 1 : 0);
+            for (int c = 0; c < copies; ++c) {
+                add(stiffenerArea, pos, 0.0);
+                add(plateArea, pos, t * width * width * width / 12.0);
+            }
+            if (plateArea <= 0.0) sums.unplated += copies;
+        } else {
+            // Bottom longitudinal above the lowest crossing or deck longitudinal below the
+            // highest one, at |y|; a P+S line on the centerline is one longitudinal
+            const double v = std::fabs(pos);
+            const int copies = (v == 0.0) ? 1
+                             : ((sides & YZLineGeometry::Port) ? 1 : 0) + ((sides & YZLineGeometry::Starboard) ? 1 : 0);
+            const bool deck = member.placement == Deck;
+            const double plateZ = deck ? spans.last().to : spans.first().from;
+            const double stiffenerZ = deck ? plateZ - member.eMM : plateZ + member.eMM;
+            for (int c = 0; c < copies; ++c) {
+                add(stiffenerArea, stiffenerZ, stiffenerOwn);
+                add(plateArea, plateZ, width * t * t * t / 12.0);
+            }
+            if (plateArea <= 0.0) sums.unplated += copies;
+        }
+    }
+
+    // Flat reduction over the element arrays
+    const int n = m_area.size();
+    const double *area = m_area.constData();
+    const double *lever = m_lever.constData();
+    const double *own = m_own.constData();
+    double sumA = 0.0, sumAz = 0.0, sumAzz = 0.0, sumOwn = 0.0;
+    for (int k = 0; k < n; ++k) {
+        const double az = area[k] * lever[k];
+        sumA += area[k];
+        sumAz += az;
+        sumAzz += az * lever[k];
+        sumOwn += own[k];
+    }
+    sums.area = sumA;
+    sums.moment = sumAz;
+    sums.second = sumAzz;
+    sums.own = sumOwn;
+    sums.elements = n;
+    return sums;
+}
+
+void HullGirderSection::expandAll()
+{
+    for (auto it = m_rows.constBegin(); it != m_rows.constEnd(); ++it)
+        m_sums.insert(it.key(), expand(it.value()));
+}
+
+HullGirderSection::Result HullGirderSection::result() const
+{
+    Sums total;
+    for (const Sums &s : m_sums) {
+        total.area += s.area;
+        total.moment += s.moment;
+        total.second += s.second;
+        total.own += s.own;
+        total.elements += s.elements;
+        total.unplated += s.unplated;
+    }
+
+    Result r;
+    r.elements = total.elements;
+    r.unplated = total.unplated;
+    if (total.area <= 0.0) return r;
+
+    const double na = total.moment / total.area;
+    const double inertia = std::max(0.0, total.own + total.second - total.area * na * na);
+    r.valid = true;
+    r.areaM2 = total.area * 1.0e-6;
+    r.neutralAxisM = na * 1.0e-3;
+    r.inertiaM4 = inertia * 1.0e-12;
+    if (m_deckZ > na) r.modulusDeckM3 = inertia / (m_deckZ - na) * 1.0e-9;
+    if (na > m_keelZ) r.modulusKeelM3 = inertia / (na - m_keelZ) * 1.0e-9;
+    return r;
+}
+
+QString HullGirderSection::scope()
+{
+    return QStringLiteral("YZ longitudinals and their row-spacing plate strips only; "
+                          "shell and deck plating outside the rows and on single-line rows is not included");
+}
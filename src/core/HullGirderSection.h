@@ -0,0 +1,119 @@
+#ifndef HULLGIRDERSECTION_H
+#define HULLGIRDERSECTION_H
+
+#include <QHash>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include "YZLineGeometry.h"
+#include "HullSection.h"
+
+/**
+ * Hull girder section properties of one frame from its YZ longitudinals.
+ *
+ * Each YZ line stands for one longitudinal per side where it meets the hull boundary: a
+ * vertical line (constant y) at the bottom or at the deck, as its prefix's member says, a
+ * horizontal line (constant z) at the outermost side shell crossing on the sides named by
+ * Sym. The boundary is the frame's hull section when one is set, otherwise the B x D
+ * rectangle. Every such point gets the bare stiffener of its prefix and a plate strip as
+ * wide as the row spacing, so the profile's own inertia must not include attached plating.
+ *
+ * The section therefore holds longitudinals and their plate strips only. Shell and deck
+ * plating between or beyond the YZ rows is not modelled, and a single-line row (spacing 0)
+ * has no strip width, so its longitudinals carry no plating; Result::unplated counts them.
+ *
+ * Elements are expanded per row into flat area / lever / own-inertia arrays and reduced to
+ * four sums per row. Changing one row re-expands only that row; the totals are re-added from
+ * the per-row sums. Units: mm internally, profile library values in cm2 / cm4.
+ */
+class HullGirderSection
+{
+public:
+    // Where the vertical lines of a prefix meet the hull; horizontal lines are always side
+    // longitudinals
+    enum Placement : quint8 {
+        Bottom = 0,
+        Deck = 1
+    };
+
+    // Stiffener and plating of one prefix
+    struct Member {
+        double areaCm2 = 0.0;           // profile area
+        double eMM = 0.0;               // profile centroid from the plating
+        double inertiaCm4 = 0.0;        // bare profile own moment of inertia
+        double plateThicknessMM = 0.0;  // attached plating, 0 = none
+        Placement placement = Bottom;
+
+        bool operator==(const Member &o) const {
+            return areaCm2 == o.areaCm2 && eMM == o.eMM && inertiaCm4 == o.inertiaCm4
+                   && plateThicknessMM == o.plateThicknessMM && placement == o.placement;
+        }
+        bool operator!=(const Member &o) const { return !(*this == o); }
+    };
+
+    struct Result {
+        bool valid = false;             // false without any element area
+        int elements = 0;
+        double areaM2 = 0.0;
+        double neutralAxisM = 0.0;      // above base line
+        double inertiaM4 = 0.0;         // about the neutral axis
+        double modulusDeckM3 = 0.0;
+        double modulusKeelM3 = 0.0;
+        int unplated = 0;               // longitudinals without a plate strip
+    };
+
+    HullGirderSection();
+
+    // Changing the boundary re-expands every row
+    void setOutline(double halfWidthMM, double depthMM);
+    void setHullPolygon(const QVector<QPointF> &polygon);
+    // Members by prefix; prefixes without one get plate strips of defaultMember only
+    void setMembers(const QHash<QString, Member> &byPrefix, const Member &defaultMember);
+
+    // Adds or replaces the row with this id; returns false when nothing changed
+    bool setRow(int id, const YZLineGeometry::Row &row);
+    bool removeRow(int id);
+    void clear();
+    QVector<int> rowIds() const { return m_rows.keys(); }
+    int rowCount() const { return m_rows.size(); }
+    // Rows re-expanded since the counter was last reset (incremental-update check)
+    int expandedRows() const { return m_expanded; }
+    void resetExpandedRows() { m_expanded = 0; }
+
+    Result result() const;
+    // One-line statement of what the section includes, for reports
+    static QString scope();
+
+private:
+    struct Sums {
+        double area = 0.0;      // sum A, mm2
+        double moment = 0.0;    // sum A z, mm3
+        double second = 0.0;    // sum A z^2, mm4
+        double own = 0.0;       // sum own I, mm4
+        int elements = 0;
+        int unplated = 0;       // longitudinals without plate area
+    };
+
+    double m_halfWidthMM;
+    double m_depthMM;
+    QVector<QPointF> m_hull;
+    double m_keelZ;
+    double m_deckZ;
+    QHash<QString, Member> m_members;
+    Member m_default;
+    QHash<int, YZLineGeometry::Row> m_rows;
+    QHash<int, Sums> m_sums;
+    int m_expanded;
+
+    // Scratch element arrays, reused between rows
+    QVector<double> m_area;
+    QVector<double> m_lever;
+    QVector<double> m_own;
+
+    Member memberOf(const QString &prefix) const;
+    QVector<HullSection::Span> boundarySpans(quint8 axis, double pos) const;
+    Sums expand(const YZLineGeometry::Row &row);
+    void expandAll();
+};
+
+#endif // HULLGIRDERSECTION_H
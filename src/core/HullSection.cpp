@@ -0,0 +1,218 @@
+#include "HullSection.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Lines this close (mm) outside the top or outer edge of a section still count as on it
+static const double kOnBoundary = 0.5;
+
+void HullSection::setOffsets(const QVector<Offset> &offsets)
+{
+    m_stations.clear();
+
+    QVector<Offset> sorted = offsets;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Offset &a, const Offset &b) {
+        return a.x < b.x || (a.x == b.x && a.z < b.z);
+    });
+
+    for (const Offset &offset : sorted) {
+        if (m_stations.isEmpty() || m_stations.last().x != offset.x) {
+            Station station;
+            station.x = offset.x;
+            m_stations.append(station);
+        }
+        Station &station = m_stations.last();
+        // A repeated waterline keeps the last half breadth
+        if (!station.z.isEmpty() && station.z.last() == offset.z) {
+            station.halfBreadth.last() = std::max(0.0, offset.halfBreadth);
+            continue;
+        }
+        station.z.append(offset.z);
+        station.halfBreadth.append(std::max(0.0, offset.halfBreadth));
+    }
+}
+
+double HullSection::halfBreadthAt(const Station &station, double z)
+{
+    const QVector<double> &zs = station.z;
+    if (z <= zs.first()) return station.halfBreadth.first();
+    if (z >= zs.last()) return station.halfBreadth.last();
+    const int i = int(std::upper_bound(zs.begin(), zs.end(), z) - zs.begin());
+    const double t = (z - zs.at(i - 1)) / (zs.at(i) - zs.at(i - 1));
+    return station.halfBreadth.at(i - 1) + t * (station.halfBreadth.at(i) - station.halfBreadth.at(i - 1));
+}
+
+QVector<QPointF> HullSection::polygonAt(double x) const
+{
+    QVector<QPointF> polygon;
+    if (m_stations.isEmpty()) return polygon;
+
+    // Neighbouring stations and the blend factor between them
+    const auto after = std::upper_bound(m_stations.begin(), m_stations.end(), x,
+                                        [](double v, const Station &s) { return v < s.x; });
+    const Station *a = &m_stations.first();
+    const Station *b = a;
+    double t = 0.0;
+    if (after == m_stations.end()) {
+        a = b = &m_stations.last();
+    } else if (after != m_stations.begin()) {
+        b = &*after;
+        a = &*(after - 1);
+        t = (x - a->x) / (b->x - a->x);
+    }
+
+    // Waterlines of both stations, so no knuckle of either is lost
+    QVector<double> zs = a->z;
+    if (b != a) {
+        zs += b->z;
+        std::sort(zs.begin(), zs.end());
+        zs.erase(std::unique(zs.begin(), zs.end()), zs.end());
+    }
+
+    polygon.reserve(2 * zs.size());
+    QVector<double> halfBreadths(zs.size());
+    for (int i = 0; i < zs.size(); ++i) {
+        halfBreadths[i] = (1.0 - t) * halfBreadthAt(*a, zs.at(i)) + t * halfBreadthAt(*b, zs.at(i));
+        polygon.append(QPointF(halfBreadths.at(i), zs.at(i)));
+    }
+    for (int i = zs.size() - 1; i >= 0; --i) {
+        if (halfBreadths.at(i) > 0.0)
+            polygon.append(QPointF(-halfBreadths.at(i), zs.at(i)));
+    }
+    return polygon;
+}
+
+QVector<HullSection::Span> HullSection::clipLine(const QVector<QPointF> &polygon, quint8 axis, double pos)
+{
+    QVector<Span> spans;
+    const int n = polygon.size();
+    if (n < 3) return spans;
+
+    // across: the coordinate pos is given in, along: the coordinate of the spans
+    const bool horizontal = (axis == YZLineGeometry::Horizontal);
+    auto across = [horizontal](const QPointF &p) { return horizontal ? p.y() : p.x(); };
+    auto along = [horizontal](const QPointF &p) { return horizontal ? p.x() : p.y(); };
+
+    // Edges are half-open at their upper end, so a line exactly on the top (or outer) edge
+    // would find no crossing; move it just inside
+    double hi = -std::numeric_limits<double>::infinity();
+    for (const QPointF &p : polygon)
+        hi = std::max(hi, across(p));
+    double at = pos;
+    if (at >= hi && at - hi <= kOnBoundary)
+        at = hi - 1e-3;
+
+    QVector<double> cuts;
+    for (int i = 0; i < n; ++i) {
+        const QPointF &p = polygon.at(i);
+        const QPointF &q = polygon.at((i + 1) % n);
+        const double cp = across(p), cq = across(q);
+        if ((cp <= at) == (cq <= at)) continue;
+        cuts.append(along(p) + (at - cp) * (along(q) - along(p)) / (cq - cp));
+    }
+    std::sort(cuts.begin(), cuts.end());
+
+    for (int k = 0; k + 1 < cuts.size(); k += 2) {
+        if (cuts.at(k) < cuts.at(k + 1))
+            spans.append({ cuts.at(k), cuts.at(k + 1) });
+    }
+    return spans;
+}
+
+void HullSectionCache::setSection(const HullSection &section)
+{
+    m_section = section;
+    m_frames.clear();
+}
+
+void HullSectionCache::setFramePositions(const QHash<int, double> &xpByFrame)
+{
+    for (auto it = m_frames.begin(); it != m_frames.end();) {
+        const auto moved = xpByFrame.constFind(it.key());
+        if (moved == xpByFrame.constEnd() || *moved != m_xp.value(it.key()))
+            it = m_frames.erase(it);
+        else
+            ++it;
+    }
+    m_xp = xpByFrame;
+}
+
+bool HullSectionCache::hasFrame(int frameNo) const
+{
+    return !m_section.isEmpty() && m_xp.contains(frameNo);
+}
+
+HullSectionCache::Frame &HullSectionCache::frame(int frameNo)
+{
+    Frame &f = m_frames[frameNo];
+    if (!f.built) {
+        f.polygon = m_section.polygonAt(m_xp.value(frameNo));
+        f.built = true;
+    }
+    return f;
+}
+
+QVector<QPointF> HullSectionCache::polygon(int frameNo)
+{
+    if (!hasFrame(frameNo)) return QVector<QPointF>();
+    return frame(frameNo).polygon;
+}
+
+QVector<HullSection::Span> HullSectionCache::clip(int frameNo, quint8 axis, double pos)
+{
+    if (!hasFrame(frameNo)) return QVector<HullSection::Span>();
+
+    Frame &f = frame(frameNo);
+    auto &cache = (axis == YZLineGeometry::Horizontal) ? f.horizontal : f.vertical;
+    const qint64 key = qRound64(pos * 1000.0);
+    auto it = cache.find(key);
+    if (it == cache.end())
+        it = cache.insert(key, HullSection::clipLine(f.polygon, axis, pos));
+    return *it;
+}
+
+HullSectionCache::LineClip HullSectionCache::clipGeometry(const YZLineGeometry &geometry, int fallbackFrame)
+{
+    LineClip result;
+    const int n = geometry.lineCount();
+    const double inf = std::numeric_limits<double>::infinity();
+    const HullSection::Span unbounded = { -inf, inf };
+
+    bool clipped = false;
+    result.offsets.reserve(n + 1);
+    result.offsets.append(0);
+    for (int i = 0; i < n; ++i) {
+        const int rowFrame = geometry.frames().at(i);
+        const int frameNo = rowFrame >= 0 ? rowFrame : fallbackFrame;
+        if (hasFrame(frameNo)) {
+            const quint8 axis = geometry.axes().at(i);
+            const double pos = geometry.positions().at(i);
+            result.spans += clip(frameNo, axis, axis == YZLineGeometry::Vertical ? std::fabs(pos) : pos);
+            clipped = true;
+        } else {
+            result.spans.append(unbounded);
+        }
+        result.offsets.append(result.spans.size());
+    }
+    return clipped ? result : LineClip();
+}
+
+double HullSectionCache::length(int frameNo, quint8 axis, quint8 sides, double pos)
+{
+    double total = 0.0;
+    if (axis == YZLineGeometry::Horizontal) {
+        // Port half is y <= 0, starboard half y >= 0
+        for (const HullSection::Span &span : clip(frameNo, axis, pos)) {
+            if (sides & YZLineGeometry::Port)
+                total += std::max(0.0, std::min(span.to, 0.0) - span.from);
+            if (sides & YZLineGeometry::Starboard)
+                total += std::max(0.0, span.to - std::max(span.from, 0.0));
+        }
+        return total;
+    }
+
+    for (const HullSection::Span &span : clip(frameNo, axis, std::fabs(pos)))
+        total += span.to - span.from;
+    const int count = ((sides & YZLineGeometry::Port) ? 1 : 0) + ((sides & YZLineGeometry::Starboard) ? 1 : 0);
+    return total * count;
+}
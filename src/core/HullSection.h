@@ -0,0 +1,109 @@
+#ifndef HULLSECTION_H
+#define HULLSECTION_H
+
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+#include "YZLineGeometry.h"
+
+/**
+ * Hull section polygons from an offset table.
+ *
+ * An offset is a half breadth at height z on a station at x; stations are interpolated
+ * linearly in x, so any frame gets its section from its xpCoor. A section polygon is in
+ * section mm (y to starboard, z up): the starboard side from the lowest waterline up, then
+ * the mirrored port side back down, closed across the top (deck) and the bottom.
+ */
+class HullSection
+{
+public:
+    struct Offset {
+        double x = 0.0;             // station position, m (same datum as xpCoor)
+        double z = 0.0;             // height above base line, mm
+        double halfBreadth = 0.0;   // mm
+    };
+
+    // Part of a line inside the section, mm along the line (y for horizontal, z for vertical)
+    struct Span {
+        double from = 0.0;
+        double to = 0.0;
+        bool operator==(const Span &other) const { return from == other.from && to == other.to; }
+    };
+
+    void setOffsets(const QVector<Offset> &offsets);
+    bool isEmpty() const { return m_stations.isEmpty(); }
+    int stationCount() const { return m_stations.size(); }
+
+    // Section at x; before the first / after the last station the end station is used
+    QVector<QPointF> polygonAt(double x) const;
+
+    // Parts of the axis-parallel line at pos (z for horizontal, y for vertical) inside the
+    // polygon by the even-odd rule, ascending. A line on the top or outer edge counts as inside.
+    static QVector<Span> clipLine(const QVector<QPointF> &polygon, quint8 axis, double pos);
+
+private:
+    struct Station {
+        double x = 0.0;
+        QVector<double> z;              // ascending
+        QVector<double> halfBreadth;
+    };
+
+    QVector<Station> m_stations;        // ascending x
+
+    static double halfBreadthAt(const Station &station, double z);
+};
+
+/**
+ * Per-frame hull sections and clipped longitudinals.
+ *
+ * A frame's polygon is built from the offset table on first use and kept together with the
+ * clip results of every line position asked for on that frame, so redrawing or summing the
+ * lengths of a frame's longitudinals is a hash lookup. Changing the offsets drops everything,
+ * moving frames drops only the frames whose position changed.
+ */
+class HullSectionCache
+{
+public:
+    // Spans of geometry line i: spans[offsets[i]] .. spans[offsets[i + 1] - 1]. A line whose
+    // frame has no section gets one unbounded span, so it is drawn in full.
+    struct LineClip {
+        QVector<int> offsets;
+        QVector<HullSection::Span> spans;
+        bool isEmpty() const { return offsets.isEmpty(); }
+        bool operator==(const LineClip &o) const { return offsets == o.offsets && spans == o.spans; }
+        bool operator!=(const LineClip &o) const { return !(*this == o); }
+    };
+
+    void setSection(const HullSection &section);
+    // xpCoor (m) per frame number
+    void setFramePositions(const QHash<int, double> &xpByFrame);
+
+    const HullSection &section() const { return m_section; }
+    // True when the offsets are known and the frame has a position
+    bool hasFrame(int frameNo) const;
+
+    QVector<QPointF> polygon(int frameNo);
+    QVector<HullSection::Span> clip(int frameNo, quint8 axis, double pos);
+    // Every line of a geometry on its own row's frame, or on fallbackFrame when the row has
+    // none (vertical lines by |y|, the section is symmetric). Empty when no line has a section.
+    LineClip clipGeometry(const YZLineGeometry &geometry, int fallbackFrame = -1);
+    // Length (mm) inside the hull of a line on the given sides (YZLineGeometry::Side bits)
+    double length(int frameNo, quint8 axis, quint8 sides, double pos);
+
+private:
+    struct Frame {
+        bool built = false;
+        QVector<QPointF> polygon;
+        QHash<qint64, QVector<HullSection::Span>> horizontal;  // by z in um
+        QHash<qint64, QVector<HullSection::Span>> vertical;    // by y in um
+    };
+
+    HullSection m_section;
+    QHash<int, double> m_xp;
+    QHash<int, Frame> m_frames;
+
+    Frame &frame(int frameNo);
+};
+
+#endif // HULLSECTION_H
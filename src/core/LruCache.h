@@ -0,0 +1,80 @@
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <QHash>
+#include <QtGlobal>
+#include <algorithm>
+#include <list>
+#include <utility>
+
+/**
+ * Bounded memo cache with least-recently-used eviction and hit/miss counters.
+ *
+ * Entries sit in a recency list (most recent first) indexed by a hash on the key, so
+ * find() and insert() are O(1); a hit moves the entry to the front and an insert past
+ * the capacity drops the entry at the back. Key needs operator== and qHash().
+ */
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+    explicit LruCache(int capacity) : m_capacity(std::max(1, capacity)) {}
+
+    // Cached value, or nullptr; counts a hit or a miss. The pointer is valid until the
+    // next insert() or clear().
+    const Value *find(const Key &key)
+    {
+        const auto it = m_index.constFind(key);
+        if (it == m_index.constEnd()) {
+            ++m_misses;
+            return nullptr;
+        }
+        ++m_hits;
+        m_entries.splice(m_entries.begin(), m_entries, it.value());
+        return &it.value()->second;
+    }
+
+    void insert(const Key &key, const Value &value)
+    {
+        const auto it = m_index.constFind(key);
+        if (it != m_index.constEnd()) {
+            it.value()->second = value;
+            m_entries.splice(m_entries.begin(), m_entries, it.value());
+            return;
+        }
+        m_entries.emplace_front(key, value);
+        m_index.insert(key, m_entries.begin());
+        if (m_index.size() > m_capacity) {
+            m_index.remove(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+    }
+    void resetCounters() { m_hits = m_misses = 0; }
+
+    int size() const { return m_index.size(); }
+    int capacity() const { return m_capacity; }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+    double hitRate() const
+    {
+        const quint64 total = m_hits + m_misses;
+        return total > 0 ? double(m_hits) / double(total) : 0.0;
+    }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    int m_capacity;
+    std::list<Entry> m_entries;     // most recently used first
+    QHash<Key, typename std::list<Entry>::iterator> m_index;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+};
+
+#endif // LRUCACHE_H
@@ -0,0 +1,221 @@
+#include "ProfileFormulas.h"
+#include <cmath>
+#include <algorithm>
+
+namespace ProfileFormulas {
+
+namespace {
+
+double round2(double value)
+{
+    return std::round(value * 100.0) / 100.0;
+}
+
+// Unrounded section properties of a stiffener with attached plating (40 * tw wide)
+SectionProperties computeSection(double hw, double tw, double bf, double tf, const QString &type)
+{
+    double hw_cm = hw / 10.0;
+    double tw_cm = tw / 10.0;
+    double bf_cm = bf / 10.0;
+    double tf_cm = tf / 10.0;
+    double attch_plate_cm = tw / 10.0;
+    double AttchX = 40.0 * attch_plate_cm;
+
+    // Count area
+    double FaceX = bf_cm;
+    double WebX = tw_cm;
+
+    double FaceY = tf_cm;
+    double WebY = hw_cm - tf_cm;
+
+    double AttchY = tw / 10.0;
+    double FaceZ = (0.5 * FaceY) + WebY;
+    double WebZ = 0.5 * WebY;
+    double FaceZ2 = (0.5 * FaceY) + WebY + AttchY;
+    double WebZ2 = 0.5 * WebY + AttchY;
+
+    double AttchZ = 0.5 * AttchY;
+    double FaceA = FaceX * FaceY;
+    double FaceAZ = FaceA * FaceZ;
+    double FaceAZ2 = FaceA * FaceZ2;
+    double FaceAzZ = FaceAZ2 * FaceZ2;
+    double FaceI = (FaceX * pow(FaceY, 3.0)) / 12.0;
+
+    double WebA = WebX * WebY;
+    double WebAZ = WebA * WebZ;
+    double WebAZ2 = WebA * WebZ2;
+    double WebAzZ = WebAZ2 * WebZ2;
+
+    double WebI = (WebX * pow(WebY, 3.0)) / 12.0;
+    double AttchA = AttchX * AttchY;
+    double AttchAZ = AttchA * AttchZ;
+    double AttchAzZ = AttchAZ * AttchZ;
+    double AttchI = (AttchX * pow(AttchY, 3.0)) / 12.0;
+
+    SectionProperties result;
+
+    // Final area
+    result.area = FaceA + WebA;
+
+    // Count e
+    result.e = 10.0 * (FaceAZ + WebAZ) / (FaceA + WebA);
+
+    // Count upper_i
+    double z12 = (FaceAZ2 + WebAZ2 + AttchAZ) / (FaceA + WebA + AttchA);
+    double z2 = hw_cm + attch_plate_cm - z12;
+    double sigmaAzz = FaceAzZ + WebAzZ + AttchAzZ;
+    double sigmaUpperI = FaceI + WebI + AttchI;
+    double sigmaA = FaceA + WebA + AttchA;
+    double inertia_section = (sigmaAzz + sigmaUpperI) - (sigmaA * pow(z12, 2.0));
+    result.upperI = inertia_section;
+
+    // Count moduli actual
+    double moduli_actual;
+    if (type == "HP") {
+        moduli_actual = 2.1445 * std::min(inertia_section / z12, inertia_section / z2);
+    } else {
+        moduli_actual = std::min(inertia_section / z12, inertia_section / z2);
+    }
+
+    // Count moduli ksp
+    if (type == "Bar" || type == "T" || type == "FB") {
+        result.w = moduli_actual / 1.0;
+    } else if (type == "HP") {
+        result.w = moduli_actual / 1.03;
+    } else if (type == "L") {
+        result.w = moduli_actual / 1.15;
+    } else {
+        result.w = 0.0;
+    }
+
+    return result;
+}
+
+// Unrounded bracket sizes
+BracketSizes computeBrackets(double tw, double W, double rehProfile, double rehBracket)
+{
+    // Coefficients
+    double k1 = 235.0 / rehProfile;
+    double k2 = 235.0 / rehBracket;
+    double c = 1.2;
+    double ct = 1.0;
+
+    double tmax = tw;
+    double bmin = 50.0;
+    double bmax = 90.0;
+
+    // t bracket, tb=tbf
+    double tnet = c * pow(W / k1, 1.0/3.0);
+
+    // tk = Piecewise((1.5,tnet<10),((Min(3,0.1*tnet/sqrt(k1))),True))
+    double tk;
+    if (tnet < 10.0) {
+        tk = 1.5;
+    } else {
+        tk = std::min(3.0, 0.1 * tnet / sqrt(k1));
+    }
+
+    double tmin = 5.0 + tk;
+    double a = tnet + tk;
+    double tfull = ceil(a * 10.0) / 10.0;
+
+    // Output t yang diambil - t = Piecewise((tmin, tfull < tmin), (tmax, tfull > tmax), (tfull, True))
+    double t;
+    if (tfull < tmin) {
+        t = tmin;
+    } else if (tfull > tmax) {
+        t = tmax;
+    } else {
+        t = tfull;
+    }
+
+    BracketSizes result;
+    result.tb = t;
+    result.tbf = t;
+
+    // l bracket - l = ceiling(lreq)
+    double lreq = 46.2 * pow(W / k1, 1.0/3.0) * sqrt(k2) * ct;
+    result.l = ceil(lreq);
+
+    // bf bracket - bf = Piecewise((bmin,breq<bmin),(bmax,breq>bmax),(breq,True))
+    double breq = 40.0 + W / 30.0;
+    if (breq < bmin) {
+        result.bf = bmin;
+    } else if (breq > bmax) {
+        result.bf = bmax;
+    } else {
+        result.bf = breq;
+    }
+
+    return result;
+}
+
+double keepOr(double existing, double computed)
+{
+    return existing == 0.0 ? computed : existing;
+}
+
+} // namespace
+
+SectionProperties sectionProperties(double hw, double tw, double bf, double tf, const QString &type)
+{
+    SectionProperties result = computeSection(hw, tw, bf, tf, type);
+    result.area = round2(result.area);
+    result.e = round2(result.e);
+    result.w = round2(result.w);
+    result.upperI = round2(result.upperI);
+    return result;
+}
+
+SectionProperties sectionPropertiesEdit(double hw, double tw, double bf, double tf,
+                                        const SectionProperties &existing, const QString &type)
+{
+    const SectionProperties computed = computeSection(hw, tw, bf, tf, type);
+    SectionProperties result;
+    result.area = round2(keepOr(existing.area, computed.area));
+    result.e = round2(keepOr(existing.e, computed.e));
+    result.w = round2(keepOr(existing.w, computed.w));
+    result.upperI = round2(keepOr(existing.upperI, computed.upperI));
+    return result;
+}
+
+double profileInertia(double hw, double tw, double bf, double tf)
+{
+    // Same face and web split as computeSection(), levers from the plating side of the web
+    const double faceA = (bf / 10.0) * (tf / 10.0);
+    const double webY = (hw - tf) / 10.0;
+    const double webA = (tw / 10.0) * webY;
+    const double area = faceA + webA;
+    if (area <= 0.0)
+        return 0.0;
+
+    const double faceZ = 0.5 * (tf / 10.0) + webY;
+    const double webZ = 0.5 * webY;
+    const double z = (faceA * faceZ + webA * webZ) / area;
+    const double own = (bf / 10.0) * std::pow(tf / 10.0, 3.0) / 12.0 + (tw / 10.0) * std::pow(webY, 3.0) / 12.0;
+    return round2(own + faceA * faceZ * faceZ + webA * webZ * webZ - area * z * z);
+}
+
+BracketSizes bracketSizes(double tw, double W, double rehProfile, double rehBracket)
+{
+    BracketSizes result = computeBrackets(tw, W, rehProfile, rehBracket);
+    result.l = round2(result.l);
+    result.tb = round2(result.tb);
+    result.bf = round2(result.bf);
+    result.tbf = round2(result.tbf);
+    return result;
+}
+
+BracketSizes bracketSizesEdit(double tw, double W, double rehProfile, double rehBracket,
+                              const BracketSizes &existing)
+{
+    const BracketSizes computed = computeBrackets(tw, W, rehProfile, rehBracket);
+    BracketSizes result;
+    result.l = round2(keepOr(existing.l, computed.l));
+    result.tb = round2(keepOr(existing.tb, computed.tb));
+    result.bf = round2(keepOr(existing.bf, computed.bf));
+    result.tbf = round2(keepOr(existing.tbf, computed.tbf));
+    return result;
+}
+
+} // namespace ProfileFormulas
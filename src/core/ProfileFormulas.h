@@ -0,0 +1,49 @@
+#ifndef PROFILEFORMULAS_H
+#define PROFILEFORMULAS_H
+
+#include <QString>
+
+/**
+ * Section property and bracket formulas for the profile table.
+ *
+ * Plain functions without QObject/QML dependencies, shared by
+ * StructureProfileTableController and the dewaruci-cli batch tool.
+ * All results are rounded to 2 decimal places.
+ */
+namespace ProfileFormulas {
+
+struct SectionProperties {
+    double area = 0.0;      // cm2
+    double e = 0.0;         // mm
+    double w = 0.0;         // cm3
+    double upperI = 0.0;    // cm4
+};
+
+struct BracketSizes {
+    double l = 0.0;         // mm
+    double tb = 0.0;        // mm
+    double bf = 0.0;        // mm
+    double tbf = 0.0;       // mm
+};
+
+// hw, tw, bf, tf in mm; type is the profile type ("T", "HP", "L", "FB", "Bar")
+SectionProperties sectionProperties(double hw, double tw, double bf, double tf, const QString &type);
+
+// Like sectionProperties(), but every non-zero value in existing is kept as is
+SectionProperties sectionPropertiesEdit(double hw, double tw, double bf, double tf,
+                                        const SectionProperties &existing, const QString &type);
+
+// Own moment of inertia (cm4) of the stiffener alone (web and face, no attached plating)
+// about its centroid; hw, tw, bf, tf in mm
+double profileInertia(double hw, double tw, double bf, double tf);
+
+// tw in mm, W in cm3, ReH of profile and bracket in N/mm2
+BracketSizes bracketSizes(double tw, double W, double rehProfile, double rehBracket);
+
+// Like bracketSizes(), but every non-zero value in existing is kept as is
+BracketSizes bracketSizesEdit(double tw, double W, double rehProfile, double rehBracket,
+                              const BracketSizes &existing);
+
+} // namespace ProfileFormulas
+
+#endif // PROFILEFORMULAS_H
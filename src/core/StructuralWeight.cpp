@@ -0,0 +1,258 @@
+#include "StructuralWeight.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+
+namespace {
+
+// Mass and its first moments, reduced to a Weight at the end
+struct Sum {
+    double massKg = 0.0;
+    double momentX = 0.0;
+    double momentZ = 0.0;
+
+    void add(double mass, double momentXKgM, double momentZKgM) {
+        massKg += mass;
+        momentX += momentXKgM;
+        momentZ += momentZKgM;
+    }
+    StructuralWeight::Weight weight() const {
+        StructuralWeight::Weight w;
+        w.massKg = massKg;
+        if (massKg > 0.0) {
+            w.lcgM = momentX / massKg;
+            w.vcgM = momentZ / massKg;
+        }
+        return w;
+    }
+};
+
+}
+
+StructuralWeight::StructuralWeight()
+    : m_halfWidthMM(24384.0 / 2.0),
+      m_depthMM(5490.0),
+      m_allDirty(false),
+      m_zonesDirty(false),
+      m_expanded(0)
+{
+}
+
+void StructuralWeight::setBays(const QVector<Bay> &bays)
+{
+    if (bays == m_bays) return;
+    m_bays = bays;
+    m_zonesDirty = true;
+}
+
+void StructuralWeight::setOutline(double halfWidthMM, double depthMM)
+{
+    if (halfWidthMM == m_halfWidthMM && depthMM == m_depthMM) return;
+    m_halfWidthMM = halfWidthMM;
+    m_depthMM = depthMM;
+    m_allDirty = true;
+}
+
+void StructuralWeight::setHullPolygon(int sectionFrame, const QVector<QPointF> &polygon)
+{
+    const auto it = m_sections.constFind(sectionFrame);
+    if (it == m_sections.constEnd() ? polygon.isEmpty() : it.value().hull == polygon) return;
+    Section &section = m_sections[sectionFrame];
+    section.hull = polygon;
+    section.hullChanged = true;
+    m_dirty.insert(sectionFrame);
+}
+
+void StructuralWeight::setMembers(const QHash<QString, Member> &byPrefix, const Member &defaultMember)
+{
+    m_members = byPrefix;
+    m_default = defaultMember;
+
+    // Densities only weigh the areas again; the sections are expanded when a profile or
+    // plating changed
+    QHash<QString, HullGirderSection::Member> sectionMembers;
+    for (auto it = byPrefix.constBegin(); it != byPrefix.constEnd(); ++it)
+        sectionMembers.insert(it.key(), it.value().section);
+    if (sectionMembers != m_sectionMembers || defaultMember.section != m_sectionDefault) {
+        m_sectionMembers = sectionMembers;
+        m_sectionDefault = defaultMember.section;
+        m_allDirty = true;
+    }
+}
+
+bool StructuralWeight::setRow(int sectionFrame, int id, const YZLineGeometry::Row &row)
+{
+    const auto frame = m_frameOfRow.constFind(id);
+    if (frame != m_frameOfRow.constEnd() && frame.value() != sectionFrame)
+        removeRow(id);
+
+    Section &section = m_sections[sectionFrame];
+    const auto it = section.rows.constFind(id);
+    if (it != section.rows.constEnd() && it.value() == row) return false;
+    section.rows.insert(id, row);
+    section.changed.insert(id);
+    m_frameOfRow.insert(id, sectionFrame);
+    m_dirty.insert(sectionFrame);
+    if (section.rows.size() == 1) m_zonesDirty = true;
+    return true;
+}
+
+bool StructuralWeight::removeRow(int id)
+{
+    const auto frame = m_frameOfRow.constFind(id);
+    if (frame == m_frameOfRow.constEnd()) return false;
+    const int sectionFrame = frame.value();
+    m_frameOfRow.remove(id);
+
+    Section &section = m_sections[sectionFrame];
+    section.rows.remove(id);
+    section.changed.insert(id);
+    m_dirty.insert(sectionFrame);
+    if (section.rows.isEmpty()) m_zonesDirty = true;
+    return true;
+}
+
+QVector<int> StructuralWeight::sectionFrames() const
+{
+    QVector<int> frames;
+    for (auto it = m_sections.constBegin(); it != m_sections.constEnd(); ++it) {
+        if (!it.value().rows.isEmpty())
+            frames.append(it.key());
+    }
+    std::sort(frames.begin(), frames.end());
+    return frames;
+}
+
+StructuralWeight::Member StructuralWeight::memberOf(const QString &prefix) const
+{
+    return m_members.value(prefix, m_default);
+}
+
+// Runs on a worker thread: touches only its own section and reads the shared settings
+void StructuralWeight::refreshSection(Section &section) const
+{
+    for (const int id : section.changed) {
+        const auto row = section.rows.constFind(id);
+        const auto applied = section.appliedPrefix.constFind(id);
+        if (applied != section.appliedPrefix.constEnd()
+            && (row == section.rows.constEnd() || row.value().prefix != applied.value())) {
+            const QString oldPrefix = applied.value();
+            section.parts[oldPrefix].removeRow(id);
+            section.appliedPrefix.remove(id);
+        }
+        if (row == section.rows.constEnd()) continue;
+
+        auto part = section.parts.find(row.value().prefix);
+        if (part == section.parts.end()) {
+            part = section.parts.insert(row.value().prefix, HullGirderSection());
+            part.value().setOutline(m_halfWidthMM, m_depthMM);
+            part.value().setHullPolygon(section.hull);
+            part.value().setMembers(m_sectionMembers, m_sectionDefault);
+        }
+        part.value().setRow(id, row.value());
+        section.appliedPrefix.insert(id, row.value().prefix);
+    }
+    section.changed.clear();
+
+    section.slices.clear();
+    for (auto part = section.parts.begin(); part != section.parts.end();) {
+        if (part.value().rowCount() == 0) {
+            part = section.parts.erase(part);
+            continue;
+        }
+        HullGirderSection &girder = part.value();
+        girder.setOutline(m_halfWidthMM, m_depthMM);
+        if (section.hullChanged) girder.setHullPolygon(section.hull);
+        girder.setMembers(m_sectionMembers, m_sectionDefault);
+
+        const HullGirderSection::Result r = girder.result();
+        if (r.valid) section.slices.insert(part.key(), { r.areaM2, r.neutralAxisM });
+        section.expanded += girder.expandedRows();
+        girder.resetExpandedRows();
+        ++part;
+    }
+    section.hullChanged = false;
+}
+
+void StructuralWeight::update()
+{
+    QVector<Section *> work;
+    for (auto it = m_sections.begin(); it != m_sections.end(); ++it) {
+        if (m_allDirty || m_dirty.contains(it.key()))
+            work.append(&it.value());
+    }
+
+    QtConcurrent::blockingMap(work, [this](Section *section) { refreshSection(*section); });
+
+    for (Section *section : work) {
+        m_expanded += section->expanded;
+        section->expanded = 0;
+    }
+    m_dirty.clear();
+    m_allDirty = false;
+
+    if (m_zonesDirty) rebuildZones();
+    rebuildResult();
+}
+
+void StructuralWeight::rebuildZones()
+{
+    m_zones.clear();
+    m_zonesDirty = false;
+    const QVector<int> frames = sectionFrames();
+    if (frames.isEmpty()) return;
+
+    for (const Bay &bay : m_bays) {
+        // Governing section: the nearest one at or aft of the bay, else the first
+        const auto after = std::upper_bound(frames.begin(), frames.end(), bay.frameNo);
+        const int sectionFrame = (after == frames.begin()) ? frames.first() : *(after - 1);
+
+        const bool first = !m_zones.contains(sectionFrame);
+        ZoneExtent &zone = m_zones[sectionFrame];
+        const double length = bay.spacingMM / 1000.0;
+        zone.lengthM += length;
+        zone.momentXM2 += length * (bay.xpM + length / 2.0);
+        zone.firstFrame = first ? bay.frameNo : std::min(zone.firstFrame, bay.frameNo);
+        zone.lastFrame = first ? bay.frameNo : std::max(zone.lastFrame, bay.frameNo);
+    }
+}
+
+void StructuralWeight::rebuildResult()
+{
+    m_result = Result();
+    Sum total;
+    QMap<QString, Sum> byPrefix;
+
+    for (auto it = m_zones.constBegin(); it != m_zones.constEnd(); ++it) {
+        const ZoneExtent &extent = it.value();
+        Zone zone;
+        zone.sectionFrame = it.key();
+        zone.firstFrame = extent.firstFrame;
+        zone.lastFrame = extent.lastFrame;
+        zone.lengthM = extent.lengthM;
+
+        Sum zoneTotal;
+        const auto section = m_sections.constFind(it.key());
+        if (section != m_sections.constEnd()) {
+            const QHash<QString, Slice> &slices = section.value().slices;
+            for (auto slice = slices.constBegin(); slice != slices.constEnd(); ++slice) {
+                const double perMetre = memberOf(slice.key()).densityKgM3 * slice.value().areaM2;
+                const double mass = perMetre * extent.lengthM;
+                const double momentX = perMetre * extent.momentXM2;
+                const double momentZ = mass * slice.value().zM;
+
+                Sum prefix;
+                prefix.add(mass, momentX, momentZ);
+                zone.byPrefix.insert(slice.key(), prefix.weight());
+                zoneTotal.add(mass, momentX, momentZ);
+                byPrefix[slice.key()].add(mass, momentX, momentZ);
+                total.add(mass, momentX, momentZ);
+            }
+        }
+        zone.total = zoneTotal.weight();
+        m_result.zones.append(zone);
+    }
+
+    m_result.total = total.weight();
+    for (auto it = byPrefix.constBegin(); it != byPrefix.constEnd(); ++it)
+        m_result.byPrefix.insert(it.key(), it.value().weight());
+}
@@ -0,0 +1,143 @@
+#ifndef STRUCTURALWEIGHT_H
+#define STRUCTURALWEIGHT_H
+
+#include <QHash>
+#include <QMap>
+#include <QPointF>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include "YZLineGeometry.h"
+#include "HullGirderSection.h"
+
+/**
+ * Steel weight and centre of gravity of the longitudinal structure: the YZ longitudinals
+ * and their plate strips only, with the same plating limits as HullGirderSection.
+ *
+ * Each YZ frame number is a section; its rows are expanded like HullGirderSection does
+ * (one stiffener plus plate strip per side where a line meets the hull boundary, at the
+ * bottom or deck for vertical lines as the member's placement says), one HullGirderSection
+ * per prefix, giving a cross-sectional area and its height per prefix. A section governs
+ * the zone of XZ frames from its own frame number up to the next section (frames aft of the
+ * first section belong to the first); the zone length is the sum of those frames' spacings.
+ *
+ * Zone weight per prefix = density x area x length, its LCG the mid of the bays weighted by
+ * their length and its VCG the height of the prefix's area. Changes are staged and applied
+ * by update(): only sections with staged rows or a new hull section are expanded again, in
+ * parallel over the sections; a density change only re-adds the per-zone sums.
+ * Units: mm for section geometry, m and kg in the results.
+ */
+class StructuralWeight
+{
+public:
+    struct Member {
+        HullGirderSection::Member section;  // stiffener profile and plating
+        double densityKgM3 = 0.0;
+    };
+
+    // One XZ frame and the bay to the next frame
+    struct Bay {
+        int frameNo = 0;
+        double xpM = 0.0;
+        double spacingMM = 0.0;
+
+        bool operator==(const Bay &o) const {
+            return frameNo == o.frameNo && xpM == o.xpM && spacingMM == o.spacingMM;
+        }
+    };
+
+    struct Weight {
+        double massKg = 0.0;
+        double lcgM = 0.0;      // from the AP
+        double vcgM = 0.0;      // above base line
+    };
+
+    struct Zone {
+        int sectionFrame = 0;   // YZ frame number governing the zone
+        int firstFrame = 0;
+        int lastFrame = 0;
+        double lengthM = 0.0;
+        Weight total;
+        QMap<QString, Weight> byPrefix;
+    };
+
+    struct Result {
+        Weight total;
+        QMap<QString, Weight> byPrefix;
+        QVector<Zone> zones;    // ascending section frame
+    };
+
+    StructuralWeight();
+
+    void setBays(const QVector<Bay> &bays);
+    void setOutline(double halfWidthMM, double depthMM);
+    // Hull section of a YZ frame (empty: the B x D rectangle)
+    void setHullPolygon(int sectionFrame, const QVector<QPointF> &polygon);
+    // Members by prefix; prefixes without one get defaultMember
+    void setMembers(const QHash<QString, Member> &byPrefix, const Member &defaultMember);
+
+    // Stages a row of a YZ frame; returns false when nothing changed. Ids are unique over
+    // all frames, a row moved to another frame leaves its old section.
+    bool setRow(int sectionFrame, int id, const YZLineGeometry::Row &row);
+    bool removeRow(int id);
+    QVector<int> rowIds() const { return m_frameOfRow.keys(); }
+    // YZ frame numbers with rows, ascending
+    QVector<int> sectionFrames() const;
+
+    // Applies the staged changes and rebuilds the result
+    void update();
+    const Result &result() const { return m_result; }
+
+    // Rows expanded by update() since the counter was last reset (incremental-update check)
+    int expandedRows() const { return m_expanded; }
+    void resetExpandedRows() { m_expanded = 0; }
+
+private:
+    // Area (m2) and its height (m) of one prefix in a section
+    struct Slice {
+        double areaM2 = 0.0;
+        double zM = 0.0;
+    };
+
+    struct Section {
+        QHash<int, YZLineGeometry::Row> rows;       // staged state
+        QHash<int, QString> appliedPrefix;          // row id -> part holding it
+        QSet<int> changed;                          // ids to apply (removed when not in rows)
+        QVector<QPointF> hull;
+        bool hullChanged = false;
+        QHash<QString, HullGirderSection> parts;    // one per prefix
+        QHash<QString, Slice> slices;
+        int expanded = 0;
+    };
+
+    // Summed over the frames of one zone
+    struct ZoneExtent {
+        int firstFrame = 0;
+        int lastFrame = 0;
+        double lengthM = 0.0;
+        double momentXM2 = 0.0; // sum of bay length x bay mid
+    };
+
+    QVector<Bay> m_bays;
+    double m_halfWidthMM;
+    double m_depthMM;
+    QHash<QString, Member> m_members;
+    Member m_default;
+    QHash<QString, HullGirderSection::Member> m_sectionMembers;
+    HullGirderSection::Member m_sectionDefault;
+    QHash<int, Section> m_sections;
+    QHash<int, int> m_frameOfRow;
+    QSet<int> m_dirty;          // section frames with staged changes
+    bool m_allDirty;            // outline or section members changed
+    bool m_zonesDirty;
+    QMap<int, ZoneExtent> m_zones;
+    Result m_result;
+    int m_expanded;
+
+    Member memberOf(const QString &prefix) const;
+    void refreshSection(Section &section) const;
+    void rebuildZones();
+    void rebuildResult();
+};
+
+#endif // STRUCTURALWEIGHT_H
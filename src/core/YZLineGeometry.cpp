@@ -0,0 +1,117 @@
+#include "YZLineGeometry.h"
+#include <QHash>
+#include <algorithm>
+#include <numeric>
+
+quint8 YZLineGeometry::sideMask(const QString &sym)
+{
+    if (sym == QLatin1String("P")) return Port;
+    if (sym == QLatin1String("S")) return Starboard;
+    if (sym == QLatin1String("P+S") || sym == QLatin1String("S+P")) return Port | Starboard;
+    return 0;
+}
+
+void YZLineGeometry::clear()
+{
+    m_axes.clear();
+    m_sides.clear();
+    m_positions.clear();
+    m_prefixIds.clear();
+    m_suffixes.clear();
+    m_frames.clear();
+    m_prefixes.clear();
+    m_groups.clear();
+}
+
+void YZLineGeometry::build(const QVector<Row> &rows)
+{
+    clear();
+
+    // Only rows with exactly one of Y/Z and a drawable Sym produce lines
+    auto axisOf = [](const Row &r, quint8 &axis) {
+        if (r.hasZ && !r.hasY) { axis = Horizontal; return true; }
+        if (r.hasY && !r.hasZ) { axis = Vertical; return true; }
+        return false;
+    };
+
+    // Prefix ids follow the prefix sort order, so sorting by id sorts by prefix
+    int total = 0;
+    QHash<QString, int> idOf;
+    for (const Row &r : rows) {
+        quint8 axis;
+        if (r.count <= 0 || !axisOf(r, axis) || sideMask(r.sym) == 0) continue;
+        idOf.insert(r.prefix, 0);
+        total += r.count;
+    }
+    m_prefixes = idOf.keys();
+    std::sort(m_prefixes.begin(), m_prefixes.end());
+    for (int i = 0; i < m_prefixes.size(); ++i) idOf.insert(m_prefixes.at(i), i);
+
+    // Expand in row order
+    QVector<quint8> axes, sides;
+    QVector<double> positions;
+    QVector<int> prefixIds;
+    QVector<qint64> suffixes;
+    QVector<int> frames;
+    axes.reserve(total);
+    sides.reserve(total);
+    positions.reserve(total);
+    prefixIds.reserve(total);
+    suffixes.reserve(total);
+    frames.reserve(total);
+
+    for (const Row &r : rows) {
+        quint8 axis;
+        const quint8 mask = sideMask(r.sym);
+        if (r.count <= 0 || !axisOf(r, axis) || mask == 0) continue;
+        const int pid = idOf.value(r.prefix);
+        const double start = (axis == Horizontal) ? r.z : r.y;
+        for (int i = 0; i < r.count; ++i) {
+            axes.append(axis);
+            sides.append(mask);
+            positions.append(start + i * r.spacing);
+            prefixIds.append(pid);
+            suffixes.append(r.suffix + i);
+            frames.append(r.frameNo);
+        }
+    }
+
+    // Order by prefix, then suffix; rows usually arrive sorted, so skip the permutation then
+    QVector<int> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    auto less = [&](int a, int b) {
+        if (prefixIds[a] != prefixIds[b]) return prefixIds[a] < prefixIds[b];
+        return suffixes[a] < suffixes[b];
+    };
+    if (std::is_sorted(order.begin(), order.end(), less)) {
+        m_axes = std::move(axes);
+        m_sides = std::move(sides);
+        m_positions = std::move(positions);
+        m_prefixIds = std::move(prefixIds);
+        m_suffixes = std::move(suffixes);
+        m_frames = std::move(frames);
+    } else {
+        std::stable_sort(order.begin(), order.end(), less);
+        m_axes.reserve(total);
+        m_sides.reserve(total);
+        m_positions.reserve(total);
+        m_prefixIds.reserve(total);
+        m_suffixes.reserve(total);
+        m_frames.reserve(total);
+        for (int k : order) {
+            m_axes.append(axes[k]);
+            m_sides.append(sides[k]);
+            m_positions.append(positions[k]);
+            m_prefixIds.append(prefixIds[k]);
+            m_suffixes.append(suffixes[k]);
+            m_frames.append(frames[k]);
+        }
+    }
+
+    // Contiguous colour groups
+    for (int i = 0; i < total; ++i) {
+        if (m_groups.isEmpty() || m_groups.last().prefixId != m_prefixIds[i])
+            m_groups.append({ m_prefixIds[i], i, i });
+        m_groups.last().end = i + 1;
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef YZLINEGEOMETRY_H
+#define YZLINEGEOMETRY_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * Expanded YZ frame lines in structure-of-arrays form.
+ *
+ * build() expands every row's No x spacing into one entry per logical line and sorts the
+ * entries by prefix, then suffix, so each prefix (one pen colour) is a contiguous group.
+ * Entry i is the logical line with global index i; a P+S line is a single entry with both
+ * side bits set. Positions are in mm; the canvas only has to scale them to pixels.
+ */
+class YZLineGeometry
+{
+public:
+    enum Axis : quint8 {
+        Horizontal = 0,     // constant z (row has Z, no Y)
+        Vertical = 1        // constant y (row has Y, no Z)
+    };
+
+    enum Side : quint8 {
+        Port = 0x1,         // P: y <= 0 half
+        Starboard = 0x2     // S: y >= 0 half
+    };
+
+    struct Row {
+        QString prefix;
+        qint64 suffix = 0;      // suffix of the first line
+        int count = 0;          // No
+        double spacing = 0.0;   // mm between consecutive lines
+        double y = 0.0;         // mm
+        double z = 0.0;         // mm
+        bool hasY = false;
+        bool hasZ = false;
+        QString sym;            // "P", "S", "P+S" or "S+P"
+        int frameNo = -1;       // frame the row belongs to, -1 when not known
+
+        bool operator==(const Row &o) const {
+            return prefix == o.prefix && suffix == o.suffix && count == o.count && spacing == o.spacing
+                   && y == o.y && z == o.z && hasY == o.hasY && hasZ == o.hasZ && sym == o.sym
+                   && frameNo == o.frameNo;
+        }
+        bool operator!=(const Row &o) const { return !(*this == o); }
+    };
+
+    struct Group {
+        int prefixId = 0;
+        int begin = 0;
+        int end = 0;            // exclusive
+    };
+
+    void build(const QVector<Row> &rows);
+    void clear();
+
+    int lineCount() const { return m_axes.size(); }
+    bool isEmpty() const { return m_axes.isEmpty(); }
+
+    const QVector<quint8> &axes() const { return m_axes; }
+    const QVector<quint8> &sides() const { return m_sides; }
+    // Raw position (start + i * spacing); vertical lines are mirrored to -|v| / +|v| per side
+    const QVector<double> &positions() const { return m_positions; }
+    const QVector<int> &prefixIds() const { return m_prefixIds; }
+    const QVector<qint64> &suffixes() const { return m_suffixes; }
+    // Frame number of each line's row (-1 when the row did not say)
+    const QVector<int> &frames() const { return m_frames; }
+
+    // Distinct prefixes in sort order, indexed by prefix id
+    const QVector<QString> &prefixes() const { return m_prefixes; }
+    // One group per prefix id, in line order
+    const QVector<Group> &groups() const { return m_groups; }
+
+    QString prefixOf(int line) const { return m_prefixes.at(m_prefixIds.at(line)); }
+    QString lineName(int line) const { return prefixOf(line) + QString::number(m_suffixes.at(line)); }
+
+    // Side bits of a Sym value, 0 when the value is not drawable
+    static quint8 sideMask(const QString &sym);
+
+private:
+    QVector<quint8> m_axes;
+    QVector<quint8> m_sides;
+    QVector<double> m_positions;
+    QVector<int> m_prefixIds;
+    QVector<qint64> m_suffixes;
+    QVector<int> m_frames;
+    QVector<QString> m_prefixes;
+    QVector<Group> m_groups;
+};
+
+#endif // YZLINEGEOMETRY_H
@@ -0,0 +1,101 @@
+#include "YZLineLod.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Levels cover merge distances 1 mm .. 2^kMaxLevel mm (~1000 km), more than any hull needs
+static const int kMaxLevel = 30;
+
+void YZLineLod::clear()
+{
+    m_tracks.clear();
+    m_groupTrackBegin.clear();
+}
+
+void YZLineLod::build(const YZLineGeometry &geometry)
+{
+    clear();
+
+    const QVector<quint8> &axes = geometry.axes();
+    const QVector<quint8> &sides = geometry.sides();
+    const QVector<double> &positions = geometry.positions();
+
+    for (const auto &group : geometry.groups()) {
+        m_groupTrackBegin.append(m_tracks.size());
+
+        QVector<double> port, starboard, vertical;
+        for (int i = group.begin; i < group.end; ++i) {
+            const double pos = positions.at(i);
+            if (axes.at(i) == YZLineGeometry::Horizontal) {
+                if (sides.at(i) & YZLineGeometry::Port) port.append(pos);
+                if (sides.at(i) & YZLineGeometry::Starboard) starboard.append(pos);
+            } else {
+                if (sides.at(i) & YZLineGeometry::Starboard) vertical.append(std::fabs(pos));
+                if (sides.at(i) & YZLineGeometry::Port) vertical.append(-std::fabs(pos));
+            }
+        }
+
+        if (!port.isEmpty())
+            m_tracks.append(buildTrack(group.prefixId, YZLineGeometry::Horizontal, YZLineGeometry::Port, port));
+        if (!starboard.isEmpty())
+            m_tracks.append(buildTrack(group.prefixId, YZLineGeometry::Horizontal, YZLineGeometry::Starboard, starboard));
+        if (!vertical.isEmpty())
+            m_tracks.append(buildTrack(group.prefixId, YZLineGeometry::Vertical,
+                                       YZLineGeometry::Port | YZLineGeometry::Starboard, vertical));
+    }
+    m_groupTrackBegin.append(m_tracks.size());
+}
+
+YZLineLod::Track YZLineLod::buildTrack(int prefixId, quint8 axis, quint8 side, QVector<double> coords)
+{
+    Track track;
+    track.prefixId = prefixId;
+    track.axis = axis;
+    track.side = side;
+
+    std::sort(coords.begin(), coords.end());
+    track.minGap = std::numeric_limits<double>::infinity();
+    for (int i = 1; i < coords.size(); ++i) {
+        const double gap = coords.at(i) - coords.at(i - 1);
+        if (gap > 0.0 && gap < track.minGap) track.minGap = gap;
+    }
+
+    // Level 0 from the lines themselves, each further level from the previous one
+    QVector<Band> bands;
+    bands.reserve(coords.size());
+    for (double c : coords) bands.append({ c, c, 1 });
+
+    for (int level = 0; level <= kMaxLevel; ++level) {
+        const double mergeGap = std::ldexp(1.0, level);
+        QVector<Band> merged;
+        merged.reserve(bands.size());
+        for (const Band &b : bands) {
+            if (!merged.isEmpty() && b.from - merged.last().to < mergeGap) {
+                merged.last().to = b.to;
+                merged.last().count += b.count;
+            } else {
+                merged.append(b);
+            }
+        }
+        // Keep only levels that merge something more, the others alias the previous one
+        if (track.levels.isEmpty() || merged.size() < bands.size()) {
+            track.levels.append(merged);
+            track.levelExponents.append(level);
+        }
+        bands = merged;
+        // Nothing left to merge
+        if (merged.size() == 1) break;
+    }
+    return track;
+}
+
+int YZLineLod::levelFor(const Track &track, double thresholdMM)
+{
+    if (track.levels.isEmpty()) return -1;
+    int exponent = 0;
+    if (thresholdMM > 1.0)
+        exponent = static_cast<int>(std::ceil(std::log2(thresholdMM)));
+    // Last stored level whose exponent does not exceed the wanted one
+    const auto it = std::upper_bound(track.levelExponents.begin(), track.levelExponents.end(), exponent);
+    return std::max(0, static_cast<int>(it - track.levelExponents.begin()) - 1);
+}
@@ -0,0 +1,54 @@
+#ifndef YZLINELOD_H
+#define YZLINELOD_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "YZLineGeometry.h"
+
+/**
+ * Level-of-detail bands for YZ line geometry, built once per geometry change.
+ *
+ * Lines are split into tracks per prefix: horizontal port halves, horizontal starboard
+ * halves and vertical lines (signed y, so both sides share one track). A level with
+ * exponent e merges neighbouring lines whose gap is below 2^e mm into one band; only levels
+ * that merge more than the previous one are stored. A renderer that must merge lines closer
+ * than t mm picks levelFor(t) and draws the bands of that level; single line bands
+ * (count == 1) are still plain lines.
+ */
+class YZLineLod
+{
+public:
+    struct Band {
+        double from = 0.0;      // mm, along the track coordinate (z, or signed y)
+        double to = 0.0;
+        int count = 0;          // lines merged into the band
+    };
+
+    struct Track {
+        int prefixId = 0;
+        quint8 axis = YZLineGeometry::Horizontal;
+        quint8 side = YZLineGeometry::Port;     // horizontal tracks only
+        double minGap = 0.0;                    // smallest positive gap between lines, mm (inf if none)
+        QVector<QVector<Band>> levels;          // levels[i]: gaps < 2^levelExponents[i] mm merged
+        QVector<int> levelExponents;            // ascending
+    };
+
+    void build(const YZLineGeometry &geometry);
+    void clear();
+
+    const QVector<Track> &tracks() const { return m_tracks; }
+    // Tracks of geometry group g are tracks()[groupBegin(g) .. groupEnd(g))
+    int groupBegin(int group) const { return m_groupTrackBegin.at(group); }
+    int groupEnd(int group) const { return m_groupTrackBegin.at(group + 1); }
+
+    // Index into track.levels for merging gaps below thresholdMM (may merge up to 2x more)
+    static int levelFor(const Track &track, double thresholdMM);
+
+private:
+    QVector<Track> m_tracks;
+    QVector<int> m_groupTrackBegin;
+
+    static Track buildTrack(int prefixId, quint8 axis, quint8 side, QVector<double> coords);
+};
+
+#endif // YZLINELOD_H
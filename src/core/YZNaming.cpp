@@ -0,0 +1,95 @@
+#include "YZNaming.h"
+#include <QRegularExpression>
+#include <QStringList>
+#include <algorithm>
+
+namespace YZNaming {
+
+void parsePrefixSuffix(const QString &name, QString &prefix, int &suffix)
+{
+    prefix.clear(); suffix = 0;
+    int i = 0;
+    while (i < name.size() && name.at(i).isLetter()) { prefix.append(name.at(i).toUpper()); ++i; }
+    QString digits;
+    while (i < name.size() && name.at(i).isDigit()) { digits.append(name.at(i)); ++i; }
+    suffix = digits.isEmpty() ? 0 : digits.toInt();
+    if (prefix.isEmpty()) prefix = QStringLiteral("L");
+}
+
+QHash<QString, QVector<NameRow>> groupByPrefix(const QVector<NameRow> &rows)
+{
+    QHash<QString, QVector<NameRow>> groups;
+    for (const NameRow &row : rows) {
+        QString prefix; int suffix = 0;
+        parsePrefixSuffix(row.name, prefix, suffix);
+        groups[prefix].append(row);
+    }
+    return groups;
+}
+
+QVector<Issue> validateGroup(QVector<NameRow> rows)
+{
+    static const QRegularExpression validName(QStringLiteral("^[A-Za-z]*[0-9]+$"));
+
+    struct Range { int start; int end; int index; };
+    QVector<Issue> issues;
+    QVector<Range> ranges;
+    ranges.reserve(rows.size());
+
+    for (int i = 0; i < rows.size(); ++i) {
+        const NameRow &row = rows.at(i);
+        const QString trimmed = row.name.trimmed();
+        if (trimmed.isEmpty()) {
+            issues.append({ row.id, row.name, QStringLiteral("empty-name"), QStringLiteral("Name is empty") });
+            continue;
+        }
+        if (!validName.match(trimmed).hasMatch()) {
+            issues.append({ row.id, row.name, QStringLiteral("invalid-format"),
+                            QStringLiteral("Expected letter prefix followed by a numeric suffix") });
+        }
+        if (row.no <= 0) {
+            issues.append({ row.id, row.name, QStringLiteral("invalid-count"),
+                            QStringLiteral("No must be at least 1 (is %1)").arg(row.no) });
+            continue;
+        }
+        QString prefix; int suffix = 0;
+        parsePrefixSuffix(trimmed, prefix, suffix);
+        ranges.append({ suffix, suffix + row.no - 1, i });
+    }
+
+    // Sweep by start suffix; a range overlaps when it starts before the furthest end seen so far
+    std::sort(ranges.begin(), ranges.end(), [](const Range &a, const Range &b) {
+        return a.start != b.start ? a.start < b.start : a.end < b.end;
+    });
+    int furthest = -1;
+    for (int i = 0; i < ranges.size(); ++i) {
+        const Range &range = ranges.at(i);
+        if (furthest >= 0 && range.start <= ranges.at(furthest).end) {
+            const NameRow &row = rows.at(range.index);
+            const NameRow &other = rows.at(ranges.at(furthest).index);
+            issues.append({ row.id, row.name, QStringLiteral("suffix-overlap"),
+                            QStringLiteral("Suffixes %1-%2 overlap %3 (id %4, %5-%6)")
+                                .arg(range.start).arg(range.end)
+                                .arg(other.name).arg(other.id)
+                                .arg(ranges.at(furthest).start).arg(ranges.at(furthest).end) });
+        }
+        if (furthest < 0 || range.end > ranges.at(furthest).end)
+            furthest = i;
+    }
+
+    return issues;
+}
+
+QVector<Issue> validate(const QVector<NameRow> &rows)
+{
+    const QHash<QString, QVector<NameRow>> groups = groupByPrefix(rows);
+    QStringList prefixes = groups.keys();
+    std::sort(prefixes.begin(), prefixes.end());
+
+    QVector<Issue> issues;
+    for (const QString &prefix : prefixes)
+        issues += validateGroup(groups.value(prefix));
+    return issues;
+}
+
+} // namespace YZNaming
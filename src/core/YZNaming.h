@@ -0,0 +1,43 @@
+#ifndef YZNAMING_H
+#define YZNAMING_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+/**
+ * YZ longitudinal naming rules: a name is a letter prefix followed by a numeric suffix
+ * (e.g. "L12"), and a row with "No" = n reserves the suffixes [suffix, suffix + n - 1].
+ * Shared by FrameArrangementYZ and dewaruci-cli.
+ */
+namespace YZNaming {
+
+struct NameRow {
+    int id = 0;
+    QString name;
+    int no = 0;
+    int frameNo = 0;
+};
+
+struct Issue {
+    int id = 0;
+    QString name;
+    QString kind;       // "empty-name", "invalid-format", "invalid-count", "suffix-overlap"
+    QString detail;
+};
+
+// Upper-case letter prefix ("L" when there is none) and numeric suffix (0 when there is none)
+void parsePrefixSuffix(const QString &name, QString &prefix, int &suffix);
+
+// Rows grouped by parsed prefix; groups can be validated independently
+QHash<QString, QVector<NameRow>> groupByPrefix(const QVector<NameRow> &rows);
+
+// Checks one prefix group: format, count and overlapping suffix ranges (O(n log n))
+QVector<Issue> validateGroup(QVector<NameRow> rows);
+
+// Convenience: validateGroup() over every prefix, issues ordered by prefix
+QVector<Issue> validate(const QVector<NameRow> &rows);
+
+} // namespace YZNaming
+
+#endif // YZNAMING_H
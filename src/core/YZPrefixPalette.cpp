@@ -0,0 +1,110 @@
+#include "YZPrefixPalette.h"
+#include <algorithm>
+#include <cmath>
+
+// Fixed seed hue so every session (and every export) gets the same colours
+static const double kStartHue = 205.0;
+
+QString YZPrefixPalette::normalized(const QString &prefix)
+{
+    return prefix.isEmpty() ? QStringLiteral("L") : prefix.toUpper();
+}
+
+void YZPrefixPalette::reset()
+{
+    m_map.clear();
+    m_used.clear();
+}
+
+void YZPrefixPalette::assign(const QVector<QString> &prefixes)
+{
+    // New prefixes get colours in sorted order, independent of the order they are listed in
+    QVector<QString> fresh;
+    for (const QString &prefix : prefixes) {
+        const QString key = normalized(prefix);
+        if (!m_map.contains(key) && !fresh.contains(key)) fresh.append(key);
+    }
+    std::sort(fresh.begin(), fresh.end());
+    for (const QString &key : fresh) {
+        const Entry entry = nextColor();
+        m_map.insert(key, entry.rgb);
+        m_used.append(entry);
+    }
+}
+
+quint32 YZPrefixPalette::fromHsl(double hueDeg, double saturation, double lightness)
+{
+    const double c = (1.0 - std::fabs(2.0 * lightness - 1.0)) * saturation;
+    const double h = hueDeg / 60.0;
+    const double x = c * (1.0 - std::fabs(std::fmod(h, 2.0) - 1.0));
+    double r = 0.0, g = 0.0, b = 0.0;
+    if (h < 1.0)      { r = c; g = x; }
+    else if (h < 2.0) { r = x; g = c; }
+    else if (h < 3.0) { g = c; b = x; }
+    else if (h < 4.0) { g = x; b = c; }
+    else if (h < 5.0) { r = x; b = c; }
+    else              { r = c; b = x; }
+    const double m = lightness - c / 2.0;
+    auto channel = [m](double v) { return quint32(std::clamp(qRound((v + m) * 255.0), 0, 255)); };
+    return (channel(r) << 16) | (channel(g) << 8) | channel(b);
+}
+
+YZPrefixPalette::Entry YZPrefixPalette::nextColor() const
+{
+    // Parameters for distribution and contrast
+    const double golden = 137.50776405003785; // degrees, golden-angle
+    const double minHueSeparation = 26.0;     // degrees, avoid near-identical hues
+    const double sat = 0.78;                  // strong saturation for contrast
+    const double light = 0.55;                // mid lightness (avoid pastel and too dark)
+    const double minRgbDistance = 80.0;       // minimum Euclidean distance in RGB (0..441 max)
+
+    auto hueDistanceDeg = [](double a, double b) {
+        double d = std::fabs(a - b);
+        return std::min(d, 360.0 - d);
+    };
+
+    auto farHue = [&](double candHueDeg) {
+        for (const Entry &e : m_used) {
+            if (hueDistanceDeg(candHueDeg, e.hue) < minHueSeparation)
+                return false;
+        }
+        return true;
+    };
+
+    auto rgbDistance = [](quint32 a, quint32 b) {
+        const int dr = int((a >> 16) & 0xff) - int((b >> 16) & 0xff);
+        const int dg = int((a >> 8) & 0xff) - int((b >> 8) & 0xff);
+        const int db = int(a & 0xff) - int(b & 0xff);
+        return std::sqrt(double(dr*dr + dg*dg + db*db));
+    };
+
+    // Base candidate using golden-angle sequence
+    const int n = m_used.size();
+    double hue = std::fmod(kStartHue + n * golden, 360.0);
+
+    // If too close by hue, advance further along the sequence (bounded attempts)
+    int attempts = 0;
+    const int maxAttempts = 720;
+    while (!farHue(hue) && attempts++ < maxAttempts) {
+        hue = std::fmod(hue + golden, 360.0);
+    }
+
+    quint32 col = fromHsl(hue, sat, light);
+
+    // Ensure RGB distance is also sufficiently large; tweak lightness slightly if needed
+    attempts = 0;
+    while (attempts++ < 24) {
+        bool ok = true;
+        for (const Entry &e : m_used) {
+            if (rgbDistance(col, e.rgb) < minRgbDistance) { ok = false; break; }
+        }
+        if (ok) break;
+        // Alternate lightness around the base value to force separation without changing hue
+        const double step = 0.06 * ((attempts + 1) / 2);
+        const double dir = (attempts % 2) ? -1.0 : 1.0;
+        const double nl = std::clamp(light + dir * step, 0.35, 0.72);
+        col = fromHsl(hue, sat, nl);
+    }
+
+    return { hue, col };
+}
@@ -0,0 +1,46 @@
+#ifndef YZPREFIXPALETTE_H
+#define YZPREFIXPALETTE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * High-contrast colours (0xRRGGBB) per YZ name prefix, without QtGui.
+ *
+ * Colours are assigned once per prefix, in sorted order of the prefix set, by golden-angle
+ * hue stepping from a fixed start hue with minimum hue separation and RGB distance checks.
+ * After reset() the same prefix set therefore gets the same colours in every session. The
+ * canvas (YZPalette) and the CLI export both assign the full prefix set of the YZ table
+ * this way. A later assign() without reset() keeps the colours already handed out and
+ * appends the new prefixes.
+ */
+class YZPrefixPalette
+{
+public:
+    YZPrefixPalette() = default;
+
+    void assign(const QVector<QString> &prefixes);
+    void reset();
+
+    // Black for a prefix that was never assigned
+    quint32 rgb(const QString &prefix) const { return m_map.value(normalized(prefix), 0x000000); }
+    bool contains(const QString &prefix) const { return m_map.contains(normalized(prefix)); }
+
+    static QString normalized(const QString &prefix);
+
+private:
+    struct Entry {
+        double hue;     // degrees
+        quint32 rgb;
+    };
+
+    QHash<QString, quint32> m_map;  // prefix -> colour, every prefix seen since reset()
+    QVector<Entry> m_used;          // assignment order
+
+    Entry nextColor() const;
+    static quint32 fromHsl(double hueDeg, double saturation, double lightness);
+};
+
+#endif // YZPREFIXPALETTE_H
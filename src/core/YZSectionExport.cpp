@@ -0,0 +1,251 @@
+#include "YZSectionExport.h"
+#include <algorithm>
+#include <cmath>
+
+// Section mm around the hull outline that is still exported
+static const double kExtentMargin = 1000.0;
+
+static const quint32 kOutlineColor = 0x000000;
+static const quint32 kCenterlineColor = 0x808080;
+
+static QString num(double value)
+{
+    return QString::number(value, 'g', 10);
+}
+
+static QString hexColor(quint32 rgb)
+{
+    return QStringLiteral("#%1").arg(rgb & 0xffffff, 6, 16, QLatin1Char('0'));
+}
+
+// ---------------- SVG ----------------
+
+YZSvgSink::YZSvgSink(QIODevice *device, double scale)
+    : m_out(device), m_scale(scale > 0.0 ? scale : 1.0)
+{
+}
+
+bool YZSvgSink::begin(const QRectF &extent)
+{
+    // SVG y grows downwards: svg y = -z
+    m_out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << num(extent.width() / m_scale) << "mm\""
+          << " height=\"" << num(extent.height() / m_scale) << "mm\""
+          << " viewBox=\"" << num(extent.left()) << ' ' << num(-extent.bottom()) << ' '
+          << num(extent.width()) << ' ' << num(extent.height()) << "\">\n"
+          << "<g fill=\"none\" stroke-width=\"" << num(0.25 * m_scale) << "\">\n";
+    m_layer.clear();
+    return m_out.status() == QTextStream::Ok;
+}
+
+void YZSvgSink::line(const QLineF &segment, const QString &layer, quint32 rgb)
+{
+    // Rows of one prefix usually arrive together, so a new group opens only on a change
+    if (layer != m_layer) {
+        if (!m_layer.isEmpty()) m_out << "</g>\n";
+        m_out << "<g class=\"" << layer.toHtmlEscaped() << "\">\n";
+        m_layer = layer;
+    }
+    m_out << "<line x1=\"" << num(segment.x1()) << "\" y1=\"" << num(-segment.y1())
+          << "\" x2=\"" << num(segment.x2()) << "\" y2=\"" << num(-segment.y2())
+          << "\" stroke=\"" << hexColor(rgb) << "\"/>\n";
+}
+
+void YZSvgSink::text(const QPointF &at, const QString &value, double heightMM, bool centered,
+                     const QString &layer, quint32 rgb)
+{
+    Q_UNUSED(layer);
+    m_out << "<text x=\"" << num(at.x()) << "\" y=\"" << num(-at.y()) << "\" font-size=\"" << num(heightMM)
+          << "\" font-family=\"sans-serif\" fill=\"" << hexColor(rgb) << '"'
+          << (centered ? " text-anchor=\"middle\"" : "") << '>' << value.toHtmlEscaped() << "</text>\n";
+}
+
+bool YZSvgSink::end()
+{
+    if (!m_layer.isEmpty()) m_out << "</g>\n";
+    m_out << "</g>\n</svg>\n";
+    m_out.flush();
+    return m_out.status() == QTextStream::Ok;
+}
+
+// ---------------- DXF ----------------
+
+YZDxfSink::YZDxfSink(QIODevice *device)
+    : m_out(device)
+{
+}
+
+bool YZDxfSink::begin(const QRectF &extent)
+{
+    m_out << "0\nSECTION\n2\nHEADER\n"
+          << "9\n$ACADVER\n1\nAC1009\n"
+          << "9\n$EXTMIN\n10\n" << num(extent.left()) << "\n20\n" << num(extent.top()) << '\n'
+          << "9\n$EXTMAX\n10\n" << num(extent.right()) << "\n20\n" << num(extent.bottom()) << '\n'
+          << "0\nENDSEC\n"
+          << "0\nSECTION\n2\nENTITIES\n";
+    return m_out.status() == QTextStream::Ok;
+}
+
+void YZDxfSink::line(const QLineF &segment, const QString &layer, quint32 rgb)
+{
+    m_out << "0\nLINE\n8\n" << layer << "\n62\n" << aciColor(rgb) << '\n'
+          << "10\n" << num(segment.x1()) << "\n20\n" << num(segment.y1()) << "\n30\n0\n"
+          << "11\n" << num(segment.x2()) << "\n21\n" << num(segment.y2()) << "\n31\n0\n";
+}
+
+void YZDxfSink::text(const QPointF &at, const QString &value, double heightMM, bool centered,
+                     const QString &layer, quint32 rgb)
+{
+    m_out << "0\nTEXT\n8\n" << layer << "\n62\n" << aciColor(rgb) << '\n'
+          << "10\n" << num(at.x()) << "\n20\n" << num(at.y()) << "\n30\n0\n"
+          << "40\n" << num(heightMM) << "\n1\n" << value << '\n';
+    // Centred text is placed by its alignment point
+    if (centered)
+        m_out << "72\n1\n11\n" << num(at.x()) << "\n21\n" << num(at.y()) << "\n31\n0\n";
+}
+
+bool YZDxfSink::end()
+{
+    m_out << "0\nENDSEC\n0\nEOF\n";
+    m_out.flush();
+    return m_out.status() == QTextStream::Ok;
+}
+
+// Nearest of the basic AutoCAD colour indices (7 = black/white follows the background)
+int YZDxfSink::aciColor(quint32 rgb)
+{
+    static const struct { int index; quint32 rgb; } kColors[] = {
+        { 1, 0xff0000 }, { 2, 0xffff00 }, { 3, 0x00ff00 }, { 4, 0x00ffff },
+        { 5, 0x0000ff }, { 6, 0xff00ff }, { 7, 0x000000 }, { 8, 0x808080 },
+    };
+    const int r = (rgb >> 16) & 0xff, g = (rgb >> 8) & 0xff, b = rgb & 0xff;
+    int best = 7;
+    int bestDistance = -1;
+    for (const auto &c : kColors) {
+        const int dr = r - int((c.rgb >> 16) & 0xff);
+        const int dg = g - int((c.rgb >> 8) & 0xff);
+        const int db = b - int(c.rgb & 0xff);
+        const int distance = dr * dr + dg * dg + db * db;
+        if (bestDistance < 0 || distance < bestDistance) {
+            best = c.index;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+// ---------------- exporter ----------------
+
+YZSectionExporter::YZSectionExporter(YZSectionSink *sink)
+    : m_sink(sink),
+      m_halfWidthMM(24384.0 / 2.0),
+      m_heightMM(5490.0),
+      m_labelHeightMM(125.0),
+      m_showLabels(true),
+      m_lineCount(0)
+{
+}
+
+void YZSectionExporter::setOutline(double halfWidthMM, double heightMM)
+{
+    if (halfWidthMM > 0.0) m_halfWidthMM = halfWidthMM;
+    if (heightMM > 0.0) m_heightMM = heightMM;
+}
+
+void YZSectionExporter::setColorFunction(const std::function<quint32(const QString &)> &color)
+{
+    m_color = color;
+}
+
+void YZSectionExporter::setPalette(const YZPrefixPalette &palette)
+{
+    m_color = [palette](const QString &prefix) { return palette.rgb(prefix); };
+}
+
+QRectF YZSectionExporter::extent() const
+{
+    // left/right: y, top/bottom: lowest/highest z
+    return QRectF(-m_halfWidthMM - kExtentMargin, -kExtentMargin,
+                  2.0 * (m_halfWidthMM + kExtentMargin), m_heightMM + 2.0 * kExtentMargin);
+}
+
+bool YZSectionExporter::begin()
+{
+    m_lineCount = 0;
+    const QRectF e = extent();
+    if (!m_sink->begin(e)) return false;
+
+    const QString centerline = QStringLiteral("CENTERLINE");
+    m_sink->line(QLineF(0.0, e.top(), 0.0, e.bottom()), centerline, kCenterlineColor);
+    m_sink->line(QLineF(e.left(), 0.0, e.right(), 0.0), centerline, kCenterlineColor);
+
+    const QString outline = QStringLiteral("OUTLINE");
+    if (!m_hull.isEmpty()) {
+        for (int i = 0; i < m_hull.size(); ++i)
+            m_sink->line(QLineF(m_hull.at(i), m_hull.at((i + 1) % m_hull.size())), outline, kOutlineColor);
+        return true;
+    }
+    const double hw = m_halfWidthMM, h = m_heightMM;
+    m_sink->line(QLineF(-hw, 0.0, hw, 0.0), outline, kOutlineColor);
+    m_sink->line(QLineF(hw, 0.0, hw, h), outline, kOutlineColor);
+    m_sink->line(QLineF(hw, h, -hw, h), outline, kOutlineColor);
+    m_sink->line(QLineF(-hw, h, -hw, 0.0), outline, kOutlineColor);
+    return true;
+}
+
+void YZSectionExporter::addRow(const YZLineGeometry::Row &row, const QVector<QPointF> &hull)
+{
+    const quint8 sides = YZLineGeometry::sideMask(row.sym);
+    if (row.count <= 0 || sides == 0 || row.hasY == row.hasZ) return;
+
+    const QRectF e = extent();
+    const QString layer = row.prefix.isEmpty() ? QStringLiteral("L") : row.prefix;
+    const quint32 rgb = m_color ? (m_color(layer) & 0xffffff) : kOutlineColor;
+    const double h = m_labelHeightMM;
+    const double pad = 0.5 * h;
+
+    for (int i = 0; i < row.count; ++i) {
+        const QString name = layer + QString::number(row.suffix + i);
+        if (row.hasZ) {
+            // Horizontal line at z across the halves named by Sym
+            const double z = row.z + i * row.spacing;
+            if (z < e.top() || z > e.bottom()) continue;
+            const double from = (sides & YZLineGeometry::Port) ? e.left() : 0.0;
+            const double to = (sides & YZLineGeometry::Starboard) ? e.right() : 0.0;
+            if (hull.isEmpty()) {
+                m_sink->line(QLineF(from, z, to, z), layer, rgb);
+            } else {
+                for (const HullSection::Span &span : HullSection::clipLine(hull, YZLineGeometry::Horizontal, z)) {
+                    const double a = std::max(from, span.from), b = std::min(to, span.to);
+                    if (a < b) m_sink->line(QLineF(a, z, b, z), layer, rgb);
+                }
+            }
+            if (m_showLabels)
+                m_sink->text(QPointF(from + pad, z + 0.3 * h), name, h, false, layer, rgb);
+        } else {
+            // Vertical line mirrored to each side named by Sym
+            const double v = std::fabs(row.y + i * row.spacing);
+            for (quint8 side : { quint8(YZLineGeometry::Port), quint8(YZLineGeometry::Starboard) }) {
+                if (!(sides & side)) continue;
+                const double y = (side == YZLineGeometry::Port) ? -v : v;
+                if (y < e.left() || y > e.right()) continue;
+                if (hull.isEmpty()) {
+                    m_sink->line(QLineF(y, e.top(), y, e.bottom()), layer, rgb);
+                } else {
+                    for (const HullSection::Span &span : HullSection::clipLine(hull, YZLineGeometry::Vertical, v)) {
+                        const double a = std::max(e.top(), span.from), b = std::min(e.bottom(), span.to);
+                        if (a < b) m_sink->line(QLineF(y, a, y, b), layer, rgb);
+                    }
+                }
+                if (m_showLabels)
+                    m_sink->text(QPointF(y, e.bottom() - pad - h), name, h, true, layer, rgb);
+            }
+        }
+        ++m_lineCount;
+    }
+}
+
+bool YZSectionExporter::end()
+{
+    return m_sink->end();
+}
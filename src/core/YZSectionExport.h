@@ -0,0 +1,116 @@
+#ifndef YZSECTIONEXPORT_H
+#define YZSECTIONEXPORT_H
+
+#include <QIODevice>
+#include <QLineF>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QTextStream>
+#include <QtGlobal>
+#include <functional>
+#include "YZLineGeometry.h"
+#include "HullSection.h"
+#include "YZPrefixPalette.h"
+
+/**
+ * Output side of the YZ section export. Coordinates are section mm: y grows to starboard,
+ * z grows upwards, (0, 0) is the centerline at the base line. Colours are 0xRRGGBB.
+ * Elements are written as they arrive; a sink never holds the drawing in memory.
+ */
+class YZSectionSink
+{
+public:
+    virtual ~YZSectionSink() = default;
+
+    // extent: everything that follows lies inside it
+    virtual bool begin(const QRectF &extent) = 0;
+    virtual void line(const QLineF &segment, const QString &layer, quint32 rgb) = 0;
+    // Text with its baseline at z = at.y(); left aligned at y = at.x(), or centred on it
+    virtual void text(const QPointF &at, const QString &value, double heightMM, bool centered,
+                      const QString &layer, quint32 rgb) = 0;
+    virtual bool end() = 0;
+};
+
+// SVG at a drawing scale (1:scale): viewBox in section mm, page size in paper mm
+class YZSvgSink : public YZSectionSink
+{
+public:
+    explicit YZSvgSink(QIODevice *device, double scale = 50.0);
+
+    bool begin(const QRectF &extent) override;
+    void line(const QLineF &segment, const QString &layer, quint32 rgb) override;
+    void text(const QPointF &at, const QString &value, double heightMM, bool centered,
+              const QString &layer, quint32 rgb) override;
+    bool end() override;
+
+private:
+    QTextStream m_out;
+    double m_scale;
+    QString m_layer;        // open <g> element
+};
+
+// ASCII DXF (R12 entities, model space in mm), one layer per prefix
+class YZDxfSink : public YZSectionSink
+{
+public:
+    explicit YZDxfSink(QIODevice *device);
+
+    bool begin(const QRectF &extent) override;
+    void line(const QLineF &segment, const QString &layer, quint32 rgb) override;
+    void text(const QPointF &at, const QString &value, double heightMM, bool centered,
+              const QString &layer, quint32 rgb) override;
+    bool end() override;
+
+private:
+    QTextStream m_out;
+
+    static int aciColor(quint32 rgb);
+};
+
+/**
+ * Streams one frame section to a sink: hull outline and centerlines first, then every
+ * row's lines (and labels) as the row is added, expanded on the fly like the canvas does
+ * and clipped to the hull section when one is set.
+ * Rows can come straight from a forward-only query; nothing is sorted or kept.
+ */
+class YZSectionExporter
+{
+public:
+    explicit YZSectionExporter(YZSectionSink *sink);
+
+    void setOutline(double halfWidthMM, double heightMM);
+    // Hull section of the frame (HullSection::polygonAt); replaces the B x D rectangle as
+    // outline and lines are exported only where they lie inside it
+    void setHullPolygon(const QVector<QPointF> &polygon) { m_hull = polygon; }
+    // Colour per prefix; lines are black until one is set
+    void setColorFunction(const std::function<quint32(const QString &)> &color);
+    // Colours of the shared prefix palette, as drawn on the canvas
+    void setPalette(const YZPrefixPalette &palette);
+    void setShowLabels(bool show) { m_showLabels = show; }
+    // Label height in section mm (2.5 mm on paper at 1:50)
+    void setLabelHeight(double heightMM) { m_labelHeightMM = heightMM; }
+
+    // Outline plus a margin; lines outside it are not exported
+    QRectF extent() const;
+
+    bool begin();
+    void addRow(const YZLineGeometry::Row &row) { addRow(row, m_hull); }
+    // Row clipped to its own frame's hull section (sheets with rows of several frames)
+    void addRow(const YZLineGeometry::Row &row, const QVector<QPointF> &hull);
+    bool end();
+
+    int lineCount() const { return m_lineCount; }
+
+private:
+    YZSectionSink *m_sink;
+    std::function<quint32(const QString &)> m_color;
+    double m_halfWidthMM;
+    double m_heightMM;
+    QVector<QPointF> m_hull;
+    double m_labelHeightMM;
+    bool m_showLabels;
+    int m_lineCount;
+};
+
+#endif // YZSECTIONEXPORT_H
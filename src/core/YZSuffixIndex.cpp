@@ -0,0 +1,197 @@
+#include "YZSuffixIndex.h"
+#include <algorithm>
+#include <climits>
+
+YZSuffixIndex::YZSuffixIndex()
+    : m_seed(2463534242u)
+{
+}
+
+void YZSuffixIndex::clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_roots.clear();
+    m_byId.clear();
+}
+
+void YZSuffixIndex::insert(int id, const QString &prefix, int start, int count, bool manual)
+{
+    remove(id);
+
+    Range range;
+    range.id = id;
+    range.start = start;
+    range.end = start + std::max(0, count) - 1;
+    range.manual = manual;
+
+    const int n = allocate(range);
+    m_roots.insert(prefix, insertNode(m_roots.value(prefix, -1), n));
+    m_byId.insert(id, Location{ prefix, n });
+}
+
+void YZSuffixIndex::remove(int id)
+{
+    if (!m_byId.contains(id))
+        return;
+
+    const Location location = m_byId.value(id);
+    m_byId.remove(id);
+    const Range key = m_nodes.at(location.node).range;
+    int root = eraseNode(m_roots.value(location.prefix, -1), key);
+    if (root < 0)
+        m_roots.remove(location.prefix);
+    else
+        m_roots[location.prefix] = root;
+    m_freeNodes.append(location.node);
+}
+
+QVector<YZSuffixIndex::Range> YZSuffixIndex::overlapping(const QString &prefix, int start, int count) const
+{
+    QVector<Range> out;
+    if (count <= 0)
+        return out;
+    collect(m_roots.value(prefix, -1), start, start + count - 1, out);
+    return out;
+}
+
+int YZSuffixIndex::lastSuffix(const QString &prefix) const
+{
+    const int root = m_roots.value(prefix, -1);
+    return root < 0 ? -1 : std::max(-1, m_nodes.at(root).maxEnd);
+}
+
+int YZSuffixIndex::nextFreeSuffix(const QString &prefix, int from, int count) const
+{
+    const int length = std::max(1, count);
+    int candidate = from;
+    // Each step jumps past every range blocking the candidate window
+    for (;;) {
+        const QVector<Range> blocking = overlapping(prefix, candidate, length);
+        if (blocking.isEmpty())
+            return candidate;
+        int furthest = candidate;
+        for (const Range &range : blocking)
+            furthest = std::max(furthest, range.end);
+        candidate = furthest + 1;
+    }
+}
+
+int YZSuffixIndex::allocate(const Range &range)
+{
+    // xorshift32: deterministic priorities without global state
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    Node node;
+    node.range = range;
+    node.priority = m_seed;
+    node.maxEnd = range.end;
+
+    if (!m_freeNodes.isEmpty()) {
+        const int n = m_freeNodes.takeLast();
+        m_nodes[n] = node;
+        return n;
+    }
+    m_nodes.append(node);
+    return m_nodes.size() - 1;
+}
+
+void YZSuffixIndex::update(int n)
+{
+    Node &node = m_nodes[n];
+    node.maxEnd = node.range.end;
+    if (node.left >= 0)
+        node.maxEnd = std::max(node.maxEnd, m_nodes.at(node.left).maxEnd);
+    if (node.right >= 0)
+        node.maxEnd = std::max(node.maxEnd, m_nodes.at(node.right).maxEnd);
+}
+
+bool YZSuffixIndex::less(const Range &a, const Range &b) const
+{
+    if (a.start != b.start)
+        return a.start < b.start;
+    return a.id < b.id;
+}
+
+void YZSuffixIndex::split(int t, const Range &key, int &l, int &r)
+{
+    if (t < 0) {
+        l = r = -1;
+        return;
+    }
+    if (less(m_nodes.at(t).range, key)) {
+        int right = -1;
+        split(m_nodes.at(t).right, key, right, r);
+        m_nodes[t].right = right;
+        l = t;
+    } else {
+        int left = -1;
+        split(m_nodes.at(t).left, key, l, left);
+        m_nodes[t].left = left;
+        r = t;
+    }
+    update(t);
+}
+
+int YZSuffixIndex::merge(int l, int r)
+{
+    if (l < 0)
+        return r;
+    if (r < 0)
+        return l;
+    if (m_nodes.at(l).priority > m_nodes.at(r).priority) {
+        const int right = merge(m_nodes.at(l).right, r);
+        m_nodes[l].right = right;
+        update(l);
+        return l;
+    }
+    const int left = merge(l, m_nodes.at(r).left);
+    m_nodes[r].left = left;
+    update(r);
+    return r;
+}
+
+int YZSuffixIndex::insertNode(int t, int n)
+{
+    int l = -1, r = -1;
+    split(t, m_nodes.at(n).range, l, r);
+    return merge(merge(l, n), r);
+}
+
+int YZSuffixIndex::eraseNode(int t, const Range &key)
+{
+    if (t < 0)
+        return -1;
+    const Range &here = m_nodes.at(t).range;
+    if (here.id == key.id && here.start == key.start) {
+        const int merged = merge(m_nodes.at(t).left, m_nodes.at(t).right);
+        m_nodes[t].left = m_nodes[t].right = -1;
+        return merged;
+    }
+    if (less(key, here)) {
+        const int left = eraseNode(m_nodes.at(t).left, key);
+        m_nodes[t].left = left;
+    } else {
+        const int right = eraseNode(m_nodes.at(t).right, key);
+        m_nodes[t].right = right;
+    }
+    update(t);
+    return t;
+}
+
+void YZSuffixIndex::collect(int t, int start, int end, QVector<Range> &out) const
+{
+    // Nothing in this subtree reaches the query window
+    if (t < 0 || m_nodes.at(t).maxEnd < start)
+        return;
+
+    const Node &node = m_nodes.at(t);
+    collect(node.left, start, end, out);
+    if (node.range.start > end)
+        return;     // this node and the whole right subtree start after the window
+    if (std::max(start, node.range.start) <= std::min(end, node.range.end))
+        out.append(node.range);
+    collect(node.right, start, end, out);
+}
@@ -0,0 +1,72 @@
+#ifndef YZSUFFIXINDEX_H
+#define YZSUFFIXINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+/**
+ * Per-prefix index of reserved YZ suffix ranges [startSuffix, startSuffix + no - 1].
+ *
+ * Each prefix has its own treap ordered by (start, id) and augmented with the largest
+ * end in every subtree, so inserting, removing and re-ranging a row is O(log n) and an
+ * overlap query is O(log n + k). A row with no <= 0 reserves nothing (end = start - 1)
+ * but still counts for lastSuffix(), like the previous linear scans did.
+ */
+class YZSuffixIndex
+{
+public:
+    struct Range {
+        int id = 0;
+        int start = 0;
+        int end = 0;        // inclusive; start - 1 for an empty range
+        bool manual = false;
+    };
+
+    YZSuffixIndex();
+
+    void clear();
+    // Adds or replaces the range of row id
+    void insert(int id, const QString &prefix, int start, int count, bool manual);
+    void remove(int id);
+    bool contains(int id) const { return m_byId.contains(id); }
+    int size() const { return m_byId.size(); }
+
+    // Ranges of prefix overlapping [start, start + count - 1], ordered by start
+    QVector<Range> overlapping(const QString &prefix, int start, int count) const;
+    // Highest end suffix used by prefix, -1 when the prefix has no rows
+    int lastSuffix(const QString &prefix) const;
+    // Smallest s >= from such that [s, s + count - 1] overlaps no range of prefix
+    int nextFreeSuffix(const QString &prefix, int from, int count) const;
+
+private:
+    struct Node {
+        Range range;
+        quint32 priority = 0;
+        int maxEnd = 0;
+        int left = -1;
+        int right = -1;
+    };
+
+    struct Location {
+        QString prefix;
+        int node = -1;
+    };
+
+    QVector<Node> m_nodes;
+    QVector<int> m_freeNodes;
+    QHash<QString, int> m_roots;
+    QHash<int, Location> m_byId;
+    quint32 m_seed;
+
+    int allocate(const Range &range);
+    void update(int n);
+    bool less(const Range &a, const Range &b) const;
+    void split(int t, const Range &key, int &l, int &r);   // l: keys < key, r: keys >= key
+    int merge(int l, int r);
+    int insertNode(int t, int n);
+    int eraseNode(int t, const Range &key);
+    void collect(int t, int start, int end, QVector<Range> &out) const;
+};
+
+#endif // YZSUFFIXINDEX_H
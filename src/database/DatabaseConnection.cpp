@@ -26,9 +26,6 @@ DatabaseConnection::~DatabaseConnection()
 
 bool DatabaseConnection::initialize()
 {
-    // Setup SQLite database
-    m_database = QSqlDatabase::addDatabase("QSQLITE", "MainConnection");
-    
     // Set database path to project folder data/dewaruci.db
     QString appDirPath = QCoreApplication::applicationDirPath();
     QString projectRoot;
@@ -52,24 +49,37 @@ bool DatabaseConnection::initialize()
     
     QString dbPath = QDir(projectRoot).absoluteFilePath("data/dewaruci.db");
     
-    // Create database directory if it doesn't exist
-    QDir dbDir = QFileInfo(dbPath).absoluteDir();
-    if (!dbDir.exists()) {
-        dbDir.mkpath(".");
+    if (!initialize(dbPath)) {
+        qCritical() << "  Project root:" << projectRoot;
+        qCritical() << "  App dir:" << appDirPath;
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseConnection::initialize(const QString &databasePath)
+{
+    // Setup SQLite database
+    m_database = QSqlDatabase::addDatabase("QSQLITE", "MainConnection");
+
+    // Create database directory if it doesn't exist (skip for in-memory databases)
+    if (databasePath != QLatin1String(":memory:")) {
+        QDir dbDir = QFileInfo(databasePath).absoluteDir();
+        if (!dbDir.exists()) {
+            dbDir.mkpath(".");
+        }
     }
     
-    m_database.setDatabaseName(dbPath);
+    m_database.setDatabaseName(databasePath);
     
     if (!m_database.open()) {
         m_lastError = QString("Failed to open database: %1").arg(m_database.lastError().text());
         qCritical() << "DatabaseConnection::initialize() -" << m_lastError;
-        qCritical() << "  Attempted path:" << dbPath;
-        qCritical() << "  Project root:" << projectRoot;
-        qCritical() << "  App dir:" << appDirPath;
+        qCritical() << "  Attempted path:" << databasePath;
         return false;
     }
     
-    qDebug() << "DatabaseConnection::initialize() - Database opened:" << dbPath;
+    qDebug() << "DatabaseConnection::initialize() - Database opened:" << databasePath;
     emit connectionEstablished();
     
     qDebug() << "DatabaseConnection::initialize() - Successfully initialized";
@@ -15,6 +15,8 @@ public:
     static DatabaseConnection& instance();
     
     bool initialize();
+    // Open an explicit database file (or ":memory:"), e.g. for tools and benchmarks
+    bool initialize(const QString &databasePath);
     void close();
     bool isConnected() const;
     QSqlDatabase& database() { return m_database; }
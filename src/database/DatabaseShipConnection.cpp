@@ -31,9 +31,6 @@ DatabaseShipConnection::~DatabaseShipConnection()
 
 bool DatabaseShipConnection::initialize()
 {
-    // Setup SQLite database
-    m_database = QSqlDatabase::addDatabase("QSQLITE", "ShipConnection");
-    
     // Set database path to project folder data/shipsdb.db
     QString appDirPath = QCoreApplication::applicationDirPath();
     QString projectRoot;
@@ -57,24 +54,37 @@ bool DatabaseShipConnection::initialize()
     
     QString dbPath = QDir(projectRoot).absoluteFilePath("data/shipsdb.db");
     
-    // Create database directory if it doesn't exist
-    QDir dbDir = QFileInfo(dbPath).absoluteDir();
-    if (!dbDir.exists()) {
-        dbDir.mkpath(".");
+    if (!initialize(dbPath)) {
+        qCritical() << "  Project root:" << projectRoot;
+        qCritical() << "  App dir:" << appDirPath;
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseShipConnection::initialize(const QString &databasePath)
+{
+    // Setup SQLite database
+    m_database = QSqlDatabase::addDatabase("QSQLITE", "ShipConnection");
+
+    // Create database directory if it doesn't exist (skip for in-memory databases)
+    if (databasePath != QLatin1String(":memory:")) {
+        QDir dbDir = QFileInfo(databasePath).absoluteDir();
+        if (!dbDir.exists()) {
+            dbDir.mkpath(".");
+        }
     }
     
-    m_database.setDatabaseName(dbPath);
+    m_database.setDatabaseName(databasePath);
     
     if (!m_database.open()) {
         m_lastError = QString("Failed to open ship database: %1").arg(m_database.lastError().text());
         qCritical() << "DatabaseShipConnection::initialize() -" << m_lastError;
-        qCritical() << "  Attempted path:" << dbPath;
-        qCritical() << "  Project root:" << projectRoot;
-        qCritical() << "  App dir:" << appDirPath;
+        qCritical() << "  Attempted path:" << databasePath;
         return false;
     }
     
-    qDebug() << "DatabaseShipConnection::initialize() - Ship database opened:" << dbPath;
+    qDebug() << "DatabaseShipConnection::initialize() - Ship database opened:" << databasePath;
     emit connectionEstablished();
     
     qDebug() << "DatabaseShipConnection::initialize() - Successfully initialized ship database";
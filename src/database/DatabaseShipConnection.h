@@ -13,6 +13,8 @@ public:
     static DatabaseShipConnection& instance();
     
     bool initialize();
+    // Open an explicit database file (or ":memory:"), e.g. for tools and benchmarks
+    bool initialize(const QString &databasePath);
     void close();
     bool isConnected() const;
     QSqlDatabase getDatabase() const;
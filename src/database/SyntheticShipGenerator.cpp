@@ -0,0 +1,366 @@
+#include "SyntheticShipGenerator.h"
+#include "DatabaseConnection.h"
+#include "DatabaseShipConnection.h"
+#include "models/FrameArrangementXZ.h"
+#include "models/FrameArrangementYZ.h"
+#include "models/StructureProfileTable.h"
+#include "models/LinearIsotropicMaterials.h"
+#include "../core/ProfileFormulas.h"
+#include "../core/YZNaming.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QRandomGenerator>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+namespace {
+
+// Bind every column as a batch and run it inside a single transaction
+bool execBatchInTransaction(QSqlDatabase &db, const QString &deleteSql, const QString &insertSql,
+                            std::initializer_list<const QVariantList *> columns, QString &error)
+{
+    if (!db.transaction()) {
+        error = db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (!deleteSql.isEmpty() && !query.exec(deleteSql)) {
+        error = query.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    if (!query.prepare(insertSql)) {
+        error = query.lastError().text();
+        db.rollback();
+        return false;
+    }
+    for (const QVariantList *column : columns)
+        query.addBindValue(*column);
+
+    if (!query.execBatch()) {
+        error = query.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        error = db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+
+double roundTo(double value, double step)
+{
+    return std::round(value / step) * step;
+}
+
+} // namespace
+
+SyntheticShipGenerator::SyntheticShipGenerator(const Spec &spec)
+    : m_spec(spec)
+{
+}
+
+int SyntheticShipGenerator::spacingForFrame(const QVector<SpacingZone> &zones, int frameNumber)
+{
+    return FrameCoordinates::spacingForFrame(zones, frameNumber);
+}
+
+QVector<int> SyntheticShipGenerator::frameNumbers(const QVector<SpacingZone> &zones)
+{
+    return FrameCoordinates::frameNumbers(zones);
+}
+
+bool SyntheticShipGenerator::generate()
+{
+    return generateShip() && generateLibrary();
+}
+
+bool SyntheticShipGenerator::generateShip()
+{
+    return generateFrameXZ() && generateFrameYZ();
+}
+
+bool SyntheticShipGenerator::generateLibrary()
+{
+    return generateMaterials() && generateProfiles();
+}
+
+bool SyntheticShipGenerator::generateFrameXZ()
+{
+    QSqlDatabase db = DatabaseShipConnection::instance().getDatabase();
+    if (!db.isValid() || !db.isOpen()) {
+        setError("generateFrameXZ", "Ship database is not connected");
+        return false;
+    }
+
+    FrameArrangementXZ table;
+    if (!table.createTable()) {
+        setError("generateFrameXZ", "Failed to create XZ table");
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Same names and coordinates as the zone generator of the XZ table; only xp_coor is
+    // stored, the length ratios are derived on read
+    const QVector<FrameCoordinates::FrameRow> rows = FrameCoordinates::rowsFromZones(m_spec.zones, m_spec.ml, 0.0, 0.0);
+    QVariantList names, frameNumberList, spacings, mls, xps;
+    for (const FrameCoordinates::FrameRow &row : rows) {
+        names << row.frameName;
+        frameNumberList << row.frameNumber;
+        spacings << row.frameSpacing;
+        mls << row.ml;
+        xps << row.xpCoor;
+    }
+
+    QString error;
+    const QString deleteSql = m_spec.replaceExisting
+        ? QStringLiteral("DELETE FROM structure_seagoing_ship_section0_frame_arrangement_xz")
+        : QString();
+    if (!execBatchInTransaction(db, deleteSql,
+                                "INSERT INTO structure_seagoing_ship_section0_frame_arrangement_xz "
+                                "(frame_name, frame_number, frame_spacing, ml, xp_coor) "
+                                "VALUES (?, ?, ?, ?, ?)",
+                                { &names, &frameNumberList, &spacings, &mls, &xps },
+                                error)) {
+        setError("generateFrameXZ", error);
+        return false;
+    }
+
+    m_summary.frames = int(rows.size());
+    qDebug() << "SyntheticShipGenerator::generateFrameXZ() - Inserted" << m_summary.frames
+             << "frames in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool SyntheticShipGenerator::generateFrameYZ()
+{
+    QSqlDatabase db = DatabaseShipConnection::instance().getDatabase();
+    if (!db.isValid() || !db.isOpen()) {
+        setError("generateFrameYZ", "Ship database is not connected");
+        return false;
+    }
+    if (m_spec.prefixes.isEmpty() || m_spec.symmetries.isEmpty()) {
+        setError("generateFrameYZ", "At least one prefix and one symmetry are required");
+        return false;
+    }
+
+    FrameArrangementYZ table;
+    if (!table.createTable()) {
+        setError("generateFrameYZ", "Failed to create YZ table");
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Sections are spread evenly over the generated frames
+    const QVector<int> allFrames = frameNumbers(m_spec.zones);
+    QVector<int> sectionFrames;
+    const int sectionCount = qMax(1, qMin(m_spec.yzFrameCount, int(allFrames.size())));
+    for (int i = 0; i < sectionCount; ++i)
+        sectionFrames.append(allFrames.isEmpty() ? i : allFrames.at(i * allFrames.size() / sectionCount));
+
+    QRandomGenerator random(m_spec.seed);
+    QHash<QString, int> nextSuffix;
+    const int linesPerGroup = qMax(1, m_spec.linesPerGroup);
+
+    // Appended groups continue after the suffixes each prefix already reserves
+    if (!m_spec.replaceExisting) {
+        QSqlQuery query(db);
+        if (!query.exec("SELECT prefix, MAX(suffix + COALESCE(no, 1)) FROM structure_seagoing_ship_section0_frame_arrangement_yz "
+                        "WHERE prefix IS NOT NULL GROUP BY prefix")) {
+            setError("generateFrameYZ", query.lastError().text());
+            return false;
+        }
+        while (query.next())
+            nextSuffix.insert(query.value(0).toString().toUpper(), query.value(1).toInt());
+    }
+
+    QVariantList names, nos, spacings, ys, zs, frameNos, fas, syms, manuals, namePrefixes, nameSuffixes;
+    for (int g = 0; g < m_spec.yzGroupCount; ++g) {
+        const QString prefix = m_spec.prefixes.at(g % m_spec.prefixes.size());
+        const QString sym = m_spec.symmetries.at(random.bounded(int(m_spec.symmetries.size())));
+        const bool horizontal = random.bounded(2) == 0;
+        const double spacing = roundTo(m_spec.minLineSpacing
+                                       + random.generateDouble() * (m_spec.maxLineSpacing - m_spec.minLineSpacing), 10.0);
+        const double offset = roundTo(random.bounded(20000), 10.0);
+
+        // Auto names are prefix + first suffix, and a group reserves "No" suffixes
+        int &suffix = nextSuffix[prefix.toUpper()];
+        const QString name = prefix + QString::number(suffix);
+        QString namePrefix; int nameSuffix = 0;
+        YZNaming::parsePrefixSuffix(name, namePrefix, nameSuffix);
+        names << name;
+        namePrefixes << namePrefix;
+        nameSuffixes << nameSuffix;
+        suffix += linesPerGroup;
+
+        nos << linesPerGroup;
+        spacings << spacing;
+        // Unused coordinate is stored as an empty string, exactly like the YZ input table does
+        ys << (horizontal ? QVariant(QString()) : QVariant(offset));
+        zs << (horizontal ? QVariant(offset) : QVariant(QString()));
+        frameNos << sectionFrames.at(g % sectionFrames.size());
+        fas << QStringLiteral("A");
+        syms << sym;
+        manuals << 0;
+    }
+
+    QString error;
+    const QString deleteSql = m_spec.replaceExisting
+        ? QStringLiteral("DELETE FROM structure_seagoing_ship_section0_frame_arrangement_yz")
+        : QString();
+    if (!execBatchInTransaction(db, deleteSql,
+                                "INSERT INTO structure_seagoing_ship_section0_frame_arrangement_yz "
+                                "(name, no, spacing, y, z, frame_no, fa, sym, is_manual, prefix, suffix) "
+                                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                                { &names, &nos, &spacings, &ys, &zs, &frameNos, &fas, &syms, &manuals,
+                                  &namePrefixes, &nameSuffixes },
+                                error)) {
+        setError("generateFrameYZ", error);
+        return false;
+    }
+
+    m_summary.yzGroups = m_spec.yzGroupCount;
+    m_summary.yzLines = m_spec.yzGroupCount * linesPerGroup;
+    qDebug() << "SyntheticShipGenerator::generateFrameYZ() - Inserted" << m_summary.yzGroups
+             << "groups (" << m_summary.yzLines << "lines ) in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool SyntheticShipGenerator::generateProfiles()
+{
+    if (!DatabaseConnection::instance().isConnected()) {
+        setError("generateProfiles", "Database is not connected");
+        return false;
+    }
+
+    StructureProfileTable table;
+    if (!table.createTable()) {
+        setError("generateProfiles", "Failed to create profile table");
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    static const char *types[] = { "T", "HP", "L" };
+    QRandomGenerator random(m_spec.seed ^ 0x9e3779b9u);
+    QVariantList typeList, names, hws, tws, bfs, tfs, areas, es, ws, upperIs, lowerLs, tbs, bfBrackets, tbfs;
+    for (int i = 0; i < m_spec.profileCount; ++i) {
+        const QString type = QString::fromLatin1(types[i % 3]);
+        const double hw = 100.0 + 10.0 * random.bounded(50);   // 100 .. 590 mm
+        const double tw = 6.0 + random.bounded(15);            // 6 .. 20 mm
+        const bool flanged = (type != QLatin1String("HP"));
+        const double bf = flanged ? 50.0 + 10.0 * random.bounded(16) : 0.0;
+        const double tf = flanged ? 8.0 + random.bounded(17) : 0.0;
+
+        // Same formulas as the profile table, so the rows need no recalculation
+        const ProfileFormulas::SectionProperties section = ProfileFormulas::sectionProperties(hw, tw, bf, tf, type);
+        const ProfileFormulas::BracketSizes brackets = ProfileFormulas::bracketSizes(tw, section.w, m_spec.rehProfile,
+                                                                                     m_spec.rehBracket);
+
+        typeList << type;
+        names << QStringLiteral("%1 %2x%3/%4x%5").arg(type).arg(hw).arg(tw).arg(bf).arg(tf);
+        hws << hw;
+        tws << tw;
+        bfs << bf;
+        tfs << tf;
+        areas << section.area;
+        es << section.e;
+        ws << section.w;
+        upperIs << section.upperI;
+        lowerLs << brackets.l;
+        tbs << brackets.tb;
+        bfBrackets << brackets.bf;
+        tbfs << brackets.tbf;
+    }
+
+    QSqlDatabase db = DatabaseConnection::instance().database();
+    QString error;
+    const QString deleteSql = m_spec.replaceExisting
+        ? QStringLiteral("DELETE FROM structure_seagoing_ship_section0_profile_table")
+        : QString();
+    if (!execBatchInTransaction(db, deleteSql,
+                                "INSERT INTO structure_seagoing_ship_section0_profile_table "
+                                "(type, name, hw, tw, bf_profiles, tf, area, e, w, upper_i, lower_l, tb, bf_brackets, tbf) "
+                                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                                { &typeList, &names, &hws, &tws, &bfs, &tfs, &areas, &es, &ws,
+                                  &upperIs, &lowerLs, &tbs, &bfBrackets, &tbfs },
+                                error)) {
+        setError("generateProfiles", error);
+        return false;
+    }
+
+    m_summary.profiles = m_spec.profileCount;
+    qDebug() << "SyntheticShipGenerator::generateProfiles() - Inserted" << m_summary.profiles
+             << "profiles in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool SyntheticShipGenerator::generateMaterials()
+{
+    if (!DatabaseConnection::instance().isConnected()) {
+        setError("generateMaterials", "Database is not connected");
+        return false;
+    }
+
+    LinearIsotropicMaterials table;
+    if (!table.createTable()) {
+        setError("generateMaterials", "Failed to create materials table");
+        return false;
+    }
+
+    // Typical hull steel grades: normal strength and higher strength steels
+    static const int yieldStresses[] = { 235, 315, 355, 390 };
+    static const int tensileStrengths[] = { 400, 440, 490, 510 };
+
+    QVariantList matNos, eMods, gMods, densities, yields, tensiles, remarks;
+    for (int i = 0; i < m_spec.materialCount; ++i) {
+        const int grade = i % 4;
+        matNos << i + 1;
+        eMods << 206000;
+        gMods << 79000;
+        densities << 7850;
+        yields << yieldStresses[grade];
+        tensiles << tensileStrengths[grade];
+        remarks << QStringLiteral("Synthetic ReH %1").arg(yieldStresses[grade]);
+    }
+
+    QSqlDatabase db = DatabaseConnection::instance().database();
+    QString error;
+    const QString deleteSql = m_spec.replaceExisting
+        ? QStringLiteral("DELETE FROM structure_seagoing_ship_section0_linear_isotropic_materials")
+        : QString();
+    if (!execBatchInTransaction(db, deleteSql,
+                                "INSERT INTO structure_seagoing_ship_section0_linear_isotropic_materials "
+                                "(mat_no, e_modulus, g_modulus, material_density, yield_stress, tensile_strength, remark) "
+                                "VALUES (?, ?, ?, ?, ?, ?, ?)",
+                                { &matNos, &eMods, &gMods, &densities, &yields, &tensiles, &remarks },
+                                error)) {
+        setError("generateMaterials", error);
+        return false;
+    }
+
+    m_summary.materials = m_spec.materialCount;
+    qDebug() << "SyntheticShipGenerator::generateMaterials() - Inserted" << m_summary.materials << "materials";
+    return true;
+}
+
+void SyntheticShipGenerator::setError(const QString &function, const QString &message)
+{
+    m_lastError = message;
+    qCritical() << QString("SyntheticShipGenerator::%1() -").arg(function) << m_lastError;
+}
@@ -0,0 +1,88 @@
+#ifndef SYNTHETICSHIPGENERATOR_H
+#define SYNTHETICSHIPGENERATOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "../core/FrameCoordinates.h"
+
+/**
+ * Generator for parameterised synthetic ships used in load and performance testing.
+ *
+ * Writes straight into the ship schema (frame arrangement XZ/YZ) and the library schema
+ * (profile table, linear isotropic materials) with one prepared statement and one
+ * transaction per table. The same Spec and seed always produce the same rows.
+ */
+class SyntheticShipGenerator
+{
+public:
+    // Frames [startFrame, endFrame) use spacing (mm); the last zone also includes endFrame
+    using SpacingZone = FrameCoordinates::SpacingZone;
+
+    struct Spec {
+        quint32 seed = 1;
+        bool replaceExisting = true;         // delete existing rows before generating
+
+        // Frame arrangement XZ
+        QVector<SpacingZone> zones = { {-5, 0, 600}, {0, 180, 700}, {180, 210, 600} };
+        QString ml = QStringLiteral("FORWARD");
+
+        // Frame arrangement YZ (longitudinal groups)
+        int yzGroupCount = 1000;
+        int linesPerGroup = 10;              // "No" column
+        double minLineSpacing = 500.0;       // mm
+        double maxLineSpacing = 900.0;       // mm
+        QStringList prefixes = { QStringLiteral("L"), QStringLiteral("B"), QStringLiteral("D"), QStringLiteral("S") };
+        QStringList symmetries = { QStringLiteral("P"), QStringLiteral("S"), QStringLiteral("P+S") };
+        int yzFrameCount = 20;               // distinct frame numbers that carry YZ sections
+
+        // Library
+        int profileCount = 100;
+        int materialCount = 5;
+        double rehProfile = 235.0;           // N/mm2, for the generated bracket sizes
+        double rehBracket = 235.0;           // N/mm2
+    };
+
+    struct Summary {
+        int frames = 0;
+        int yzGroups = 0;
+        int yzLines = 0;
+        int profiles = 0;
+        int materials = 0;
+    };
+
+    explicit SyntheticShipGenerator(const Spec &spec = Spec());
+
+    const Spec &spec() const { return m_spec; }
+    void setSpec(const Spec &spec) { m_spec = spec; }
+
+    // Ship database (DatabaseShipConnection): XZ frames and YZ longitudinal groups
+    bool generateShip();
+    bool generateFrameXZ();
+    bool generateFrameYZ();
+
+    // Library database (DatabaseConnection): profiles and materials
+    bool generateLibrary();
+    bool generateProfiles();
+    bool generateMaterials();
+
+    // Both databases
+    bool generate();
+
+    Summary summary() const { return m_summary; }
+    QString lastError() const { return m_lastError; }
+
+    // Spacing (mm) of frame number n under the given zones; 0 when no zone covers n
+    static int spacingForFrame(const QVector<SpacingZone> &zones, int frameNumber);
+    // All frame numbers covered by the zones, ascending and without duplicates
+    static QVector<int> frameNumbers(const QVector<SpacingZone> &zones);
+
+private:
+    Spec m_spec;
+    Summary m_summary;
+    QString m_lastError;
+
+    void setError(const QString &function, const QString &message);
+};
+
+#endif // SYNTHETICSHIPGENERATOR_H
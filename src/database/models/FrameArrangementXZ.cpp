@@ -4,9 +4,12 @@
 #include <QSqlError>
 #include <QVariant>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 FrameArrangementXZ::FrameArrangementXZ(QObject *parent)
-    : QAbstractListModel(parent)
+    : QAbstractListModel(parent), m_lpp(87.780), m_upperL(87.7824)
 {
 }
 
@@ -37,11 +40,11 @@ QVariant FrameArrangementXZ::data(const QModelIndex &index, int role) const
     case XpCoorRole:
         return frame.xpCoor;
     case XlRole:
-        return frame.xl;
+        return m_xl.at(index.row());
     case XllCoorRole:
-        return frame.xllCoor;
+        return m_xpCoor.at(index.row());
     case XllLllRole:
-        return frame.xllLll;
+        return m_xllLll.at(index.row());
     default:
         return QVariant();
     }
@@ -111,7 +114,7 @@ bool FrameArrangementXZ::loadData()
     }
 
     QSqlQuery query(db);
-    query.prepare("SELECT id, frame_name, frame_number, frame_spacing, ml, xp_coor, x_l, xll_coor, xll_lll, created_at, updated_at FROM structure_seagoing_ship_section0_frame_arrangement_xz ORDER BY id");
+    query.prepare("SELECT id, frame_name, frame_number, frame_spacing, ml, xp_coor, created_at, updated_at FROM structure_seagoing_ship_section0_frame_arrangement_xz ORDER BY id");
 
     if (!query.exec()) {
         m_lastError = QString("Failed to load frame arrangement XZ data: %1").arg(query.lastError().text());
@@ -131,14 +134,15 @@ bool FrameArrangementXZ::loadData()
         frame.frameSpacing = query.value(3).toInt();           // Changed to toInt()
         frame.ml = query.value(4).toString();                  // Changed to toString()
         frame.xpCoor = query.value(5).toDouble();
-        frame.xl = query.value(6).toDouble();
-        frame.xllCoor = query.value(7).toDouble();
-        frame.xllLll = query.value(8).toDouble();
-        frame.createdAt = query.value(9).toLongLong();         // Added timestamp
-        frame.updatedAt = query.value(10).toLongLong();        // Added timestamp
+        frame.createdAt = query.value(6).toLongLong();         // Added timestamp
+        frame.updatedAt = query.value(7).toLongLong();         // Added timestamp
 
+        m_indexById.insert(frame.id, m_frameData.size());
         m_frameData.append(frame);
+        m_xpCoor.append(frame.xpCoor);
     }
+    recomputeDerived();
+    rebuildPositionIndex();
 
     endResetModel();
     emit dataChanged();
@@ -148,7 +152,7 @@ bool FrameArrangementXZ::loadData()
 }
 
 bool FrameArrangementXZ::insertFrame(const QString &frameName, int frameNumber, int frameSpacing,
-                                    const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll)
+                                    const QString &ml, double xpCoor)
 {
     QSqlDatabase db = getDatabase();
     if (!db.isValid()) {
@@ -160,17 +164,14 @@ bool FrameArrangementXZ::insertFrame(const QString &frameName, int frameNumber,
 
     QSqlQuery query(db);
     query.prepare("INSERT INTO structure_seagoing_ship_section0_frame_arrangement_xz "
-                  "(frame_name, frame_number, frame_spacing, ml, xp_coor, x_l, xll_coor, xll_lll) "
-                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+                  "(frame_name, frame_number, frame_spacing, ml, xp_coor) "
+                  "VALUES (?, ?, ?, ?, ?)");
     
     query.addBindValue(frameName);
     query.addBindValue(frameNumber);
     query.addBindValue(frameSpacing);
     query.addBindValue(ml);
     query.addBindValue(xpCoor);
-    query.addBindValue(xl);
-    query.addBindValue(xllCoor);
-    query.addBindValue(xllLll);
 
     if (!query.exec()) {
         m_lastError = QString("Failed to insert frame: %1").arg(query.lastError().text());
@@ -185,7 +186,7 @@ bool FrameArrangementXZ::insertFrame(const QString &frameName, int frameNumber,
 }
 
 bool FrameArrangementXZ::updateFrame(int id, const QString &frameName, int frameNumber, int frameSpacing,
-                                    const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll)
+                                    const QString &ml, double xpCoor)
 {
     QSqlDatabase db = getDatabase();
     if (!db.isValid()) {
@@ -197,7 +198,7 @@ bool FrameArrangementXZ::updateFrame(int id, const QString &frameName, int frame
 
     QSqlQuery query(db);
     query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_xz "
-                  "SET frame_name=?, frame_number=?, frame_spacing=?, ml=?, xp_coor=?, x_l=?, xll_coor=?, xll_lll=?, updated_at=strftime('%s','now') * 1000 "
+                  "SET frame_name=?, frame_number=?, frame_spacing=?, ml=?, xp_coor=?, updated_at=strftime('%s','now') * 1000 "
                   "WHERE id=?");
     
     query.addBindValue(frameName);
@@ -205,9 +206,6 @@ bool FrameArrangementXZ::updateFrame(int id, const QString &frameName, int frame
     query.addBindValue(frameSpacing);
     query.addBindValue(ml);
     query.addBindValue(xpCoor);
-    query.addBindValue(xl);
-    query.addBindValue(xllCoor);
-    query.addBindValue(xllLll);
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -315,7 +313,7 @@ QVariantMap FrameArrangementXZ::getFrameById(int id)
     }
 
     QSqlQuery query(db);
-    query.prepare("SELECT id, frame_name, frame_number, frame_spacing, ml, xp_coor, x_l, xll_coor, xll_lll, created_at, updated_at "
+    query.prepare("SELECT id, frame_name, frame_number, frame_spacing, ml, xp_coor, created_at, updated_at "
                   "FROM structure_seagoing_ship_section0_frame_arrangement_xz WHERE id=?");
     query.addBindValue(id);
 
@@ -332,12 +330,13 @@ QVariantMap FrameArrangementXZ::getFrameById(int id)
         result["frameNumber"] = query.value(2).toInt();
         result["frameSpacing"] = query.value(3).toInt();       // Changed to toInt()
         result["ml"] = query.value(4).toString();              // Changed to toString()
-        result["xpCoor"] = query.value(5).toDouble();
-        result["xl"] = query.value(6).toDouble();
-        result["xllCoor"] = query.value(7).toDouble();
-        result["xllLll"] = query.value(8).toDouble();
-        result["createdAt"] = query.value(9).toLongLong();     // Added timestamp
-        result["updatedAt"] = query.value(10).toLongLong();    // Added timestamp
+        const double xpCoor = query.value(5).toDouble();
+        result["xpCoor"] = xpCoor;
+        result["xl"] = m_lpp > 0.0 ? xpCoor / m_lpp : 0.0;
+        result["xllCoor"] = xpCoor;
+        result["xllLll"] = m_upperL > 0.0 ? xpCoor / m_upperL : 0.0;
+        result["createdAt"] = query.value(6).toLongLong();     // Added timestamp
+        result["updatedAt"] = query.value(7).toLongLong();     // Added timestamp
     }
 
     return result;
@@ -368,6 +367,126 @@ bool FrameArrangementXZ::resetDatabase()
     return true;
 }
 
+bool FrameArrangementXZ::updateCoordinatesBatch(const QList<CoordinateUpdate> &updates)
+{
+    if (updates.isEmpty())
+        return true;
+
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementXZ::updateCoordinatesBatch() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVariantList xpCoors, ids;
+    for (const CoordinateUpdate &update : updates) {
+        xpCoors << update.xpCoor;
+        ids << update.id;
+    }
+
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "FrameArrangementXZ::updateCoordinatesBatch() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_xz "
+                  "SET xp_coor=?, updated_at=strftime('%s','now') * 1000 "
+                  "WHERE id=?");
+    query.addBindValue(xpCoors);
+    query.addBindValue(ids);
+
+    const bool executed = query.execBatch();
+    if (!executed || !db.commit()) {
+        m_lastError = QString("Failed to update frame coordinates: %1").arg(executed ? db.lastError().text() : query.lastError().text());
+        qCritical() << "FrameArrangementXZ::updateCoordinatesBatch() -" << m_lastError;
+        db.rollback();
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    qDebug() << "FrameArrangementXZ::updateCoordinatesBatch() - Updated" << updates.size() << "frames";
+    loadData(); // Reload data to update the model
+    return true;
+}
+
+bool FrameArrangementXZ::writeFramesBatch(const QVector<FrameCoordinates::FrameRow> &rows, bool replaceExisting)
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementXZ::writeFramesBatch() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVariantList names, numbers, spacings, mls, xps;
+    QVariantList updXps, updIds;
+    for (const FrameCoordinates::FrameRow &row : rows) {
+        if (row.id > 0 && !replaceExisting) {
+            updXps << row.xpCoor;
+            updIds << row.id;
+            continue;
+        }
+        names << row.frameName;
+        numbers << row.frameNumber;
+        spacings << row.frameSpacing;
+        mls << row.ml;
+        xps << row.xpCoor;
+    }
+
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "FrameArrangementXZ::writeFramesBatch() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool ok = true;
+
+    if (replaceExisting)
+        ok = query.exec("DELETE FROM structure_seagoing_ship_section0_frame_arrangement_xz");
+
+    if (ok && !names.isEmpty()) {
+        query.prepare("INSERT INTO structure_seagoing_ship_section0_frame_arrangement_xz "
+                      "(frame_name, frame_number, frame_spacing, ml, xp_coor) "
+                      "VALUES (?, ?, ?, ?, ?)");
+        query.addBindValue(names);
+        query.addBindValue(numbers);
+        query.addBindValue(spacings);
+        query.addBindValue(mls);
+        query.addBindValue(xps);
+        ok = query.execBatch();
+    }
+
+    if (ok && !updIds.isEmpty()) {
+        query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_xz "
+                      "SET xp_coor=?, updated_at=strftime('%s','now') * 1000 "
+                      "WHERE id=?");
+        query.addBindValue(updXps);
+        query.addBindValue(updIds);
+        ok = query.execBatch();
+    }
+
+    if (!ok || !db.commit()) {
+        m_lastError = QString("Failed to write frames: %1").arg(ok ? db.lastError().text() : query.lastError().text());
+        qCritical() << "FrameArrangementXZ::writeFramesBatch() -" << m_lastError;
+        db.rollback();
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    qDebug() << "FrameArrangementXZ::writeFramesBatch() - Inserted" << names.size()
+             << "frames, updated" << updIds.size();
+    loadData(); // Reload data to update the model
+    return true;
+}
+
 int FrameArrangementXZ::getRowCount() const
 {
     return m_frameData.size();
@@ -385,9 +504,9 @@ QVariantMap FrameArrangementXZ::getFrameAtIndex(int index) const
         result["frameSpacing"] = frame.frameSpacing;
         result["ml"] = frame.ml;
         result["xpCoor"] = frame.xpCoor;
-        result["xl"] = frame.xl;
-        result["xllCoor"] = frame.xllCoor;
-        result["xllLll"] = frame.xllLll;
+        result["xl"] = m_xl.at(index);
+        result["xllCoor"] = m_xpCoor.at(index);
+        result["xllLll"] = m_xllLll.at(index);
         result["createdAt"] = frame.createdAt;
         result["updatedAt"] = frame.updatedAt;
     }
@@ -395,9 +514,148 @@ QVariantMap FrameArrangementXZ::getFrameAtIndex(int index) const
     return result;
 }
 
+int FrameArrangementXZ::indexOfId(int id) const
+{
+    return m_indexById.value(id, -1);
+}
+
+void FrameArrangementXZ::setShipLengths(double lpp, double upperL)
+{
+    if (lpp == m_lpp && upperL == m_upperL)
+        return;
+    m_lpp = lpp;
+    m_upperL = upperL;
+    recomputeDerived();
+
+    if (!m_frameData.isEmpty()) {
+        emit QAbstractItemModel::dataChanged(index(0), index(m_frameData.size() - 1),
+                                             { XlRole, XllCoorRole, XllLllRole });
+    }
+    qDebug() << "FrameArrangementXZ::setShipLengths() - Lpp" << m_lpp << "L" << m_upperL;
+}
+
+void FrameArrangementXZ::recomputeDerived()
+{
+    const qsizetype n = m_xpCoor.size();
+    m_xl.resize(n);
+    m_xllLll.resize(n);
+
+    // Multiply by the reciprocal in a flat loop so the compiler can vectorise it
+    const double invLpp = m_lpp > 0.0 ? 1.0 / m_lpp : 0.0;
+    const double invUpperL = m_upperL > 0.0 ? 1.0 / m_upperL : 0.0;
+    const double *xp = m_xpCoor.constData();
+    double *xl = m_xl.data();
+    double *xllLll = m_xllLll.data();
+    for (qsizetype i = 0; i < n; ++i) {
+        xl[i] = xp[i] * invLpp;
+        xllLll[i] = xp[i] * invUpperL;
+    }
+}
+
+void FrameArrangementXZ::rebuildPositionIndex()
+{
+    const int n = m_xpCoor.size();
+    m_rowsByXp.resize(n);
+    for (int i = 0; i < n; ++i)
+        m_rowsByXp[i] = i;
+
+    // Ties on xp (duplicate rows) keep the frame number order
+    std::sort(m_rowsByXp.begin(), m_rowsByXp.end(), [this](int a, int b) {
+        if (m_xpCoor.at(a) != m_xpCoor.at(b))
+            return m_xpCoor.at(a) < m_xpCoor.at(b);
+        return m_frameData.at(a).frameNumber < m_frameData.at(b).frameNumber;
+    });
+
+    m_sortedXp.resize(n);
+    for (int i = 0; i < n; ++i)
+        m_sortedXp[i] = m_xpCoor.at(m_rowsByXp.at(i));
+}
+
+int FrameArrangementXZ::nearestIndexAt(double x) const
+{
+    if (m_sortedXp.isEmpty())
+        return -1;
+
+    const auto it = std::lower_bound(m_sortedXp.cbegin(), m_sortedXp.cend(), x);
+    int pos = int(it - m_sortedXp.cbegin());
+    if (pos == m_sortedXp.size())
+        pos = m_sortedXp.size() - 1;
+    else if (pos > 0 && x - m_sortedXp.at(pos - 1) <= m_sortedXp.at(pos) - x)
+        pos = pos - 1;
+    return m_rowsByXp.at(pos);
+}
+
+QVector<int> FrameArrangementXZ::indicesBetween(double x1, double x2) const
+{
+    if (x1 > x2)
+        std::swap(x1, x2);
+
+    const auto first = std::lower_bound(m_sortedXp.cbegin(), m_sortedXp.cend(), x1);
+    const auto last = std::upper_bound(first, m_sortedXp.cend(), x2);
+    const int begin = int(first - m_sortedXp.cbegin());
+    const int end = int(last - m_sortedXp.cbegin());
+    return m_rowsByXp.mid(begin, end - begin);
+}
+
+double FrameArrangementXZ::fractionalFrameAt(double x) const
+{
+    const int n = m_sortedXp.size();
+    if (n == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    // Outside the table extrapolate with the spacing of the end frame
+    if (x <= m_sortedXp.first() || x >= m_sortedXp.last() || n == 1) {
+        const FrameData &end = m_frameData.at(x <= m_sortedXp.first() ? m_rowsByXp.first() : m_rowsByXp.last());
+        if (end.frameSpacing <= 0)
+            return end.frameNumber;
+        return end.frameNumber + (x - end.xpCoor) * 1000.0 / end.frameSpacing;
+    }
+
+    const int hi = int(std::upper_bound(m_sortedXp.cbegin(), m_sortedXp.cend(), x) - m_sortedXp.cbegin());
+    const int lo = hi - 1;
+    const double x0 = m_sortedXp.at(lo);
+    const double x1 = m_sortedXp.at(hi);
+    const int f0 = m_frameData.at(m_rowsByXp.at(lo)).frameNumber;
+    const int f1 = m_frameData.at(m_rowsByXp.at(hi)).frameNumber;
+    if (x1 <= x0)
+        return f0;
+    return f0 + (f1 - f0) * (x - x0) / (x1 - x0);
+}
+
+QVariantMap FrameArrangementXZ::nearestFrameAt(double x) const
+{
+    const int row = nearestIndexAt(x);
+    if (row < 0)
+        return QVariantMap();
+
+    QVariantMap result = getFrameAtIndex(row);
+    result["index"] = row;
+    result["distance"] = std::abs(m_xpCoor.at(row) - x);
+    return result;
+}
+
+QVariantList FrameArrangementXZ::framesBetween(double x1, double x2) const
+{
+    QVariantList result;
+    const QVector<int> rows = indicesBetween(x1, x2);
+    result.reserve(rows.size());
+    for (int row : rows) {
+        QVariantMap frame = getFrameAtIndex(row);
+        frame["index"] = row;
+        result.append(frame);
+    }
+    return result;
+}
+
 void FrameArrangementXZ::clearData()
 {
     m_frameData.clear();
+    m_indexById.clear();
+    m_xpCoor.clear();
+    m_xl.clear();
+    m_xllLll.clear();
+    m_rowsByXp.clear();
+    m_sortedXp.clear();
 }
 
 QSqlDatabase FrameArrangementXZ::getDatabase() const
@@ -7,6 +7,7 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
+#include "../../core/FrameCoordinates.h"
 
 class FrameArrangementXZ : public QAbstractListModel
 {
@@ -31,14 +32,16 @@ public:
         int frameNumber;
         int frameSpacing;        // Changed from double to int
         QString ml;              // Changed from double to QString
-        double xpCoor;
-        double xl;
-        double xllCoor;
-        double xllLll;
+        double xpCoor;           // xl, xllCoor and xllLll are derived on read, see setShipLengths()
         qint64 createdAt;        // Added timestamp
         qint64 updatedAt;        // Added timestamp
     };
 
+    struct CoordinateUpdate {
+        int id;
+        double xpCoor;
+    };
+
     explicit FrameArrangementXZ(QObject *parent = nullptr);
     
     // QAbstractListModel interface
@@ -49,19 +52,45 @@ public:
     // Database operations
     Q_INVOKABLE bool createTable();
     Q_INVOKABLE bool loadData();
+    // Only xp_coor is written; x/Lpp, xll and x/L are derived from it on read, see
+    // setShipLengths(). The legacy x_l, xll_coor and xll_lll columns are left as they are
     Q_INVOKABLE bool insertFrame(const QString &frameName, int frameNumber, int frameSpacing, 
-                                const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll);
+                                const QString &ml, double xpCoor);
     Q_INVOKABLE bool updateFrame(int id, const QString &frameName, int frameNumber, int frameSpacing,
-                                const QString &ml, double xpCoor, double xl, double xllCoor, double xllLll);
+                                const QString &ml, double xpCoor);
     Q_INVOKABLE bool updateFrameMl(int id, const QString &ml);
     Q_INVOKABLE bool deleteFrame(int id);
     Q_INVOKABLE int getLastId();
     Q_INVOKABLE QVariantMap getFrameById(int id);
     Q_INVOKABLE bool resetDatabase();
+    // Writes many coordinate changes in one transaction and reloads the model once
+    bool updateCoordinatesBatch(const QList<CoordinateUpdate> &updates);
+    // Inserts rows with id 0 and updates the coordinates of the others in one transaction
+    // (optionally clearing the table first), then reloads the model once
+    bool writeFramesBatch(const QVector<FrameCoordinates::FrameRow> &rows, bool replaceExisting);
 
     // Utility functions
     Q_INVOKABLE int getRowCount() const;
     Q_INVOKABLE QVariantMap getFrameAtIndex(int index) const;
+    int indexOfId(int id) const;
+
+    // Lpp and scantling length L (m) used for the derived x/Lpp and x/L columns.
+    // Changing them only recomputes the in-memory columns, nothing is written to the database.
+    void setShipLengths(double lpp, double upperL);
+    double shipLength() const { return m_lpp; }
+    double shipLengthL() const { return m_upperL; }
+    const QList<FrameData> &frames() const { return m_frameData; }
+
+    // Position lookups (x in metres) over an in-memory index sorted by xpCoor, O(log n).
+    // Results are model row indices; -1 / empty when there are no frames.
+    int nearestIndexAt(double x) const;
+    QVector<int> indicesBetween(double x1, double x2) const;   // ordered by xpCoor, O(log n + k)
+    double fractionalFrameAt(double x) const;                   // interpolated frame number, NaN if empty
+
+    // QML wrappers, rows are returned in getFrameAtIndex() form
+    Q_INVOKABLE QVariantMap nearestFrameAt(double x) const;
+    Q_INVOKABLE QVariantList framesBetween(double x1, double x2) const;
+    Q_INVOKABLE double frameNumberAt(double x) const { return fractionalFrameAt(x); }
 
 signals:
     void dataChanged();
@@ -69,9 +98,23 @@ signals:
 
 private:
     QList<FrameData> m_frameData;
+    QHash<int, int> m_indexById;
     QString m_lastError;
+
+    // Derived columns as plain arrays, recomputed in one pass on load and on length change
+    QVector<double> m_xpCoor;
+    QVector<double> m_xl;
+    QVector<double> m_xllLll;
+    double m_lpp;
+    double m_upperL;
+
+    // Row indices ordered by xpCoor and the matching sorted xp values, rebuilt on load
+    QVector<int> m_rowsByXp;
+    QVector<double> m_sortedXp;
     
     void clearData();
+    void recomputeDerived();
+    void rebuildPositionIndex();
     QSqlDatabase getDatabase() const;
 };
 
@@ -0,0 +1,382 @@
+#include "FrameArrangementXZZones.h"
+#include "FrameArrangementXZ.h"
+#include "../DatabaseShipConnection.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Frame number of the first row whose stored xp is not the one the spacing rules give
+// (a hand-entered position); zones cannot carry such positions. Returns false when none.
+bool findAnchoredFrame(QVector<FrameCoordinates::FrameRow> rows, int &frameNumber)
+{
+    std::stable_sort(rows.begin(), rows.end(), [](const FrameCoordinates::FrameRow &a, const FrameCoordinates::FrameRow &b) {
+        return a.frameNumber < b.frameNumber;
+    });
+    QVector<FrameCoordinates::FrameRow> computed = rows;
+    FrameCoordinates::recompute(computed, 0.0, 0.0);
+    for (int i = 0; i < rows.size(); ++i) {
+        if (std::fabs(rows.at(i).xpCoor - computed.at(i).xpCoor) > 0.0005) {
+            frameNumber = rows.at(i).frameNumber;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+FrameArrangementXZZones::FrameArrangementXZZones(QObject *parent)
+    : QAbstractListModel(parent), m_lpp(87.780), m_upperL(87.7824)
+{
+}
+
+int FrameArrangementXZZones::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return m_table.rowCount();
+}
+
+QVariant FrameArrangementXZZones::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_table.rowCount())
+        return QVariant();
+
+    // Rows are not stored, only expanded from their zone when asked for
+    const FrameCoordinates::FrameRow frame = m_table.row(index.row(), m_lpp, m_upperL);
+
+    switch (role) {
+    case IdRole:
+        return frame.id;
+    case FrameNameRole:
+        return frame.frameName;
+    case FrameNumberRole:
+        return frame.frameNumber;
+    case FrameSpacingRole:
+        return frame.frameSpacing;
+    case MlRole:
+        return frame.ml;
+    case XpCoorRole:
+        return frame.xpCoor;
+    case XlRole:
+        return frame.xl;
+    case XllCoorRole:
+        return frame.xllCoor;
+    case XllLllRole:
+        return frame.xllLll;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> FrameArrangementXZZones::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[IdRole] = "id";
+    roles[FrameNameRole] = "frameName";
+    roles[FrameNumberRole] = "frameNumber";
+    roles[FrameSpacingRole] = "frameSpacing";
+    roles[MlRole] = "ml";
+    roles[XpCoorRole] = "xpCoor";
+    roles[XlRole] = "xl";
+    roles[XllCoorRole] = "xllCoor";
+    roles[XllLllRole] = "xllLll";
+    return roles;
+}
+
+bool FrameArrangementXZZones::createTable()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementXZZones::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    QString createTableSQL = R"(
+        CREATE TABLE IF NOT EXISTS structure_seagoing_ship_section0_frame_arrangement_xz_zones (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            start_frame INTEGER,
+            end_frame INTEGER,
+            frame_spacing INTEGER,
+            ml TEXT,
+            frame_name TEXT,
+            created_at INTEGER DEFAULT (strftime('%s','now') * 1000),
+            updated_at INTEGER DEFAULT (strftime('%s','now') * 1000)
+        )
+    )";
+
+    if (!query.exec(createTableSQL)) {
+        m_lastError = QString("Failed to create frame arrangement XZ zones table: %1").arg(query.lastError().text());
+        qCritical() << "FrameArrangementXZZones::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    qDebug() << "FrameArrangementXZZones::createTable() - Table created successfully";
+    return true;
+}
+
+bool FrameArrangementXZZones::loadData()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementXZZones::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (!query.exec("SELECT start_frame, end_frame, frame_spacing, ml, frame_name "
+                    "FROM structure_seagoing_ship_section0_frame_arrangement_xz_zones ORDER BY start_frame, id")) {
+        m_lastError = QString("Failed to load frame arrangement XZ zones: %1").arg(query.lastError().text());
+        qCritical() << "FrameArrangementXZZones::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVector<FrameZoneTable::Zone> zones;
+    while (query.next()) {
+        FrameZoneTable::Zone zone;
+        zone.startFrame = query.value(0).toInt();
+        zone.endFrame = query.value(1).toInt();
+        zone.spacing = query.value(2).toInt();
+        zone.ml = query.value(3).toString();
+        zone.frameName = query.value(4).toString();
+        zones.append(zone);
+    }
+
+    beginResetModel();
+    m_table.setZones(zones);
+    endResetModel();
+    emit dataChanged();
+
+    qDebug() << "FrameArrangementXZZones::loadData() - Loaded" << m_table.zoneCount()
+             << "zones," << m_table.rowCount() << "frames";
+    return true;
+}
+
+bool FrameArrangementXZZones::saveZones(const QVariantList &zones)
+{
+    QVector<FrameZoneTable::Zone> list;
+    list.reserve(zones.size());
+    for (const QVariant &item : zones) {
+        const QVariantMap map = item.toMap();
+        FrameZoneTable::Zone zone;
+        zone.startFrame = map.value("startFrame").toInt();
+        zone.endFrame = map.value("endFrame").toInt();
+        zone.spacing = map.value("spacing").toInt();
+        zone.ml = map.value("ml", QStringLiteral("FORWARD")).toString();
+        zone.frameName = map.value("frameName").toString();
+        if (zone.endFrame < zone.startFrame || zone.spacing <= 0) {
+            m_lastError = QString("Invalid spacing zone %1..%2 at %3 mm").arg(zone.startFrame).arg(zone.endFrame).arg(zone.spacing);
+            qWarning() << "FrameArrangementXZZones::saveZones() -" << m_lastError;
+            emit errorOccurred(m_lastError);
+            return false;
+        }
+        list.append(zone);
+    }
+
+    if (!writeZones(list))
+        return false;
+    loadData(); // Reload data to update the model
+    return true;
+}
+
+QVariantList FrameArrangementXZZones::getZones() const
+{
+    QVariantList result;
+    for (const FrameZoneTable::Zone &zone : m_table.zones()) {
+        QVariantMap map;
+        map["startFrame"] = zone.startFrame;
+        map["endFrame"] = zone.endFrame;
+        map["spacing"] = zone.spacing;
+        map["ml"] = zone.ml;
+        map["frameName"] = zone.frameName;
+        result.append(map);
+    }
+    return result;
+}
+
+bool FrameArrangementXZZones::importFromFrameTable()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementXZZones::importFromFrameTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (!query.exec("SELECT frame_name, frame_number, frame_spacing, ml, xp_coor "
+                    "FROM structure_seagoing_ship_section0_frame_arrangement_xz ORDER BY frame_number, id")) {
+        m_lastError = QString("Failed to read frame arrangement XZ data: %1").arg(query.lastError().text());
+        qCritical() << "FrameArrangementXZZones::importFromFrameTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVector<FrameCoordinates::FrameRow> rows;
+    while (query.next()) {
+        FrameCoordinates::FrameRow row;
+        row.frameName = query.value(0).toString();
+        row.frameNumber = query.value(1).toInt();
+        row.frameSpacing = query.value(2).toInt();
+        row.ml = query.value(3).toString();
+        row.xpCoor = query.value(4).toDouble();
+        rows.append(row);
+    }
+
+    int anchored = 0;
+    if (findAnchoredFrame(rows, anchored)) {
+        m_lastError = QString("Frame %1 has a hand-entered position, which cannot be stored as zones").arg(anchored);
+        qWarning() << "FrameArrangementXZZones::importFromFrameTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    bool lossless = true;
+    const FrameZoneTable table = FrameZoneTable::fromRows(rows, &lossless);
+    if (!lossless) {
+        m_lastError = "Frame table has duplicate frame numbers and cannot be stored as zones";
+        qWarning() << "FrameArrangementXZZones::importFromFrameTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    if (!writeZones(table.zones()))
+        return false;
+
+    qDebug() << "FrameArrangementXZZones::importFromFrameTable() -" << rows.size() << "frames as"
+             << table.zoneCount() << "zones";
+    loadData(); // Reload data to update the model
+    return true;
+}
+
+bool FrameArrangementXZZones::exportToFrameTable(QObject *frameModel)
+{
+    FrameArrangementXZ *model = qobject_cast<FrameArrangementXZ*>(frameModel);
+    if (!model) {
+        m_lastError = "Frame model not set";
+        qCritical() << "FrameArrangementXZZones::exportToFrameTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    // Rebuilding from zones would silently move hand-entered positions back onto the grid
+    QVector<FrameCoordinates::FrameRow> current;
+    current.reserve(model->frames().size());
+    for (const FrameArrangementXZ::FrameData &frame : model->frames()) {
+        FrameCoordinates::FrameRow row;
+        row.frameNumber = frame.frameNumber;
+        row.frameSpacing = frame.frameSpacing;
+        row.xpCoor = frame.xpCoor;
+        current.append(row);
+    }
+    int anchored = 0;
+    if (findAnchoredFrame(current, anchored)) {
+        m_lastError = QString("Frame %1 has a hand-entered position that the zones would overwrite").arg(anchored);
+        qWarning() << "FrameArrangementXZZones::exportToFrameTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    // One transaction and one reload of the per-frame model, which reports its own errors
+    return model->writeFramesBatch(m_table.toRows(m_lpp, m_upperL), true);
+}
+
+QVariantMap FrameArrangementXZZones::getFrameAtIndex(int index) const
+{
+    QVariantMap result;
+
+    if (index >= 0 && index < m_table.rowCount()) {
+        const FrameCoordinates::FrameRow frame = m_table.row(index, m_lpp, m_upperL);
+        result["id"] = frame.id;
+        result["frameName"] = frame.frameName;
+        result["frameNumber"] = frame.frameNumber;
+        result["frameSpacing"] = frame.frameSpacing;
+        result["ml"] = frame.ml;
+        result["xpCoor"] = frame.xpCoor;
+        result["xl"] = frame.xl;
+        result["xllCoor"] = frame.xllCoor;
+        result["xllLll"] = frame.xllLll;
+    }
+
+    return result;
+}
+
+void FrameArrangementXZZones::setShipLengths(double lpp, double upperL)
+{
+    if (lpp == m_lpp && upperL == m_upperL)
+        return;
+    m_lpp = lpp;
+    m_upperL = upperL;
+
+    // Ratios are computed per row on read, only the views need to refresh
+    if (m_table.rowCount() > 0) {
+        emit QAbstractItemModel::dataChanged(index(0), index(m_table.rowCount() - 1),
+                                             { XlRole, XllLllRole });
+    }
+}
+
+bool FrameArrangementXZZones::writeZones(const QVector<FrameZoneTable::Zone> &zones)
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementXZZones::writeZones() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVariantList starts, ends, spacings, mls, names;
+    for (const FrameZoneTable::Zone &zone : zones) {
+        starts << zone.startFrame;
+        ends << zone.endFrame;
+        spacings << zone.spacing;
+        mls << zone.ml;
+        names << zone.frameName;
+    }
+
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "FrameArrangementXZZones::writeZones() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool ok = query.exec("DELETE FROM structure_seagoing_ship_section0_frame_arrangement_xz_zones");
+    if (ok && !starts.isEmpty()) {
+        query.prepare("INSERT INTO structure_seagoing_ship_section0_frame_arrangement_xz_zones "
+                      "(start_frame, end_frame, frame_spacing, ml, frame_name) VALUES (?, ?, ?, ?, ?)");
+        query.addBindValue(starts);
+        query.addBindValue(ends);
+        query.addBindValue(spacings);
+        query.addBindValue(mls);
+        query.addBindValue(names);
+        ok = query.execBatch();
+    }
+
+    if (!ok || !db.commit()) {
+        m_lastError = QString("Failed to write frame zones: %1").arg(ok ? db.lastError().text() : query.lastError().text());
+        qCritical() << "FrameArrangementXZZones::writeZones() -" << m_lastError;
+        db.rollback();
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+    return true;
+}
+
+QSqlDatabase FrameArrangementXZZones::getDatabase() const
+{
+    return DatabaseShipConnection::instance().getDatabase();
+}
@@ -0,0 +1,78 @@
+#ifndef FRAMEARRANGEMENTXZZONES_H
+#define FRAMEARRANGEMENTXZZONES_H
+
+#include <QObject>
+#include <QAbstractListModel>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariantList>
+#include <QDebug>
+#include "../../core/FrameZoneTable.h"
+
+/**
+ * Zone-based XZ frame table: one database row per spacing zone (frame range, spacing, ML).
+ * The list model exposes the same roles as FrameArrangementXZ, with rows expanded lazily
+ * from the zones, and converts losslessly to and from the per-frame table. Conversions that
+ * would lose data are refused: duplicate frame numbers, and frames whose xp was entered by
+ * hand instead of following the spacing rules. Exporting replaces the per-frame rows, so
+ * their row ids change; other tables refer to frames by number, not by id.
+ */
+class FrameArrangementXZZones : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum FrameRoles {
+        IdRole = Qt::UserRole + 1,
+        FrameNameRole,
+        FrameNumberRole,
+        FrameSpacingRole,
+        MlRole,
+        XpCoorRole,
+        XlRole,
+        XllCoorRole,
+        XllLllRole
+    };
+
+    explicit FrameArrangementXZZones(QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Database operations
+    Q_INVOKABLE bool createTable();
+    Q_INVOKABLE bool loadData();
+    // zones: [{startFrame, endFrame (inclusive), spacing, ml, frameName}, ...]; replaces all zones
+    Q_INVOKABLE bool saveZones(const QVariantList &zones);
+    Q_INVOKABLE QVariantList getZones() const;
+
+    // Conversion from / to the per-frame table (structure_seagoing_ship_section0_frame_arrangement_xz)
+    Q_INVOKABLE bool importFromFrameTable();
+    Q_INVOKABLE bool exportToFrameTable(QObject *frameModel);
+
+    // Utility functions
+    Q_INVOKABLE int getZoneCount() const { return m_table.zoneCount(); }
+    Q_INVOKABLE QVariantMap getFrameAtIndex(int index) const;
+    Q_INVOKABLE int indexOfFrame(int frameNumber) const { return m_table.indexOfFrame(frameNumber); }
+    const FrameZoneTable &table() const { return m_table; }
+
+    void setShipLengths(double lpp, double upperL);
+
+signals:
+    void dataChanged();
+    void errorOccurred(const QString &error);
+
+private:
+    FrameZoneTable m_table;
+    double m_lpp;
+    double m_upperL;
+    QString m_lastError;
+
+    bool writeZones(const QVector<FrameZoneTable::Zone> &zones);
+    QSqlDatabase getDatabase() const;
+};
+
+#endif // FRAMEARRANGEMENTXZZONES_H
@@ -1,21 +1,13 @@
 #include "FrameArrangementYZ.h"
 #include "../DatabaseShipConnection.h"
+#include "../../core/YZNaming.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QDateTime>
 #include <QDebug>
 #include <algorithm>
-
-// Helper: extract leading letter prefix from a name, uppercase; fallback to "L" if none
-static QString extractLetterPrefix(const QString &name) {
-    QString prefix;
-    for (const QChar &ch : name) {
-        if (ch.isLetter()) prefix.append(ch.toUpper());
-        else break;
-    }
-    if (prefix.isEmpty()) prefix = QStringLiteral("L");
-    return prefix;
-}
+#include <climits>
 
 FrameArrangementYZ::FrameArrangementYZ(QObject *parent)
     : QAbstractListModel(parent)
@@ -25,15 +17,15 @@ FrameArrangementYZ::FrameArrangementYZ(QObject *parent)
 int FrameArrangementYZ::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
-    return m_frameYZData.size();
+    return m_visible.size();
 }
 
 QVariant FrameArrangementYZ::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() >= m_frameYZData.size())
+    if (!index.isValid() || index.row() >= m_visible.size())
         return QVariant();
 
-    const FrameYZData &frame = m_frameYZData.at(index.row());
+    const FrameYZData &frame = m_frameYZData.at(m_visible.at(index.row()));
 
     switch (role) {
     case IdRole:
@@ -60,6 +52,10 @@ QVariant FrameArrangementYZ::data(const QModelIndex &index, int role) const
         return frame.createdAt;
     case UpdatedAtRole:
         return frame.updatedAt;
+    case PrefixRole:
+        return frame.prefix;
+    case SuffixRole:
+        return frame.suffix;
     default:
         return QVariant();
     }
@@ -80,6 +76,8 @@ QHash<int, QByteArray> FrameArrangementYZ::roleNames() const
     roles[CreatedAtRole] = "createdAt";
     roles[UpdatedAtRole] = "updatedAt";
     roles[IsManualRole] = "isManual";
+    roles[PrefixRole] = "prefix";
+    roles[SuffixRole] = "suffix";
     return roles;
 }
 
@@ -106,6 +104,8 @@ bool FrameArrangementYZ::createTable()
             fa TEXT,
             sym TEXT,
             is_manual INTEGER DEFAULT 0,
+            prefix TEXT,
+            suffix INTEGER,
             created_at INTEGER DEFAULT (strftime('%s','now') * 1000),
             updated_at INTEGER DEFAULT (strftime('%s','now') * 1000)
         )
@@ -120,98 +120,179 @@ bool FrameArrangementYZ::createTable()
 
     // Try to add missing column for backward compatibility (ignore error if exists)
     query.exec("ALTER TABLE structure_seagoing_ship_section0_frame_arrangement_yz ADD COLUMN is_manual INTEGER DEFAULT 0");
+    query.exec("ALTER TABLE structure_seagoing_ship_section0_frame_arrangement_yz ADD COLUMN prefix TEXT");
+    query.exec("ALTER TABLE structure_seagoing_ship_section0_frame_arrangement_yz ADD COLUMN suffix INTEGER");
+    query.exec("CREATE INDEX IF NOT EXISTS idx_frame_arrangement_yz_prefix_suffix "
+               "ON structure_seagoing_ship_section0_frame_arrangement_yz (prefix, suffix)");
+    query.exec("CREATE INDEX IF NOT EXISTS idx_frame_arrangement_yz_frame_no "
+               "ON structure_seagoing_ship_section0_frame_arrangement_yz (frame_no)");
+
+    if (!backfillPrefixSuffix())
+        return false;
 
     qDebug() << "FrameArrangementYZ::createTable() - Table created successfully";
     return true;
 }
 
-bool FrameArrangementYZ::loadData()
+// Rows written before the prefix/suffix columns existed are parsed once and stored
+bool FrameArrangementYZ::backfillPrefixSuffix()
 {
     QSqlDatabase db = getDatabase();
-    if (!db.isValid()) {
-        m_lastError = "Ship database connection is not valid";
-        qCritical() << "FrameArrangementYZ::loadData() -" << m_lastError;
+    QSqlQuery query(db);
+    if (!query.exec("SELECT id, name FROM structure_seagoing_ship_section0_frame_arrangement_yz WHERE prefix IS NULL OR suffix IS NULL")) {
+        m_lastError = QString("Failed to read YZ names for prefix backfill: %1").arg(query.lastError().text());
+        qCritical() << "FrameArrangementYZ::backfillPrefixSuffix() -" << m_lastError;
         emit errorOccurred(m_lastError);
         return false;
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, name, no, spacing, y, z, frame_no, fa, sym, is_manual, created_at, updated_at FROM structure_seagoing_ship_section0_frame_arrangement_yz ORDER BY id");
+    QVariantList prefixes, suffixes, ids;
+    while (query.next()) {
+        QString prefix; int suffix = 0;
+        YZNaming::parsePrefixSuffix(query.value(1).toString(), prefix, suffix);
+        prefixes << prefix;
+        suffixes << suffix;
+        ids << query.value(0).toInt();
+    }
+    if (ids.isEmpty())
+        return true;
 
-    if (!query.exec()) {
-        m_lastError = QString("Failed to load frame arrangement YZ data: %1").arg(query.lastError().text());
-        qCritical() << "FrameArrangementYZ::loadData() -" << m_lastError;
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "FrameArrangementYZ::backfillPrefixSuffix() -" << m_lastError;
         emit errorOccurred(m_lastError);
         return false;
     }
 
+    QSqlQuery update(db);
+    update.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_yz SET prefix=?, suffix=? WHERE id=?");
+    update.addBindValue(prefixes);
+    update.addBindValue(suffixes);
+    update.addBindValue(ids);
+    const bool executed = update.execBatch();
+    if (!executed || !db.commit()) {
+        m_lastError = QString("Failed to backfill YZ prefix/suffix: %1").arg(executed ? db.lastError().text() : update.lastError().text());
+        qCritical() << "FrameArrangementYZ::backfillPrefixSuffix() -" << m_lastError;
+        db.rollback();
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    qDebug() << "FrameArrangementYZ::backfillPrefixSuffix() - Backfilled" << ids.size() << "rows";
+    return true;
+}
+
+bool FrameArrangementYZ::loadData()
+{
+    return reloadStore(false);
+}
+
+bool FrameArrangementYZ::reloadStore(bool keepFilter)
+{
+    QList<FrameYZData> rows;
+    if (!fetchRows(rows))
+        return false;
+
     beginResetModel();
     clearData();
+    m_frameYZData = rows;
+    m_storeLoaded = true;
+    rebuildPartitions();
+    if (!keepFilter)
+        m_filtered = false;
+    applyFilter();
+    endResetModel();
+    emit dataChanged();
 
-    while (query.next()) {
-        FrameYZData frame;
-        frame.id = query.value(0).toInt();
-        frame.name = query.value(1).toString();
-        frame.no = query.value(2).toInt();
-        frame.spacing = query.value(3).toDouble();
-        // Preserve original variant types for y/z so empty string can be shown
-        frame.y = query.value(4);
-        frame.z = query.value(5);
-        frame.frameNo = query.value(6).toInt();
-        frame.fa = query.value(7).toString();
-        frame.sym = query.value(8).toString();
-    frame.isManual = query.value(9).toInt() != 0;
-    frame.createdAt = query.value(10).toLongLong();
-    frame.updatedAt = query.value(11).toLongLong();
+    qDebug() << "FrameArrangementYZ::reloadStore() - Loaded" << m_frameYZData.size() << "frame YZ records in"
+             << m_rowsByFrame.size() << "frames";
+    return true;
+}
 
-        m_frameYZData.append(frame);
-    }
+// An edited row keeps its place in the store: stamp it, notify its view row and the listeners
+void FrameArrangementYZ::storedRowChanged(int storeIndex, const QVector<int> &roles)
+{
+    m_frameYZData[storeIndex].updatedAt = QDateTime::currentMSecsSinceEpoch();
+    const int row = m_visibleRowByIndex.value(storeIndex, -1);
+    if (row >= 0)
+        emit QAbstractItemModel::dataChanged(index(row), index(row), roles);
+    emit dataChanged();
+}
 
-    // Optional sort by prefix for display stability (keep stored names intact)
-    std::stable_sort(m_frameYZData.begin(), m_frameYZData.end(), [](const FrameYZData &a, const FrameYZData &b){
-        const QString pa = extractLetterPrefix(a.name);
-        const QString pb = extractLetterPrefix(b.name);
-        if (pa == pb) return a.id < b.id;
-        return pa < pb;
-    });
+// Deleted rows leave the store without a database round trip; the frame filter stays
+void FrameArrangementYZ::removeStoredRows(const std::function<bool(const FrameYZData &)> &removed)
+{
+    beginResetModel();
+    m_frameYZData.removeIf(removed);
+    rebuildPartitions();
+    applyFilter();
+    endResetModel();
+    emit dataChanged();
+}
+
+bool FrameArrangementYZ::loadDataByFrameNo(int frameNumber)
+{
+    // The store already holds every frame; only the first call goes to the database
+    if (!m_storeLoaded) {
+        QList<FrameYZData> rows;
+        if (!fetchRows(rows))
+            return false;
+        m_frameYZData = rows;
+        m_storeLoaded = true;
+        rebuildPartitions();
+    }
 
+    beginResetModel();
+    m_filtered = true;
+    m_filterFrameNo = frameNumber;
+    applyFilter();
     endResetModel();
     emit dataChanged();
 
-    qDebug() << "FrameArrangementYZ::loadData() - Loaded" << m_frameYZData.size() << "frame YZ records";
+    qDebug() << "FrameArrangementYZ::loadDataByFrameNo() - Showing" << m_visible.size() << "frame YZ records for frame number" << frameNumber;
     return true;
 }
 
-bool FrameArrangementYZ::loadDataByFrameNo(int frameNumber)
+void FrameArrangementYZ::showAllFrames()
+{
+    if (!m_filtered)
+        return;
+
+    beginResetModel();
+    m_filtered = false;
+    applyFilter();
+    endResetModel();
+    emit dataChanged();
+}
+
+bool FrameArrangementYZ::fetchRows(QList<FrameYZData> &rows)
 {
     QSqlDatabase db = getDatabase();
     if (!db.isValid()) {
         m_lastError = "Ship database connection is not valid";
-        qCritical() << "FrameArrangementYZ::loadDataByFrameNo() -" << m_lastError;
+        qCritical() << "FrameArrangementYZ::fetchRows() -" << m_lastError;
         emit errorOccurred(m_lastError);
         return false;
     }
 
     QSqlQuery query(db);
-    query.prepare("SELECT id, name, no, spacing, y, z, frame_no, fa, sym, is_manual, created_at, updated_at FROM structure_seagoing_ship_section0_frame_arrangement_yz WHERE frame_no = ? ORDER BY id");
-    query.addBindValue(frameNumber);
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, name, no, spacing, y, z, frame_no, fa, sym, is_manual, created_at, updated_at, prefix, suffix FROM structure_seagoing_ship_section0_frame_arrangement_yz ORDER BY prefix, id");
 
     if (!query.exec()) {
-        m_lastError = QString("Failed to load frame arrangement YZ data by frame number: %1").arg(query.lastError().text());
-        qCritical() << "FrameArrangementYZ::loadDataByFrameNo() -" << m_lastError;
+        m_lastError = QString("Failed to load frame arrangement YZ data: %1").arg(query.lastError().text());
+        qCritical() << "FrameArrangementYZ::fetchRows() -" << m_lastError;
         emit errorOccurred(m_lastError);
         return false;
     }
 
-    beginResetModel();
-    clearData();
-
     while (query.next()) {
         FrameYZData frame;
         frame.id = query.value(0).toInt();
         frame.name = query.value(1).toString();
         frame.no = query.value(2).toInt();
         frame.spacing = query.value(3).toDouble();
+        // Preserve original variant types for y/z so empty string can be shown
         frame.y = query.value(4);
         frame.z = query.value(5);
         frame.frameNo = query.value(6).toInt();
@@ -220,23 +301,55 @@ bool FrameArrangementYZ::loadDataByFrameNo(int frameNumber)
     frame.isManual = query.value(9).toInt() != 0;
     frame.createdAt = query.value(10).toLongLong();
     frame.updatedAt = query.value(11).toLongLong();
+    frame.prefix = query.value(12).toString();
+    frame.suffix = query.value(13).toInt();
 
-        m_frameYZData.append(frame);
+        rows.append(frame);
     }
+    return true;
+}
 
-    // Optional sort by prefix for display stability (keep stored names intact)
-    std::stable_sort(m_frameYZData.begin(), m_frameYZData.end(), [](const FrameYZData &a, const FrameYZData &b){
-        const QString pa = extractLetterPrefix(a.name);
-        const QString pb = extractLetterPrefix(b.name);
-        if (pa == pb) return a.id < b.id;
-        return pa < pb;
-    });
+// Rows arrive ordered by prefix (display stability) straight from the prefix column,
+// so each frame partition keeps that order too
+void FrameArrangementYZ::rebuildPartitions()
+{
+    m_rowsByFrame.clear();
+    for (int i = 0; i < m_frameYZData.size(); ++i)
+        m_rowsByFrame[m_frameYZData.at(i).frameNo].append(i);
+    rebuildSuffixIndex();
+}
 
-    endResetModel();
-    emit dataChanged();
+YZLineGeometry::Row FrameArrangementYZ::geometryRow(const FrameYZData &frame)
+{
+    auto present = [](const QVariant &v) { return v.isValid() && !v.isNull() && !v.toString().isEmpty(); };
+
+    YZLineGeometry::Row row;
+    row.prefix = frame.prefix;
+    row.suffix = frame.suffix;
+    row.count = std::max(0, frame.no);
+    row.spacing = frame.spacing;
+    row.hasY = present(frame.y);
+    row.hasZ = present(frame.z);
+    row.y = row.hasY ? frame.y.toDouble() : 0.0;
+    row.z = row.hasZ ? frame.z.toDouble() : 0.0;
+    row.sym = frame.sym;
+    row.frameNo = frame.frameNo;
+    return row;
+}
 
-    qDebug() << "FrameArrangementYZ::loadDataByFrameNo() - Loaded" << m_frameYZData.size() << "frame YZ records for frame number" << frameNumber;
-    return true;
+void FrameArrangementYZ::applyFilter()
+{
+    m_visible.clear();
+    m_visibleRowByIndex.clear();
+    if (m_filtered) {
+        m_visible = m_rowsByFrame.value(m_filterFrameNo);
+    } else {
+        m_visible.resize(m_frameYZData.size());
+        for (int i = 0; i < m_frameYZData.size(); ++i)
+            m_visible[i] = i;
+    }
+    for (int row = 0; row < m_visible.size(); ++row)
+        m_visibleRowByIndex.insert(m_visible.at(row), row);
 }
 
 int FrameArrangementYZ::insertFrame(const QString &name, int no, double spacing,
@@ -252,9 +365,11 @@ int FrameArrangementYZ::insertFrame(const QString &name, int no, double spacing,
 
     QSqlQuery query(db);
     query.prepare("INSERT INTO structure_seagoing_ship_section0_frame_arrangement_yz "
-                  "(name, no, spacing, y, z, frame_no, fa, sym, is_manual) "
-                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+                  "(name, no, spacing, y, z, frame_no, fa, sym, is_manual, prefix, suffix) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
     
+    QString prefix; int suffix = 0;
+    YZNaming::parsePrefixSuffix(name, prefix, suffix);
     query.addBindValue(name);
     query.addBindValue(no);
     query.addBindValue(spacing);
@@ -268,6 +383,8 @@ int FrameArrangementYZ::insertFrame(const QString &name, int no, double spacing,
     bool manual = false;
     for (const QChar &ch : name) { if (ch.isDigit()) { manual = true; break; } }
     query.addBindValue(manual ? 1 : 0);
+    query.addBindValue(prefix);
+    query.addBindValue(suffix);
 
     if (!query.exec()) {
         m_lastError = QString("Failed to insert frame YZ: %1").arg(query.lastError().text());
@@ -278,7 +395,8 @@ int FrameArrangementYZ::insertFrame(const QString &name, int no, double spacing,
 
     int insertedId = query.lastInsertId().toInt();
     qDebug() << "FrameArrangementYZ::insertFrame() - Frame YZ inserted successfully with ID:" << insertedId;
-    loadData(); // Reload data to update the model
+    // The new row takes its place in the prefix order; keep the frame filter the user picked
+    reloadStore(true);
     return insertedId;
 }
 
@@ -295,9 +413,11 @@ bool FrameArrangementYZ::updateFrame(int id, const QString &name, int no, double
 
     QSqlQuery query(db);
     query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_yz "
-                  "SET name=?, no=?, spacing=?, y=?, z=?, frame_no=?, fa=?, sym=?, updated_at=(strftime('%s','now')*1000) "
+                  "SET name=?, no=?, spacing=?, y=?, z=?, frame_no=?, fa=?, sym=?, prefix=?, suffix=?, updated_at=(strftime('%s','now')*1000) "
                   "WHERE id=?");
     
+    QString prefix; int suffix = 0;
+    YZNaming::parsePrefixSuffix(name, prefix, suffix);
     query.addBindValue(name);
     query.addBindValue(no);
     query.addBindValue(spacing);
@@ -306,6 +426,8 @@ bool FrameArrangementYZ::updateFrame(int id, const QString &name, int no, double
     query.addBindValue(frameNo);
     query.addBindValue(fa);
     query.addBindValue(sym);
+    query.addBindValue(prefix);
+    query.addBindValue(suffix);
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -316,7 +438,24 @@ bool FrameArrangementYZ::updateFrame(int id, const QString &name, int no, double
     }
 
     qDebug() << "FrameArrangementYZ::updateFrame() - Frame YZ updated successfully";
-    loadData(); // Reload data to update the model
+    // A new prefix or frame number moves the row in the order or between partitions
+    const int storeIndex = m_indexById.value(id, -1);
+    if (storeIndex < 0 || m_frameYZData.at(storeIndex).prefix != prefix
+        || m_frameYZData.at(storeIndex).frameNo != frameNo) {
+        reloadStore(true);
+        return true;
+    }
+    FrameYZData &frame = m_frameYZData[storeIndex];
+    frame.name = name;
+    frame.no = no;
+    frame.spacing = spacing;
+    frame.y = y;
+    frame.z = z;
+    frame.fa = fa;
+    frame.sym = sym;
+    frame.suffix = suffix;
+    indexRow(frame);
+    storedRowChanged(storeIndex, { NameRole, NoRole, SpacingRole, YRole, ZRole, FaRole, SymRole, SuffixRole, UpdatedAtRole });
     return true;
 }
 
@@ -331,8 +470,12 @@ bool FrameArrangementYZ::updateFrameName(int id, const QString &name, bool reloa
     }
 
     QSqlQuery query(db);
-    query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_yz SET name=?, updated_at=(strftime('%s','now')*1000) WHERE id=?");
+    QString prefix; int suffix = 0;
+    YZNaming::parsePrefixSuffix(name, prefix, suffix);
+    query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_yz SET name=?, prefix=?, suffix=?, updated_at=(strftime('%s','now')*1000) WHERE id=?");
     query.addBindValue(name);
+    query.addBindValue(prefix);
+    query.addBindValue(suffix);
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -343,7 +486,122 @@ bool FrameArrangementYZ::updateFrameName(int id, const QString &name, bool reloa
     }
 
     qDebug() << "FrameArrangementYZ::updateFrameName() - Name updated for id" << id << "=>" << name;
-    if (reloadModel) loadData();
+    const int storeIndex = m_indexById.value(id, -1);
+    if (storeIndex < 0) {
+        if (reloadModel)
+            reloadStore(true);
+        return true;
+    }
+
+    // A prefix change moves the row in the prefix order and between the frame partitions;
+    // reload even when no reload was asked for, like updateFrameNamesBatch()
+    if (m_frameYZData.at(storeIndex).prefix != prefix) {
+        reloadStore(true);
+        return true;
+    }
+
+    FrameYZData &frame = m_frameYZData[storeIndex];
+    frame.name = name;
+    frame.suffix = suffix;
+    indexRow(frame);
+    if (reloadModel) {
+        storedRowChanged(storeIndex, { NameRole, SuffixRole, UpdatedAtRole });
+        return true;
+    }
+
+    // Without a reload keep the loaded row in step with the database, without dataChanged()
+    const int row = m_visibleRowByIndex.value(storeIndex, -1);
+    if (row >= 0)
+        emit QAbstractItemModel::dataChanged(index(row), index(row), { NameRole, SuffixRole });
+    return true;
+}
+
+bool FrameArrangementYZ::updateFrameNamesBatch(const QList<NameUpdate> &updates)
+{
+    if (updates.isEmpty())
+        return true;
+
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "FrameArrangementYZ::updateFrameNamesBatch() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QList<QString> prefixList;
+    QList<int> suffixList;
+    QVariantList names, prefixes, suffixes, manuals, ids;
+    for (const NameUpdate &update : updates) {
+        QString prefix; int suffix = 0;
+        YZNaming::parsePrefixSuffix(update.name, prefix, suffix);
+        prefixList.append(prefix);
+        suffixList.append(suffix);
+        names << update.name;
+        prefixes << prefix;
+        suffixes << suffix;
+        // NULL keeps the stored flag through COALESCE
+        manuals << (update.isManual < 0 ? QVariant(QMetaType(QMetaType::Int)) : QVariant(update.isManual));
+        ids << update.id;
+    }
+
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "FrameArrangementYZ::updateFrameNamesBatch() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("UPDATE structure_seagoing_ship_section0_frame_arrangement_yz "
+                  "SET name=?, prefix=?, suffix=?, is_manual=COALESCE(?, is_manual), updated_at=(strftime('%s','now')*1000) "
+                  "WHERE id=?");
+    query.addBindValue(names);
+    query.addBindValue(prefixes);
+    query.addBindValue(suffixes);
+    query.addBindValue(manuals);
+    query.addBindValue(ids);
+
+    const bool executed = query.execBatch();
+    if (!executed || !db.commit()) {
+        m_lastError = QString("Failed to rename frames YZ: %1").arg(executed ? db.lastError().text() : query.lastError().text());
+        qCritical() << "FrameArrangementYZ::updateFrameNamesBatch() -" << m_lastError;
+        db.rollback();
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    // Apply to the loaded rows; a prefix change affects the ORDER BY prefix order, so reload once instead
+    bool prefixChanged = false;
+    int firstRow = INT_MAX;
+    int lastRow = -1;
+    for (int i = 0; i < updates.size(); ++i) {
+        const int storeIndex = m_indexById.value(updates.at(i).id, -1);
+        if (storeIndex < 0)
+            continue;
+        FrameYZData &frame = m_frameYZData[storeIndex];
+        if (frame.prefix != prefixList.at(i))
+            prefixChanged = true;
+        frame.name = updates.at(i).name;
+        frame.prefix = prefixList.at(i);
+        frame.suffix = suffixList.at(i);
+        if (updates.at(i).isManual >= 0)
+            frame.isManual = updates.at(i).isManual != 0;
+        indexRow(frame);
+        const int row = m_visibleRowByIndex.value(storeIndex, -1);
+        if (row < 0)
+            continue;
+        firstRow = std::min(firstRow, row);
+        lastRow = std::max(lastRow, row);
+    }
+
+    qDebug() << "FrameArrangementYZ::updateFrameNamesBatch() - Renamed" << updates.size() << "frames YZ";
+    if (prefixChanged) {
+        reloadStore(true);
+    } else if (lastRow >= 0) {
+        emit QAbstractItemModel::dataChanged(index(firstRow), index(lastRow), { NameRole, PrefixRole, SuffixRole, IsManualRole });
+        emit dataChanged();
+    }
     return true;
 }
 
@@ -370,7 +628,13 @@ bool FrameArrangementYZ::updateFrameFa(int id, const QString &fa)
     }
 
     qDebug() << "FrameArrangementYZ::updateFrameFa() - Frame YZ FA updated successfully";
-    loadData(); // Reload data to update the model
+    const int storeIndex = m_indexById.value(id, -1);
+    if (storeIndex < 0) {
+        reloadStore(true);
+        return true;
+    }
+    m_frameYZData[storeIndex].fa = fa;
+    storedRowChanged(storeIndex, { FaRole, UpdatedAtRole });
     return true;
 }
 
@@ -397,7 +661,13 @@ bool FrameArrangementYZ::updateFrameSym(int id, const QString &sym)
     }
 
     qDebug() << "FrameArrangementYZ::updateFrameSym() - Frame YZ Sym updated successfully";
-    loadData(); // Reload data to update the model
+    const int storeIndex = m_indexById.value(id, -1);
+    if (storeIndex < 0) {
+        reloadStore(true);
+        return true;
+    }
+    m_frameYZData[storeIndex].sym = sym;
+    storedRowChanged(storeIndex, { SymRole, UpdatedAtRole });
     return true;
 }
 
@@ -423,7 +693,7 @@ bool FrameArrangementYZ::deleteFrame(int id)
     }
 
     qDebug() << "FrameArrangementYZ::deleteFrame() - Frame YZ deleted successfully";
-    loadData(); // Reload data to update the model
+    removeStoredRows([id](const FrameYZData &frame) { return frame.id == id; });
     return true;
 }
 
@@ -449,7 +719,7 @@ bool FrameArrangementYZ::deleteFramesByFrameNumber(int frameNumber)
     }
 
     qDebug() << "FrameArrangementYZ::deleteFramesByFrameNumber() - Frames YZ deleted successfully for frame number" << frameNumber;
-    loadData(); // Reload data to update the model
+    removeStoredRows([frameNumber](const FrameYZData &frame) { return frame.frameNo == frameNumber; });
     return true;
 }
 
@@ -540,9 +810,30 @@ QVariantList FrameArrangementYZ::getFramesByName(const QString &name)
 
 QVariantList FrameArrangementYZ::getFramesByFrameNo(int frameNumber)
 {
-    QSqlDatabase db = getDatabase();
     QVariantList result;
-    
+
+    // Served from the frame partition once the store is loaded
+    if (m_storeLoaded) {
+        for (int storeIndex : m_rowsByFrame.value(frameNumber)) {
+            const FrameYZData &row = m_frameYZData.at(storeIndex);
+            QVariantMap frame;
+            frame["id"] = row.id;
+            frame["name"] = row.name;
+            frame["no"] = row.no;
+            frame["spacing"] = row.spacing;
+            frame["y"] = row.y;
+            frame["z"] = row.z;
+            frame["frameNo"] = row.frameNo;
+            frame["fa"] = row.fa;
+            frame["sym"] = row.sym;
+            frame["createdAt"] = row.createdAt;
+            frame["updatedAt"] = row.updatedAt;
+            result.append(frame);
+        }
+        return result;
+    }
+
+    QSqlDatabase db = getDatabase();
     if (!db.isValid()) {
         m_lastError = "Ship database connection is not valid";
         qCritical() << "FrameArrangementYZ::getFramesByFrameNo() -" << m_lastError;
@@ -583,32 +874,57 @@ QVariantList FrameArrangementYZ::getFramesByFrameNo(int frameNumber)
 
 int FrameArrangementYZ::getRowCount() const
 {
-    return m_frameYZData.size();
+    return m_visible.size();
 }
 
 QVariantMap FrameArrangementYZ::getFrameAtIndex(int index) const
+{
+    if (index >= 0 && index < m_visible.size())
+        return frameToMap(m_frameYZData.at(m_visible.at(index)));
+    return QVariantMap();
+}
+
+QVariantMap FrameArrangementYZ::frameToMap(const FrameYZData &frame)
 {
     QVariantMap result;
-    
-    if (index >= 0 && index < m_frameYZData.size()) {
-        const FrameYZData &frame = m_frameYZData.at(index);
-        result["id"] = frame.id;
-        result["name"] = frame.name;
-        result["no"] = frame.no;
-        result["spacing"] = frame.spacing;
-        result["y"] = frame.y;
-        result["z"] = frame.z;
-        result["frameNo"] = frame.frameNo;
-        result["fa"] = frame.fa;
-        result["sym"] = frame.sym;
-    }
-    
+    result["id"] = frame.id;
+    result["name"] = frame.name;
+    result["no"] = frame.no;
+    result["spacing"] = frame.spacing;
+    result["y"] = frame.y;
+    result["z"] = frame.z;
+    result["frameNo"] = frame.frameNo;
+    result["fa"] = frame.fa;
+    result["sym"] = frame.sym;
+    result["prefix"] = frame.prefix;
+    result["suffix"] = frame.suffix;
     return result;
 }
 
 void FrameArrangementYZ::clearData()
 {
     m_frameYZData.clear();
+    m_rowsByFrame.clear();
+    m_visible.clear();
+    m_visibleRowByIndex.clear();
+    m_storeLoaded = false;
+    m_suffixIndex.clear();
+    m_indexById.clear();
+}
+
+void FrameArrangementYZ::rebuildSuffixIndex()
+{
+    m_suffixIndex.clear();
+    m_indexById.clear();
+    for (int i = 0; i < m_frameYZData.size(); ++i) {
+        m_indexById.insert(m_frameYZData.at(i).id, i);
+        indexRow(m_frameYZData.at(i));
+    }
+}
+
+void FrameArrangementYZ::indexRow(const FrameYZData &frame)
+{
+    m_suffixIndex.insert(frame.id, frame.prefix, frame.suffix, frame.no, frame.isManual);
 }
 
 QSqlDatabase FrameArrangementYZ::getDatabase() const
@@ -617,48 +933,29 @@ QSqlDatabase FrameArrangementYZ::getDatabase() const
 }
 
 // ---- New helpers for manual/auto name handling ----
-static void parsePrefixSuffix(const QString &name, QString &prefix, int &suffix) {
-    prefix.clear(); suffix = 0;
-    int i = 0;
-    while (i < name.size() && name.at(i).isLetter()) { prefix.append(name.at(i).toUpper()); ++i; }
-    QString digits;
-    while (i < name.size() && name.at(i).isDigit()) { digits.append(name.at(i)); ++i; }
-    suffix = digits.isEmpty() ? 0 : digits.toInt();
-    if (prefix.isEmpty()) prefix = QStringLiteral("L");
-}
-
 QVariantList FrameArrangementYZ::checkSuffixConflict(const QString &prefixIn, int startSuffix, int count) const {
     QString prefix = prefixIn.isEmpty() ? QStringLiteral("L") : prefixIn.toUpper();
     QVariantList conflicts;
-    const int len = std::max(0, count);
-    const int endSuffix = startSuffix + (len > 0 ? (len - 1) : -1);
-    for (const auto &d : m_frameYZData) {
-        QString p; int s=0; parsePrefixSuffix(d.name, p, s);
-        if (p != prefix) continue;
-        const int cnt = std::max(0, d.no);
-        const int e = s + (cnt > 0 ? (cnt - 1) : -1);
-        if (std::max(startSuffix, s) <= std::min(endSuffix, e)) {
-            QVariantMap m;
-            m["startSuffix"] = s;
-            m["endSuffix"] = e;
-            m["reason"] = d.isManual ? "manual" : "auto";
-            conflicts.push_back(m);
-        }
+    // O(log n + k) over the prefix's ranges instead of re-parsing every row
+    const QVector<YZSuffixIndex::Range> ranges = m_suffixIndex.overlapping(prefix, startSuffix, std::max(0, count));
+    for (const YZSuffixIndex::Range &range : ranges) {
+        QVariantMap m;
+        m["startSuffix"] = range.start;
+        m["endSuffix"] = range.end;
+        m["reason"] = range.manual ? "manual" : "auto";
+        conflicts.push_back(m);
     }
     return conflicts;
 }
 
 int FrameArrangementYZ::getLastSuffixForPrefix(const QString &prefixIn) const {
     QString prefix = prefixIn.isEmpty() ? QStringLiteral("L") : prefixIn.toUpper();
-    int last = -1;
-    for (const auto &d : m_frameYZData) {
-        QString p; int s=0; parsePrefixSuffix(d.name, p, s);
-        if (p != prefix) continue;
-        const int cnt = std::max(0, d.no);
-        const int e = s + (cnt > 0 ? (cnt - 1) : -1);
-        last = std::max(last, e);
-    }
-    return last;
+    return m_suffixIndex.lastSuffix(prefix);
+}
+
+int FrameArrangementYZ::getNextFreeSuffix(const QString &prefixIn, int fromSuffix, int count) const {
+    QString prefix = prefixIn.isEmpty() ? QStringLiteral("L") : prefixIn.toUpper();
+    return m_suffixIndex.nextFreeSuffix(prefix, fromSuffix, count);
 }
 
 bool FrameArrangementYZ::updateFrameIsManual(int id, bool isManual)
@@ -670,7 +967,14 @@ bool FrameArrangementYZ::updateFrameIsManual(int id, bool isManual)
     query.addBindValue(isManual ? 1 : 0);
     query.addBindValue(id);
     if (!query.exec()) { m_lastError = query.lastError().text(); emit errorOccurred(m_lastError); return false; }
-    loadData();
+    const int storeIndex = m_indexById.value(id, -1);
+    if (storeIndex < 0) {
+        reloadStore(true);
+        return true;
+    }
+    m_frameYZData[storeIndex].isManual = isManual;
+    indexRow(m_frameYZData.at(storeIndex));
+    storedRowChanged(storeIndex, { IsManualRole, UpdatedAtRole });
     return true;
 }
 
@@ -678,18 +982,15 @@ bool FrameArrangementYZ::assignManualNames(int id, const QString &prefixIn, int
 {
     Q_UNUSED(count)
     QString prefix = prefixIn.isEmpty() ? QStringLiteral("L") : prefixIn.toUpper();
-    const QString name = prefix + QString::number(startSuffix);
-    if (!updateFrameName(id, name, false)) return false;
-    return updateFrameIsManual(id, true);
+    // Name and manual flag in one statement
+    return updateFrameNamesBatch({ NameUpdate{ id, prefix + QString::number(startSuffix), 1 } });
 }
 
 bool FrameArrangementYZ::assignAutoNamesFrom(int id, const QString &prefixIn, int continueFromSuffix, int count)
 {
     Q_UNUSED(count)
     QString prefix = prefixIn.isEmpty() ? QStringLiteral("L") : prefixIn.toUpper();
-    const QString name = prefix + QString::number(continueFromSuffix);
-    if (!updateFrameName(id, name, false)) return false;
-    return updateFrameIsManual(id, false);
+    return updateFrameNamesBatch({ NameUpdate{ id, prefix + QString::number(continueFromSuffix), 0 } });
 }
 
 // ---------------- YZ Drawing Table Operations ----------------
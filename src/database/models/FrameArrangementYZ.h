@@ -8,7 +8,10 @@
 #include <QSqlError>
 #include <QDebug>
 #include <QVariant>
+#include <functional>
 #include <string>
+#include "../../core/YZSuffixIndex.h"
+#include "../../core/YZLineGeometry.h"
 
 class FrameArrangementYZ : public QAbstractListModel
 {
@@ -27,7 +30,9 @@ public:
     SymRole,
     IsManualRole,
     CreatedAtRole,
-    UpdatedAtRole
+    UpdatedAtRole,
+    PrefixRole,
+    SuffixRole
     };
 
     struct FrameYZData {
@@ -43,6 +48,14 @@ public:
     bool isManual{false};
     qint64 createdAt{0};
     qint64 updatedAt{0};
+    QString prefix;   // parsed from name on write, stored in the prefix column
+    int suffix{0};    // parsed from name on write, stored in the suffix column
+    };
+
+    struct NameUpdate {
+        int id;
+        QString name;
+        int isManual{-1};   // 0/1 sets the flag, -1 keeps it
     };
 
     explicit FrameArrangementYZ(QObject *parent = nullptr);
@@ -60,8 +73,11 @@ public:
                                const QVariant &y, const QVariant &z, int frameNo, const QString &fa, const QString &sym);
     Q_INVOKABLE bool updateFrame(int id, const QString &name, int no, double spacing,
                                 const QVariant &y, const QVariant &z, int frameNo, const QString &fa, const QString &sym);
-    // Update only the name column; when reloadModel is false, does not call loadData()
+    // Update only the name column; when reloadModel is false, dataChanged() is not emitted
+    // unless the prefix changes, which always reloads to keep the prefix order
     Q_INVOKABLE bool updateFrameName(int id, const QString &name, bool reloadModel = true);
+    // Renames many rows with one prepared statement in one transaction and a single model update
+    bool updateFrameNamesBatch(const QList<NameUpdate> &updates);
     Q_INVOKABLE bool updateFrameFa(int id, const QString &fa);
     Q_INVOKABLE bool updateFrameSym(int id, const QString &sym);
     Q_INVOKABLE bool updateFrameIsManual(int id, bool isManual);
@@ -81,6 +97,8 @@ public:
     // Conflict and assignment APIs
     Q_INVOKABLE QVariantList checkSuffixConflict(const QString &prefix, int startSuffix, int count) const;
     Q_INVOKABLE int getLastSuffixForPrefix(const QString &prefix) const;
+    // Smallest suffix >= fromSuffix whose range of count suffixes is unused for prefix
+    Q_INVOKABLE int getNextFreeSuffix(const QString &prefix, int fromSuffix, int count) const;
     Q_INVOKABLE bool assignManualNames(int id, const QString &prefix, int startSuffix, int count);
     Q_INVOKABLE bool assignAutoNamesFrom(int id, const QString &prefix, int continueFromSuffix, int count);
 
@@ -104,16 +122,47 @@ public:
     Q_INVOKABLE int getRowCount() const;
     Q_INVOKABLE QVariantMap getFrameAtIndex(int index) const;
 
+    // The list model is a view over the whole YZ store: every frame (loadData / showAllFrames)
+    // or a single frame number (loadDataByFrameNo), switched without touching the database
+    Q_INVOKABLE void showAllFrames();
+    Q_INVOKABLE bool isFrameFiltered() const { return m_filtered; }
+    Q_INVOKABLE int filterFrameNo() const { return m_filterFrameNo; }
+    const QList<FrameYZData> &allFrames() const { return m_frameYZData; }
+    // Indices into allFrames() of one frame number's rows (prefix, id order), O(1)
+    QVector<int> rowsOfFrame(int frameNumber) const { return m_rowsByFrame.value(frameNumber); }
+    // Row as the QVariantMap getFrameAtIndex() hands out
+    static QVariantMap frameToMap(const FrameYZData &frame);
+    // Geometry input of a stored row; empty Y/Z (null or "") are left unset
+    static YZLineGeometry::Row geometryRow(const FrameYZData &frame);
+
 signals:
     void dataChanged();
     void errorOccurred(const QString &error);
 
 private:
-    QList<FrameYZData> m_frameYZData;
+    QList<FrameYZData> m_frameYZData;      // every YZ row, ordered by prefix, id
+    QHash<int, QVector<int>> m_rowsByFrame; // frame_no -> indices into m_frameYZData
+    QVector<int> m_visible;                 // model row -> index into m_frameYZData
+    QHash<int, int> m_visibleRowByIndex;    // index into m_frameYZData -> model row
+    bool m_storeLoaded{false};
+    bool m_filtered{false};
+    int m_filterFrameNo{-1};
     QList<FrameYZDrawingData> m_frameYZDrawingData; // mirrors drawing table
     QString m_lastError;
+    // Suffix ranges of all rows by prefix, and store index by id
+    YZSuffixIndex m_suffixIndex;
+    QHash<int, int> m_indexById;
     
     void clearData();
+    bool fetchRows(QList<FrameYZData> &rows);
+    bool reloadStore(bool keepFilter);
+    void storedRowChanged(int storeIndex, const QVector<int> &roles);
+    void removeStoredRows(const std::function<bool(const FrameYZData &)> &removed);
+    void rebuildPartitions();
+    void applyFilter();
+    bool backfillPrefixSuffix();
+    void rebuildSuffixIndex();
+    void indexRow(const FrameYZData &frame);
     QSqlDatabase getDatabase() const;
 };
 
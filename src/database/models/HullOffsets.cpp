@@ -0,0 +1,207 @@
+#include "HullOffsets.h"
+#include "../DatabaseShipConnection.h"
+#include <QFile>
+#include <QTextStream>
+#include <QUrl>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+HullOffsets::HullOffsets(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool HullOffsets::createTable()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "HullOffsets::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    QString createTableSQL = R"(
+        CREATE TABLE IF NOT EXISTS structure_seagoing_ship_section0_hull_offsets (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            station_x REAL,
+            z REAL,
+            half_breadth REAL,
+            created_at INTEGER DEFAULT (strftime('%s','now') * 1000),
+            updated_at INTEGER DEFAULT (strftime('%s','now') * 1000)
+        )
+    )";
+
+    if (!query.exec(createTableSQL)) {
+        m_lastError = QString("Failed to create hull offsets table: %1").arg(query.lastError().text());
+        qCritical() << "HullOffsets::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    qDebug() << "HullOffsets::createTable() - Table created successfully";
+    return true;
+}
+
+bool HullOffsets::loadData()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "HullOffsets::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT station_x, z, half_breadth FROM structure_seagoing_ship_section0_hull_offsets")) {
+        m_lastError = QString("Failed to load hull offsets: %1").arg(query.lastError().text());
+        qCritical() << "HullOffsets::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVector<HullSection::Offset> offsets;
+    while (query.next())
+        offsets.append({ query.value(0).toDouble(), query.value(1).toDouble(), query.value(2).toDouble() });
+
+    HullSection section;
+    section.setOffsets(offsets);
+    m_cache.setSection(section);
+
+    qDebug() << "HullOffsets::loadData() -" << offsets.size() << "offsets," << section.stationCount() << "stations";
+    emit sectionsChanged();
+    return true;
+}
+
+bool HullOffsets::importCsv(const QString &fileName)
+{
+    const QUrl url(fileName);
+    QFile file(url.isLocalFile() ? url.toLocalFile() : fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        m_lastError = QString("Cannot read %1: %2").arg(fileName, file.errorString());
+        qCritical() << "HullOffsets::importCsv() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QTextStream in(&file);
+    QHash<QString, int> columns;
+    const QStringList header = in.readLine().split(QLatin1Char(','));
+    for (int i = 0; i < header.size(); ++i)
+        columns.insert(header.at(i).trimmed().toLower(), i);
+    const int xColumn = columns.value("station_x", columns.value("x", -1));
+    const int zColumn = columns.value("z", -1);
+    const int yColumn = columns.value("half_breadth", columns.value("y", -1));
+    if (xColumn < 0 || zColumn < 0 || yColumn < 0) {
+        m_lastError = "Offset CSV needs station_x, z and half_breadth columns";
+        qWarning() << "HullOffsets::importCsv() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVector<HullSection::Offset> offsets;
+    int lineNo = 1;
+    while (!in.atEnd()) {
+        const QString line = in.readLine();
+        ++lineNo;
+        if (line.trimmed().isEmpty()) continue;
+        const QStringList fields = line.split(QLatin1Char(','));
+        bool okX = false, okZ = false, okY = false;
+        HullSection::Offset offset;
+        offset.x = fields.value(xColumn).trimmed().toDouble(&okX);
+        offset.z = fields.value(zColumn).trimmed().toDouble(&okZ);
+        offset.halfBreadth = fields.value(yColumn).trimmed().toDouble(&okY);
+        if (!okX || !okZ || !okY) {
+            m_lastError = QString("Invalid offset on line %1 of %2").arg(lineNo).arg(fileName);
+            qWarning() << "HullOffsets::importCsv() -" << m_lastError;
+            emit errorOccurred(m_lastError);
+            return false;
+        }
+        offsets.append(offset);
+    }
+
+    if (!writeOffsets(offsets))
+        return false;
+    qDebug() << "HullOffsets::importCsv() - Imported" << offsets.size() << "offsets from" << fileName;
+    return loadData();
+}
+
+bool HullOffsets::clearOffsets()
+{
+    if (!writeOffsets(QVector<HullSection::Offset>()))
+        return false;
+    return loadData();
+}
+
+// Replaces the whole table in one transaction
+bool HullOffsets::writeOffsets(const QVector<HullSection::Offset> &offsets)
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "HullOffsets::writeOffsets() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QVariantList xs, zs, halfBreadths;
+    for (const HullSection::Offset &offset : offsets) {
+        xs << offset.x;
+        zs << offset.z;
+        halfBreadths << offset.halfBreadth;
+    }
+
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "HullOffsets::writeOffsets() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool ok = query.exec("DELETE FROM structure_seagoing_ship_section0_hull_offsets");
+    if (ok && !offsets.isEmpty()) {
+        query.prepare("INSERT INTO structure_seagoing_ship_section0_hull_offsets (station_x, z, half_breadth) "
+                      "VALUES (?, ?, ?)");
+        query.addBindValue(xs);
+        query.addBindValue(zs);
+        query.addBindValue(halfBreadths);
+        ok = query.execBatch();
+    }
+
+    if (!ok || !db.commit()) {
+        m_lastError = QString("Failed to write hull offsets: %1").arg(ok ? db.lastError().text() : query.lastError().text());
+        qCritical() << "HullOffsets::writeOffsets() -" << m_lastError;
+        db.rollback();
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+    return true;
+}
+
+void HullOffsets::setFramePositions(const QHash<int, double> &xpByFrame)
+{
+    m_cache.setFramePositions(xpByFrame);
+    emit sectionsChanged();
+}
+
+QVariantList HullOffsets::sectionPolygon(int frameNo)
+{
+    QVariantList result;
+    for (const QPointF &point : m_cache.polygon(frameNo)) {
+        QVariantMap map;
+        map["y"] = point.x();
+        map["z"] = point.y();
+        result.append(map);
+    }
+    return result;
+}
+
+QSqlDatabase HullOffsets::getDatabase() const
+{
+    return DatabaseShipConnection::instance().getDatabase();
+}
@@ -0,0 +1,55 @@
+#ifndef HULLOFFSETS_H
+#define HULLOFFSETS_H
+
+#include <QObject>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariantList>
+#include <QDebug>
+#include "../../core/HullSection.h"
+
+/**
+ * Hull offset table of the ship (station x in m on the xpCoor datum, height z and half
+ * breadth in mm) and the per-frame section cache built from it. sectionsChanged() is
+ * emitted when the offsets or the frame positions change and drives the YZ hull clipping.
+ */
+class HullOffsets : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int stationCount READ stationCount NOTIFY sectionsChanged)
+
+public:
+    explicit HullOffsets(QObject *parent = nullptr);
+
+    int stationCount() const { return m_cache.section().stationCount(); }
+    HullSectionCache &sections() { return m_cache; }
+
+    // Database operations
+    Q_INVOKABLE bool createTable();
+    Q_INVOKABLE bool loadData();
+    // CSV with a header line: station_x (or x), z, half_breadth (or y); replaces the table.
+    // Takes a path or a file:// URL as handed out by a QML FileDialog
+    Q_INVOKABLE bool importCsv(const QString &fileName);
+    Q_INVOKABLE bool clearOffsets();
+
+    // xpCoor (m) per frame number, from the XZ frame arrangement
+    void setFramePositions(const QHash<int, double> &xpByFrame);
+
+    // Section polygon of a frame as a list of {y, z} maps in mm, empty without offsets
+    Q_INVOKABLE QVariantList sectionPolygon(int frameNo);
+
+signals:
+    void sectionsChanged();
+    void errorOccurred(const QString &error);
+
+private:
+    HullSectionCache m_cache;
+    QString m_lastError;
+
+    bool writeOffsets(const QVector<HullSection::Offset> &offsets);
+    QSqlDatabase getDatabase() const;
+};
+
+#endif // HULLOFFSETS_H
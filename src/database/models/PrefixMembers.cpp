@@ -0,0 +1,196 @@
+#include "PrefixMembers.h"
+#include "../DatabaseShipConnection.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+
+PrefixMembers::PrefixMembers(QObject *parent)
+    : QObject(parent)
+{
+}
+
+PrefixMembers::Member PrefixMembers::member(const QString &prefix) const
+{
+    Member fallback;
+    fallback.prefix = prefix.toUpper();
+    return m_members.value(prefix.toUpper(), fallback);
+}
+
+bool PrefixMembers::createTable()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrefixMembers::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    QString createTableSQL = R"(
+        CREATE TABLE IF NOT EXISTS structure_seagoing_ship_section0_prefix_members (
+            prefix TEXT PRIMARY KEY,
+            profile_name TEXT,
+            plate_thickness REAL,
+            mat_no INTEGER DEFAULT 0,
+            placement TEXT DEFAULT 'bottom',
+            created_at INTEGER DEFAULT (strftime('%s','now') * 1000),
+            updated_at INTEGER DEFAULT (strftime('%s','now') * 1000)
+        )
+    )";
+
+    if (!query.exec(createTableSQL)) {
+        m_lastError = QString("Failed to create prefix members table: %1").arg(query.lastError().text());
+        qCritical() << "PrefixMembers::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    // Tables created before the weight used them have no material column
+    query.exec("ALTER TABLE structure_seagoing_ship_section0_prefix_members ADD COLUMN mat_no INTEGER DEFAULT 0");
+
+    qDebug() << "PrefixMembers::createTable() - Table created successfully";
+    return true;
+}
+
+bool PrefixMembers::loadData()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrefixMembers::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (!query.exec("SELECT prefix, profile_name, plate_thickness, mat_no, placement FROM structure_seagoing_ship_section0_prefix_members")) {
+        m_lastError = QString("Failed to load prefix members: %1").arg(query.lastError().text());
+        qCritical() << "PrefixMembers::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    m_members.clear();
+    while (query.next()) {
+        Member member;
+        member.prefix = query.value(0).toString().toUpper();
+        member.profileName = query.value(1).toString();
+        member.plateThickness = query.value(2).toDouble();
+        member.matNo = query.value(3).toInt();
+        member.placement = placementFromString(query.value(4).toString());
+        m_members.insert(member.prefix, member);
+    }
+
+    emit membersChanged();
+    qDebug() << "PrefixMembers::loadData() - Loaded" << m_members.size() << "prefix members";
+    return true;
+}
+
+bool PrefixMembers::setMember(const Member &member)
+{
+    const QString prefix = member.prefix.trimmed().toUpper();
+    if (prefix.isEmpty() || member.plateThickness < 0.0) {
+        m_lastError = "A prefix and a non-negative plate thickness are required";
+        qWarning() << "PrefixMembers::setMember() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrefixMembers::setMember() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO structure_seagoing_ship_section0_prefix_members (prefix, profile_name, plate_thickness, mat_no, placement) "
+                  "VALUES (?, ?, ?, ?, ?) "
+                  "ON CONFLICT(prefix) DO UPDATE SET profile_name=excluded.profile_name, "
+                  "plate_thickness=excluded.plate_thickness, mat_no=excluded.mat_no, placement=excluded.placement, "
+                  "updated_at=strftime('%s','now') * 1000");
+    query.addBindValue(prefix);
+    query.addBindValue(member.profileName);
+    query.addBindValue(member.plateThickness);
+    query.addBindValue(member.matNo);
+    query.addBindValue(placementToString(member.placement));
+
+    if (!query.exec()) {
+        m_lastError = QString("Failed to save member of prefix %1: %2").arg(prefix, query.lastError().text());
+        qCritical() << "PrefixMembers::setMember() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    Member stored = member;
+    stored.prefix = prefix;
+    m_members.insert(prefix, stored);
+    emit membersChanged();
+    return true;
+}
+
+bool PrefixMembers::removeMember(const QString &prefix)
+{
+    const QString key = prefix.trimmed().toUpper();
+    if (!m_members.contains(key))
+        return true;
+
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrefixMembers::removeMember() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("DELETE FROM structure_seagoing_ship_section0_prefix_members WHERE prefix = ?");
+    query.addBindValue(key);
+    if (!query.exec()) {
+        m_lastError = QString("Failed to remove member of prefix %1: %2").arg(key, query.lastError().text());
+        qCritical() << "PrefixMembers::removeMember() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    m_members.remove(key);
+    emit membersChanged();
+    return true;
+}
+
+QVariantList PrefixMembers::memberList() const
+{
+    QStringList prefixes = m_members.keys();
+    std::sort(prefixes.begin(), prefixes.end());
+
+    QVariantList list;
+    for (const QString &prefix : prefixes) {
+        const Member member = m_members.value(prefix);
+        QVariantMap map;
+        map["prefix"] = prefix;
+        map["profileName"] = member.profileName;
+        map["plateThickness"] = member.plateThickness;
+        map["matNo"] = member.matNo;
+        map["placement"] = placementToString(member.placement);
+        list.append(map);
+    }
+    return list;
+}
+
+HullGirderSection::Placement PrefixMembers::placementFromString(const QString &placement)
+{
+    return placement.compare("deck", Qt::CaseInsensitive) == 0 ? HullGirderSection::Deck : HullGirderSection::Bottom;
+}
+
+QString PrefixMembers::placementToString(HullGirderSection::Placement placement)
+{
+    return placement == HullGirderSection::Deck ? QStringLiteral("deck") : QStringLiteral("bottom");
+}
+
+QSqlDatabase PrefixMembers::getDatabase() const
+{
+    return DatabaseShipConnection::instance().getDatabase();
+}
@@ -0,0 +1,62 @@
+#ifndef PREFIXMEMBERS_H
+#define PREFIXMEMBERS_H
+
+#include <QObject>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariantList>
+#include <QDebug>
+#include "../../core/HullGirderSection.h"
+
+/**
+ * Longitudinal member of each YZ name prefix (one row per prefix in the ship database):
+ * stiffener profile by library name, attached plating thickness (mm), material number and
+ * whether the prefix's vertical lines sit on the bottom or under the deck. Read by the hull
+ * girder section and the structural weight; membersChanged() is emitted once per change.
+ */
+class PrefixMembers : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Member {
+        QString prefix;
+        QString profileName;
+        double plateThickness = 0.0;
+        int matNo = 0;              // 0 = the weight's default material
+        HullGirderSection::Placement placement = HullGirderSection::Bottom;
+    };
+
+    explicit PrefixMembers(QObject *parent = nullptr);
+
+    // By upper-case prefix
+    const QHash<QString, Member> &members() const { return m_members; }
+    Member member(const QString &prefix) const;
+    QString lastError() const { return m_lastError; }
+
+    // Database operations
+    Q_INVOKABLE bool createTable();
+    Q_INVOKABLE bool loadData();
+    // Adds or replaces the member of member.prefix
+    bool setMember(const Member &member);
+    Q_INVOKABLE bool removeMember(const QString &prefix);
+    // [{prefix, profileName, plateThickness, matNo, placement: "bottom" | "deck"}], sorted by prefix
+    Q_INVOKABLE QVariantList memberList() const;
+
+    static HullGirderSection::Placement placementFromString(const QString &placement);
+    static QString placementToString(HullGirderSection::Placement placement);
+
+signals:
+    void membersChanged();
+    void errorOccurred(const QString &error);
+
+private:
+    QHash<QString, Member> m_members;
+    QString m_lastError;
+
+    QSqlDatabase getDatabase() const;
+};
+
+#endif // PREFIXMEMBERS_H
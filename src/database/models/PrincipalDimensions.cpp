@@ -0,0 +1,148 @@
+#include "PrincipalDimensions.h"
+#include "../DatabaseShipConnection.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+PrincipalDimensions::PrincipalDimensions(QObject *parent)
+    : QObject(parent)
+    , m_lpp(87.780)
+    , m_length(87.7824)
+    , m_breadth(24.384)
+    , m_depth(5.490)
+    , m_draught(0.0)
+{
+}
+
+bool PrincipalDimensions::createTable()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrincipalDimensions::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    QString createTableSQL = R"(
+        CREATE TABLE IF NOT EXISTS structure_seagoing_ship_section0_principal_dimensions (
+            id INTEGER PRIMARY KEY CHECK (id = 1),
+            lpp REAL,
+            l REAL,
+            b REAL,
+            d REAL,
+            t REAL,
+            created_at INTEGER DEFAULT (strftime('%s','now') * 1000),
+            updated_at INTEGER DEFAULT (strftime('%s','now') * 1000)
+        )
+    )";
+
+    if (!query.exec(createTableSQL)) {
+        m_lastError = QString("Failed to create principal dimensions table: %1").arg(query.lastError().text());
+        qCritical() << "PrincipalDimensions::createTable() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    qDebug() << "PrincipalDimensions::createTable() - Table created successfully";
+    return true;
+}
+
+bool PrincipalDimensions::loadData()
+{
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrincipalDimensions::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (!query.exec("SELECT lpp, l, b, d, t FROM structure_seagoing_ship_section0_principal_dimensions WHERE id = 1")) {
+        m_lastError = QString("Failed to load principal dimensions: %1").arg(query.lastError().text());
+        qCritical() << "PrincipalDimensions::loadData() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    // No row yet: keep the defaults
+    if (query.next()) {
+        m_lpp = query.value(0).toDouble();
+        m_length = query.value(1).toDouble();
+        m_breadth = query.value(2).toDouble();
+        m_depth = query.value(3).toDouble();
+        m_draught = query.value(4).toDouble();
+    }
+
+    emit dimensionsChanged();
+    qDebug() << "PrincipalDimensions::loadData() - Lpp" << m_lpp << "L" << m_length
+             << "B" << m_breadth << "D" << m_depth << "T" << m_draught;
+    return true;
+}
+
+bool PrincipalDimensions::setDimensions(double lpp, double length, double breadth, double depth, double draught)
+{
+    if (lpp <= 0.0 || length <= 0.0 || breadth < 0.0 || depth < 0.0 || draught < 0.0) {
+        m_lastError = "Lpp and L must be positive, B, D and T must not be negative";
+        qWarning() << "PrincipalDimensions::setDimensions() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    if (lpp == m_lpp && length == m_length && breadth == m_breadth && depth == m_depth && draught == m_draught)
+        return true;
+
+    QSqlDatabase db = getDatabase();
+    if (!db.isValid()) {
+        m_lastError = "Ship database connection is not valid";
+        qCritical() << "PrincipalDimensions::setDimensions() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO structure_seagoing_ship_section0_principal_dimensions (id, lpp, l, b, d, t) "
+                  "VALUES (1, ?, ?, ?, ?, ?) "
+                  "ON CONFLICT(id) DO UPDATE SET lpp=excluded.lpp, l=excluded.l, b=excluded.b, d=excluded.d, t=excluded.t, "
+                  "updated_at=strftime('%s','now') * 1000");
+    query.addBindValue(lpp);
+    query.addBindValue(length);
+    query.addBindValue(breadth);
+    query.addBindValue(depth);
+    query.addBindValue(draught);
+
+    if (!query.exec()) {
+        m_lastError = QString("Failed to save principal dimensions: %1").arg(query.lastError().text());
+        qCritical() << "PrincipalDimensions::setDimensions() -" << m_lastError;
+        emit errorOccurred(m_lastError);
+        return false;
+    }
+
+    m_lpp = lpp;
+    m_length = length;
+    m_breadth = breadth;
+    m_depth = depth;
+    m_draught = draught;
+
+    qDebug() << "PrincipalDimensions::setDimensions() - Dimensions saved";
+    emit dimensionsChanged();
+    return true;
+}
+
+QVariantMap PrincipalDimensions::getDimensions() const
+{
+    QVariantMap result;
+    result["lpp"] = m_lpp;
+    result["length"] = m_length;
+    result["breadth"] = m_breadth;
+    result["depth"] = m_depth;
+    result["draught"] = m_draught;
+    return result;
+}
+
+QSqlDatabase PrincipalDimensions::getDatabase() const
+{
+    return DatabaseShipConnection::instance().getDatabase();
+}
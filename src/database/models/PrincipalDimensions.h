@@ -0,0 +1,55 @@
+#ifndef PRINCIPALDIMENSIONS_H
+#define PRINCIPALDIMENSIONS_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariantMap>
+#include <QDebug>
+
+/**
+ * Principal dimensions of the ship (single row in the ship database), in metres.
+ * dimensionsChanged() is emitted once per change and drives the XZ length ratios
+ * and the YZ hull outline.
+ */
+class PrincipalDimensions : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double lpp READ lpp NOTIFY dimensionsChanged)
+    Q_PROPERTY(double length READ length NOTIFY dimensionsChanged)
+    Q_PROPERTY(double breadth READ breadth NOTIFY dimensionsChanged)
+    Q_PROPERTY(double depth READ depth NOTIFY dimensionsChanged)
+    Q_PROPERTY(double draught READ draught NOTIFY dimensionsChanged)
+
+public:
+    explicit PrincipalDimensions(QObject *parent = nullptr);
+
+    double lpp() const { return m_lpp; }            // length between perpendiculars
+    double length() const { return m_length; }      // scantling length L
+    double breadth() const { return m_breadth; }    // B
+    double depth() const { return m_depth; }        // D
+    double draught() const { return m_draught; }    // T
+
+    // Database operations
+    Q_INVOKABLE bool createTable();
+    Q_INVOKABLE bool loadData();
+    Q_INVOKABLE bool setDimensions(double lpp, double length, double breadth, double depth, double draught);
+    Q_INVOKABLE QVariantMap getDimensions() const;
+
+signals:
+    void dimensionsChanged();
+    void errorOccurred(const QString &error);
+
+private:
+    double m_lpp;
+    double m_length;
+    double m_breadth;
+    double m_depth;
+    double m_draught;
+    QString m_lastError;
+
+    QSqlDatabase getDatabase() const;
+};
+
+#endif // PRINCIPALDIMENSIONS_H
@@ -150,6 +150,67 @@ bool StructureProfileTable::updateProfile(int id, const QString& type, const QSt
     return true;
 }
 
+bool StructureProfileTable::updateDerivedBatch(const QList<ProfileData>& profiles)
+{
+    if (profiles.isEmpty())
+        return true;
+
+    if (!DatabaseConnection::instance().isConnected()) {
+        m_lastError = "Database is not connected";
+        qCritical() << "StructureProfileTable::updateDerivedBatch() -" << m_lastError;
+        return false;
+    }
+
+    QVariantList areas, es, ws, upperIs, lowerLs, tbs, bfBrackets, tbfs, ids;
+    for (const ProfileData& profile : profiles) {
+        areas << profile.area;
+        es << profile.e;
+        ws << profile.w;
+        upperIs << profile.upperI;
+        lowerLs << profile.lowerL;
+        tbs << profile.tb;
+        bfBrackets << profile.bfBrackets;
+        tbfs << profile.tbf;
+        ids << profile.id;
+    }
+
+    QSqlDatabase db = DatabaseConnection::instance().database();
+    if (!db.transaction()) {
+        m_lastError = QString("Failed to start transaction: %1").arg(db.lastError().text());
+        qCritical() << "StructureProfileTable::updateDerivedBatch() -" << m_lastError;
+        emit error(m_lastError);
+        return false;
+    }
+    QSqlQuery query(db);
+    query.prepare(R"(
+        UPDATE structure_seagoing_ship_section0_profile_table
+        SET area = ?, e = ?, w = ?, upper_i = ?, lower_l = ?, tb = ?, bf_brackets = ?, tbf = ?,
+            updated_at = strftime('%s', 'now') * 1000
+        WHERE id = ?
+    )");
+    query.addBindValue(areas);
+    query.addBindValue(es);
+    query.addBindValue(ws);
+    query.addBindValue(upperIs);
+    query.addBindValue(lowerLs);
+    query.addBindValue(tbs);
+    query.addBindValue(bfBrackets);
+    query.addBindValue(tbfs);
+    query.addBindValue(ids);
+
+    const bool executed = query.execBatch();
+    if (!executed || !db.commit()) {
+        m_lastError = QString("Failed to update derived profile values: %1").arg(executed ? db.lastError().text() : query.lastError().text());
+        qCritical() << "StructureProfileTable::updateDerivedBatch() -" << m_lastError;
+        db.rollback();
+        emit error(m_lastError);
+        return false;
+    }
+
+    qDebug() << "StructureProfileTable::updateDerivedBatch() - Updated" << profiles.size() << "profiles";
+    return true;
+}
+
 bool StructureProfileTable::deleteProfile(int id)
 {
     if (!DatabaseConnection::instance().isConnected()) {
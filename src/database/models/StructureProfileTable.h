@@ -50,6 +50,8 @@ public:
     
     bool deleteProfile(int id);
     bool deleteProfileByName(const QString& name);
+    // Writes the derived columns (area .. tbf) of many profiles in one transaction
+    bool updateDerivedBatch(const QList<ProfileData>& profiles);
     
     // Query operations
     ProfileData findProfileById(int id);
@@ -0,0 +1,86 @@
+#include <QtTest>
+#include "../src/core/DependencyGraph.h"
+
+/**
+ * Unit tests for DependencyGraph.
+ *
+ * Run order and skipping follow the rules in DependencyGraph.h; compute functions only
+ * record that they ran.
+ */
+class TestDependencyGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dependencyOrder();
+    void dependencyCycles();
+    void dependencyDuplicateInputs();
+};
+
+void TestDependencyGraph::dependencyOrder()
+{
+    // a -> b, a -> c, (b, c) -> d
+    DependencyGraph graph;
+    QStringList ran;
+    bool cChanges = true;
+    const QStringList bc = { QStringLiteral("b"), QStringLiteral("c") };
+    QVERIFY(graph.addNode(QStringLiteral("b"), { QStringLiteral("a") }, [&]() { ran << QStringLiteral("b"); return false; }));
+    QVERIFY(graph.addNode(QStringLiteral("c"), { QStringLiteral("a") }, [&]() { ran << QStringLiteral("c"); return cChanges; }));
+    QVERIFY(graph.addNode(QStringLiteral("d"), bc, [&]() { ran << QStringLiteral("d"); return true; }));
+
+    graph.invalidate(QStringLiteral("a"));
+    QVERIFY(graph.hasDirty());
+    const QStringList planned = graph.dirtyOrder();
+    QCOMPARE(planned.size(), 3);
+    QCOMPARE(planned.last(), QStringLiteral("d"));
+
+    QCOMPARE(graph.run(), planned);
+    QCOMPARE(ran, planned);
+    QVERIFY(!graph.hasDirty());
+
+    // Neither b nor c changes: d is not recomputed
+    ran.clear();
+    cChanges = false;
+    graph.invalidate(QStringLiteral("a"));
+    graph.run();
+    QCOMPARE(ran.size(), 2);
+    QVERIFY(!ran.contains(QStringLiteral("d")));
+
+    // An edited derived node keeps its value; only what depends on it runs
+    ran.clear();
+    graph.invalidate(QStringLiteral("c"));
+    QCOMPARE(graph.run(), QStringList{ QStringLiteral("d") });
+}
+
+void TestDependencyGraph::dependencyCycles()
+{
+    DependencyGraph graph;
+    QVERIFY(graph.addNode(QStringLiteral("b"), { QStringLiteral("a") }, []() { return true; }));
+    QVERIFY(graph.addNode(QStringLiteral("c"), { QStringLiteral("b") }, []() { return true; }));
+
+    QVERIFY(!graph.addNode(QStringLiteral("x"), { QStringLiteral("x") }, []() { return true; }));
+    QVERIFY(!graph.addNode(QStringLiteral("a"), { QStringLiteral("c") }, []() { return true; }));
+    QVERIFY(!graph.addNode(QStringLiteral("b"), { QStringLiteral("c") }, []() { return true; }));
+    QVERIFY(!graph.contains(QStringLiteral("a")));
+    QVERIFY(!graph.contains(QStringLiteral("x")));
+    QCOMPARE(graph.nodeCount(), 2);
+    // A rejected replacement leaves the node as it was
+    QCOMPARE(graph.inputs(QStringLiteral("b")), QStringList{ QStringLiteral("a") });
+}
+
+void TestDependencyGraph::dependencyDuplicateInputs()
+{
+    DependencyGraph graph;
+    int runs = 0;
+    const QStringList twice = { QStringLiteral("a"), QStringLiteral("a") };
+    QVERIFY(graph.addNode(QStringLiteral("e"), twice, [&]() { ++runs; return true; }));
+    QCOMPARE(graph.inputs(QStringLiteral("e")), QStringList{ QStringLiteral("a") });
+
+    graph.invalidate(QStringLiteral("a"));
+    QCOMPARE(graph.run(), QStringList{ QStringLiteral("e") });
+    QCOMPARE(runs, 1);
+}
+
+QTEST_APPLESS_MAIN(TestDependencyGraph)
+
+#include "TestDependencyGraph.moc"
@@ -0,0 +1,189 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlQuery>
+#include "../src/database/DatabaseShipConnection.h"
+#include "../src/database/models/FrameArrangementXZ.h"
+#include "../src/database/models/FrameArrangementYZ.h"
+
+/**
+ * Tests for the in-memory stores of the XZ and YZ frame models against a scratch ship
+ * database: the x to frame lookup, the stored YZ prefix/suffix columns, batch renames and
+ * the per-frame partitions kept in step with single-row edits.
+ *
+ * The database lives in a temporary directory; every test starts from empty tables.
+ */
+class TestFrameArrangementStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanupTestCase();
+
+    void xzFrameLookup();
+    void yzStoredPrefixSuffix();
+    void yzBatchRename();
+    void yzFramePartitions();
+
+private:
+    QTemporaryDir m_tempDir;
+    FrameArrangementXZ *m_xz = nullptr;
+    FrameArrangementYZ *m_yz = nullptr;
+
+    static QStringList storedNames(const FrameArrangementYZ &model);
+};
+
+void TestFrameArrangementStore::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+    QVERIFY(DatabaseShipConnection::instance().initialize(m_tempDir.filePath("shipsdb.db")));
+
+    m_xz = new FrameArrangementXZ(this);
+    m_yz = new FrameArrangementYZ(this);
+    QVERIFY(m_xz->createTable());
+    QVERIFY(m_yz->createTable());
+}
+
+void TestFrameArrangementStore::init()
+{
+    QSqlQuery query(DatabaseShipConnection::instance().getDatabase());
+    QVERIFY(query.exec("DELETE FROM structure_seagoing_ship_section0_frame_arrangement_xz"));
+    QVERIFY(query.exec("DELETE FROM structure_seagoing_ship_section0_frame_arrangement_yz"));
+    QVERIFY(m_xz->loadData());
+    QVERIFY(m_yz->loadData());
+}
+
+void TestFrameArrangementStore::cleanupTestCase()
+{
+    DatabaseShipConnection::instance().close();
+}
+
+// Names of the whole YZ store, in store order
+QStringList TestFrameArrangementStore::storedNames(const FrameArrangementYZ &model)
+{
+    QStringList names;
+    for (const FrameArrangementYZ::FrameYZData &frame : model.allFrames())
+        names << frame.name;
+    return names;
+}
+
+void TestFrameArrangementStore::xzFrameLookup()
+{
+    const QString forward = QStringLiteral("FORWARD");
+    QCOMPARE(m_xz->nearestIndexAt(1.0), -1);
+    QVERIFY(qIsNaN(m_xz->fractionalFrameAt(1.0)));
+
+    // Frames 0..4 at 600 mm: x = 0, 0.6, 1.2, 1.8, 2.4 m
+    for (int n = 0; n <= 4; ++n)
+        QVERIFY(m_xz->insertFrame(QStringLiteral("Frame %1").arg(n), n, 600, forward, n * 0.6));
+    QVERIFY(m_xz->loadData());
+    QCOMPARE(m_xz->getRowCount(), 5);
+
+    auto frameAt = [this](int row) { return m_xz->getFrameAtIndex(row).value("frameNumber").toInt(); };
+    QCOMPARE(frameAt(m_xz->nearestIndexAt(1.0)), 2);     // 0.2 m from frame 2, 0.4 m from frame 1
+    QCOMPARE(frameAt(m_xz->nearestIndexAt(0.8)), 1);
+    QCOMPARE(frameAt(m_xz->nearestIndexAt(-5.0)), 0);
+    QCOMPARE(frameAt(m_xz->nearestIndexAt(9.0)), 4);
+
+    const QVector<int> between = m_xz->indicesBetween(1.9, 0.5);
+    QCOMPARE(between.size(), 3);
+    QCOMPARE(frameAt(between.at(0)), 1);
+    QCOMPARE(frameAt(between.at(2)), 3);
+    QVERIFY(m_xz->indicesBetween(0.7, 1.1).isEmpty());
+
+    QCOMPARE(m_xz->fractionalFrameAt(0.9), 1.5);
+    // Past the last frame: extrapolated with its spacing
+    QCOMPARE(m_xz->fractionalFrameAt(3.0), 5.0);
+    QCOMPARE(m_xz->fractionalFrameAt(-0.6), -1.0);
+}
+
+void TestFrameArrangementStore::yzStoredPrefixSuffix()
+{
+    const int id = m_yz->insertFrame(QStringLiteral("b12"), 3, 600.0, 1000.0, 2000.0, 5, QString(), QString());
+    QVERIFY(id > 0);
+
+    QSqlQuery query(DatabaseShipConnection::instance().getDatabase());
+    QVERIFY(query.exec(QStringLiteral("SELECT prefix, suffix FROM structure_seagoing_ship_section0_frame_arrangement_yz WHERE id = %1").arg(id)));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toString(), QStringLiteral("B"));
+    QCOMPARE(query.value(1).toInt(), 12);
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("b")), 14);   // B12..B14
+
+    // A row written before the columns existed is parsed once by createTable()
+    QVERIFY(query.exec("INSERT INTO structure_seagoing_ship_section0_frame_arrangement_yz (name, no, spacing, frame_no) "
+                       "VALUES ('7', 2, 600, 5)"));
+    QVERIFY(m_yz->createTable());
+    QVERIFY(m_yz->loadData());
+    QVERIFY(query.exec("SELECT COUNT(*) FROM structure_seagoing_ship_section0_frame_arrangement_yz WHERE prefix IS NULL OR suffix IS NULL"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("L")), 8);    // '7' is L7..L8
+    QCOMPARE(storedNames(*m_yz), (QStringList{ QStringLiteral("b12"), QStringLiteral("7") }));
+}
+
+void TestFrameArrangementStore::yzBatchRename()
+{
+    const int a = m_yz->insertFrame(QStringLiteral("L1"), 1, 600.0, 1000.0, 0.0, 5, QString(), QString());
+    const int b = m_yz->insertFrame(QStringLiteral("L2"), 1, 600.0, 2000.0, 0.0, 5, QString(), QString());
+    QVERIFY(a > 0 && b > 0);
+
+    QVERIFY(m_yz->updateFrameNamesBatch({ { a, QStringLiteral("L7") }, { b, QStringLiteral("L8"), 1 } }));
+    QCOMPARE(storedNames(*m_yz), (QStringList{ QStringLiteral("L7"), QStringLiteral("L8") }));
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("L")), 8);
+    QVERIFY(m_yz->checkSuffixConflict(QStringLiteral("L"), 1, 2).isEmpty());
+    for (const FrameArrangementYZ::FrameYZData &frame : m_yz->allFrames())
+        QCOMPARE(frame.isManual, frame.id == b);
+
+    // A prefix change reorders the store by prefix, as a reload from the database would
+    QVERIFY(m_yz->updateFrameNamesBatch({ { b, QStringLiteral("B3") } }));
+    QCOMPARE(storedNames(*m_yz), (QStringList{ QStringLiteral("B3"), QStringLiteral("L7") }));
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("L")), 7);
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("B")), 3);
+
+    QSqlQuery query(DatabaseShipConnection::instance().getDatabase());
+    QVERIFY(query.exec(QStringLiteral("SELECT name, prefix, suffix FROM structure_seagoing_ship_section0_frame_arrangement_yz WHERE id = %1").arg(b)));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toString(), QStringLiteral("B3"));
+    QCOMPARE(query.value(1).toString(), QStringLiteral("B"));
+    QCOMPARE(query.value(2).toInt(), 3);
+}
+
+void TestFrameArrangementStore::yzFramePartitions()
+{
+    const int a = m_yz->insertFrame(QStringLiteral("L1"), 1, 600.0, 1000.0, 0.0, 5, QString(), QString());
+    const int b = m_yz->insertFrame(QStringLiteral("L2"), 1, 600.0, 2000.0, 0.0, 5, QString(), QString());
+    const int c = m_yz->insertFrame(QStringLiteral("L3"), 1, 600.0, 3000.0, 0.0, 6, QString(), QString());
+    QVERIFY(a > 0 && b > 0 && c > 0);
+
+    QVERIFY(m_yz->loadDataByFrameNo(5));
+    QCOMPARE(m_yz->getRowCount(), 2);
+    QCOMPARE(m_yz->rowsOfFrame(6).size(), 1);
+
+    // Moving a row to another frame updates both partitions and the filtered view
+    QVERIFY(m_yz->updateFrame(b, QStringLiteral("L2"), 1, 600.0, 2000.0, 0.0, 6, QString(), QString()));
+    QVERIFY(m_yz->isFrameFiltered());
+    QCOMPARE(m_yz->getRowCount(), 1);
+    QCOMPARE(m_yz->getFrameAtIndex(0).value("id").toInt(), a);
+    QCOMPARE(m_yz->rowsOfFrame(6).size(), 2);
+
+    // A same-prefix rename is patched in place, a new prefix moves the row in the order
+    QVERIFY(m_yz->updateFrameName(c, QStringLiteral("L9"), false));
+    QCOMPARE(storedNames(*m_yz), (QStringList{ QStringLiteral("L1"), QStringLiteral("L2"), QStringLiteral("L9") }));
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("L")), 9);
+    QVERIFY(m_yz->updateFrameName(c, QStringLiteral("A1"), false));
+    QCOMPARE(storedNames(*m_yz), (QStringList{ QStringLiteral("A1"), QStringLiteral("L1"), QStringLiteral("L2") }));
+    QCOMPARE(m_yz->getLastSuffixForPrefix(QStringLiteral("L")), 2);
+    for (int index : m_yz->rowsOfFrame(6))
+        QVERIFY(m_yz->allFrames().at(index).frameNo == 6);
+    QCOMPARE(m_yz->getRowCount(), 1);
+
+    QVERIFY(m_yz->deleteFrame(a));
+    QCOMPARE(m_yz->getRowCount(), 0);
+    QVERIFY(m_yz->rowsOfFrame(5).isEmpty());
+    QCOMPARE(m_yz->rowsOfFrame(6).size(), 2);
+}
+
+QTEST_GUILESS_MAIN(TestFrameArrangementStore)
+
+#include "TestFrameArrangementStore.moc"
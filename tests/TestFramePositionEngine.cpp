@@ -0,0 +1,133 @@
+#include <QtTest>
+#include "../src/core/FramePositionEngine.h"
+
+/**
+ * Unit tests for FramePositionEngine.
+ *
+ * Positions are worked out by hand from the FrameCoordinates rules: each frame continues
+ * from the closest lower one with that frame's spacing, frames below 0 sit at n x spacing.
+ */
+class TestFramePositionEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void positions();
+    void negativeFrames();
+    void anchors();
+    void anchorsAcrossCapacity();
+};
+
+void TestFramePositionEngine::positions()
+{
+    FramePositionEngine engine;
+    engine.insertFrame(0, 600);
+    engine.insertFrame(10, 700);
+    engine.insertFrame(20, 500);
+
+    QCOMPARE(engine.frameCount(), 3);
+    QVERIFY(engine.contains(10));
+    QVERIFY(!engine.contains(15));
+    QCOMPARE(engine.spacingOf(10), 700);
+
+    // 10 x 600, then 10 x 700, then frames past the last one continue at 500
+    QCOMPARE(engine.position(0), 0.0);
+    QCOMPARE(engine.position(10), 6.0);
+    QCOMPARE(engine.position(15), 9.5);
+    QCOMPARE(engine.positionMm(20), qint64(13000));
+    QCOMPARE(engine.position(25), 15.5);
+
+    engine.setSpacing(10, 800);
+    QCOMPARE(engine.positionMm(20), qint64(14000));
+
+    // Without frame 10 its bay falls back to the spacing of frame 0
+    engine.removeFrame(10);
+    QVERIFY(!engine.contains(10));
+    QCOMPARE(engine.positionMm(20), qint64(12000));
+}
+
+void TestFramePositionEngine::negativeFrames()
+{
+    FramePositionEngine engine;
+    engine.insertFrame(-3, 650);
+    engine.insertFrame(0, 600);
+    engine.insertFrame(2, 600);
+
+    QCOMPARE(engine.positionMm(-3), qint64(-1950));
+    // Unknown frames below 0 use the spacing they are asked with
+    QCOMPARE(engine.positionMm(-2, 700), qint64(-1400));
+    QCOMPARE(engine.positionMm(2), qint64(1200));
+
+    // A repeated frame number stays known until every occurrence is removed
+    engine.insertFrame(2, 600);
+    engine.removeFrame(2);
+    QVERIFY(engine.contains(2));
+    engine.removeFrame(2);
+    QVERIFY(!engine.contains(2));
+
+    // An anchor below 0 moves only its own frame
+    engine.setAnchor(-3, -2000);
+    QCOMPARE(engine.positionMm(-3), qint64(-2000));
+    QCOMPARE(engine.anchorOffset(-3), qint64(-50));
+    QCOMPARE(engine.positionMm(0), qint64(0));
+}
+
+void TestFramePositionEngine::anchors()
+{
+    FramePositionEngine engine;
+    engine.insertFrame(0, 600);
+    engine.insertFrame(10, 700);
+    engine.insertFrame(20, 500);
+
+    // Frame 10 entered by hand at 6.5 m instead of 6.0 m: everything above follows
+    engine.setAnchor(10, 6500);
+    QCOMPARE(engine.anchorOffset(10), qint64(500));
+    QCOMPARE(engine.positionMm(9), qint64(5400));
+    QCOMPARE(engine.positionMm(10), qint64(6500));
+    QCOMPARE(engine.positionMm(15), qint64(10000));
+    QCOMPARE(engine.positionMm(20), qint64(13500));
+
+    // Re-spacing above the anchor keeps it where it was entered
+    engine.setSpacing(10, 800);
+    QCOMPARE(engine.positionMm(10), qint64(6500));
+    QCOMPARE(engine.positionMm(20), qint64(14500));
+
+    // Re-spacing below carries the anchor along with its offset
+    engine.setSpacing(0, 500);
+    QCOMPARE(engine.positionMm(10), qint64(5500));
+    QCOMPARE(engine.positionMm(20), qint64(13500));
+
+    // Anchoring again replaces the offset, inserting a frame below keeps it
+    engine.setAnchor(10, 6000);
+    QCOMPARE(engine.anchorOffset(10), qint64(1000));
+    engine.insertFrame(5, 600);
+    QCOMPARE(engine.positionMm(10), qint64(6500));
+    QCOMPARE(engine.anchorOffset(10), qint64(1000));
+
+    // Removing the frame drops its anchor
+    engine.removeFrame(10);
+    QCOMPARE(engine.anchorOffset(10), qint64(0));
+    QCOMPARE(engine.positionMm(20), qint64(11500));
+
+    // Unknown frames cannot be anchored
+    engine.setAnchor(12, 9000);
+    QCOMPARE(engine.positionMm(12), qint64(6700));
+}
+
+void TestFramePositionEngine::anchorsAcrossCapacity()
+{
+    FramePositionEngine engine;
+    engine.insertFrame(0, 600);
+    engine.insertFrame(3, 600);
+    engine.setAnchor(3, 2000);
+
+    // Growing the trees past the initial capacity keeps the anchor
+    engine.insertFrame(1000, 700);
+    QCOMPARE(engine.positionMm(3), qint64(2000));
+    QCOMPARE(engine.positionMm(1000), qint64(2000 + 997 * 600));
+    QCOMPARE(engine.positionMm(5000), qint64(2000 + 997 * 600 + 4000 * 700));
+}
+
+QTEST_APPLESS_MAIN(TestFramePositionEngine)
+
+#include "TestFramePositionEngine.moc"
@@ -0,0 +1,87 @@
+#include <QtTest>
+#include "../src/core/FrameZoneTable.h"
+
+/**
+ * Unit tests for FrameZoneTable.
+ *
+ * Coordinates follow the FrameCoordinates rules and are worked out by hand.
+ */
+class TestFrameZoneTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void duplicateFrame();
+};
+
+void TestFrameZoneTable::roundTrip()
+{
+    const QString forward = QStringLiteral("FORWARD");
+    FrameZoneTable table;
+    table.setZones({
+        { -2, 0, 600, forward, QString() },
+        { 1, 4, 700, forward, QString() },
+        { 5, 5, 700, forward, QStringLiteral("Bulkhead") },
+        { 6, 8, 500, QStringLiteral("AFT"), QString() },
+    });
+
+    QCOMPARE(table.rowCount(), 11);
+    QCOMPARE(table.indexOfFrame(-2), 0);
+    QCOMPARE(table.indexOfFrame(5), 7);
+    QCOMPARE(table.indexOfFrame(9), -1);
+
+    const QVector<FrameCoordinates::FrameRow> rows = table.toRows(100.0, 50.0);
+    QCOMPARE(rows.size(), 11);
+    QCOMPARE(rows.at(0).xpCoor, -1.2);
+    QCOMPARE(rows.at(2).xpCoor, 0.0);
+    QCOMPARE(rows.at(3).xpCoor, 0.6);       // frame 1: 1 x 600 from frame 0
+    QCOMPARE(rows.at(6).xpCoor, 2.7);       // frame 4: + 3 x 700
+    QCOMPARE(rows.at(7).frameName, QStringLiteral("Bulkhead"));
+    QCOMPARE(rows.at(7).xpCoor, 3.4);
+    QCOMPARE(rows.at(10).frameNumber, 8);
+    QCOMPARE(rows.at(10).xpCoor, 5.1);      // frame 8: 4.1 + 2 x 500
+    QCOMPARE(rows.at(10).xl, 0.051);
+    QCOMPARE(rows.at(10).xllLll, 0.102);
+    QCOMPARE(rows.at(10).ml, QStringLiteral("AFT"));
+
+    bool lossless = false;
+    const FrameZoneTable back = FrameZoneTable::fromRows(rows, &lossless);
+    QVERIFY(lossless);
+    QCOMPARE(back.zoneCount(), table.zoneCount());
+    for (int i = 0; i < table.zoneCount(); ++i) {
+        const FrameZoneTable::Zone &a = table.zones().at(i);
+        const FrameZoneTable::Zone &b = back.zones().at(i);
+        QCOMPARE(b.startFrame, a.startFrame);
+        QCOMPARE(b.endFrame, a.endFrame);
+        QCOMPARE(b.spacing, a.spacing);
+        QCOMPARE(b.ml, a.ml);
+        QCOMPARE(b.frameName, a.frameName);
+    }
+
+    const QVector<FrameCoordinates::FrameRow> again = back.toRows(100.0, 50.0);
+    QCOMPARE(again.size(), rows.size());
+    for (int i = 0; i < rows.size(); ++i) {
+        QCOMPARE(again.at(i).frameNumber, rows.at(i).frameNumber);
+        QCOMPARE(again.at(i).frameName, rows.at(i).frameName);
+        QCOMPARE(again.at(i).xpCoor, rows.at(i).xpCoor);
+    }
+}
+
+void TestFrameZoneTable::duplicateFrame()
+{
+    FrameCoordinates::FrameRow row;
+    row.frameNumber = 3;
+    row.frameName = FrameZoneTable::defaultFrameName(3);
+    row.frameSpacing = 600;
+    row.ml = QStringLiteral("FORWARD");
+
+    bool lossless = true;
+    const FrameZoneTable table = FrameZoneTable::fromRows({ row, row }, &lossless);
+    QVERIFY(!lossless);
+    QCOMPARE(table.rowCount(), 1);
+}
+
+QTEST_APPLESS_MAIN(TestFrameZoneTable)
+
+#include "TestFrameZoneTable.moc"
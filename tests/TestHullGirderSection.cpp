@@ -0,0 +1,118 @@
+#include <QtTest>
+#include "../src/core/HullGirderSection.h"
+
+/**
+ * Unit tests for HullGirderSection.
+ *
+ * Sections are boxes, so every element lever and the neutral axis can be worked out by hand.
+ */
+class TestHullGirderSection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void longitudinals();
+    void plateStrips();
+};
+
+void TestHullGirderSection::longitudinals()
+{
+    // 10 m deep box, 10 cm2 bare stiffeners 50 mm off the plating, no plate strips
+    HullGirderSection girder;
+    girder.setOutline(5000.0, 10000.0);
+
+    HullGirderSection::Member bottom;
+    bottom.areaCm2 = 10.0;
+    bottom.eMM = 50.0;
+    HullGirderSection::Member deck = bottom;
+    deck.placement = HullGirderSection::Deck;
+    QHash<QString, HullGirderSection::Member> members;
+    members.insert(QStringLiteral("B"), bottom);
+    members.insert(QStringLiteral("D"), deck);
+    members.insert(QStringLiteral("S"), bottom);
+    girder.setMembers(members, HullGirderSection::Member());
+
+    // One centreline girder at the bottom, one at the deck, one side longitudinal per side
+    YZLineGeometry::Row vertical;
+    vertical.prefix = QStringLiteral("B");
+    vertical.count = 1;
+    vertical.hasY = true;
+    vertical.y = 0.0;
+    vertical.sym = QStringLiteral("P+S");
+    QVERIFY(girder.setRow(1, vertical));
+    vertical.prefix = QStringLiteral("D");
+    QVERIFY(girder.setRow(2, vertical));
+    YZLineGeometry::Row side;
+    side.prefix = QStringLiteral("S");
+    side.count = 1;
+    side.hasZ = true;
+    side.z = 5000.0;
+    side.sym = QStringLiteral("P+S");
+    QVERIFY(girder.setRow(3, side));
+    QVERIFY(!girder.setRow(3, side));
+
+    // Elements at z = 0.05, 9.95 and 2 x 5.0 m, 0.001 m2 each:
+    // NA = 5 m, I = 2 x 0.001 x 4.95^2 = 0.049005 m4 (own inertia 0)
+    HullGirderSection::Result result = girder.result();
+    QVERIFY(result.valid);
+    QCOMPARE(result.elements, 4);
+    QCOMPARE(result.areaM2, 0.004);
+    QCOMPARE(result.neutralAxisM, 5.0);
+    QCOMPARE(result.inertiaM4, 0.049005);
+    QCOMPARE(result.modulusDeckM3, 0.009801);
+    QCOMPARE(result.modulusKeelM3, 0.009801);
+    // Single-line rows have no strip width
+    QCOMPARE(result.unplated, 4);
+
+    // Dropping the deck girder re-expands no other row and moves the axis down
+    girder.resetExpandedRows();
+    QVERIFY(girder.removeRow(2));
+    QCOMPARE(girder.expandedRows(), 0);
+    result = girder.result();
+    QCOMPARE(result.elements, 3);
+    QCOMPARE(result.neutralAxisM, (0.05 + 2.0 * 5.0) / 3.0);
+}
+
+void TestHullGirderSection::plateStrips()
+{
+    // 10 cm2 bottom longitudinals 50 mm above 10 mm plating
+    HullGirderSection girder;
+    girder.setOutline(5000.0, 10000.0);
+    HullGirderSection::Member bottom;
+    bottom.areaCm2 = 10.0;
+    bottom.eMM = 50.0;
+    bottom.plateThicknessMM = 10.0;
+    QHash<QString, HullGirderSection::Member> members;
+    members.insert(QStringLiteral("B"), bottom);
+    girder.setMembers(members, HullGirderSection::Member());
+
+    // Two lines 1 m apart on each side: four longitudinals with a 1000 x 10 strip each
+    YZLineGeometry::Row row;
+    row.prefix = QStringLiteral("B");
+    row.count = 2;
+    row.spacing = 1000.0;
+    row.hasY = true;
+    row.y = 1000.0;
+    row.sym = QStringLiteral("P+S");
+    QVERIFY(girder.setRow(1, row));
+    HullGirderSection::Result result = girder.result();
+    QCOMPARE(result.elements, 8);
+    QCOMPARE(result.unplated, 0);
+    QCOMPARE(result.areaM2, 0.044);
+
+    // A centreline girder on its own row gets its stiffener but no plating
+    YZLineGeometry::Row centre = row;
+    centre.count = 1;
+    centre.spacing = 0.0;
+    centre.y = 0.0;
+    QVERIFY(girder.setRow(2, centre));
+    result = girder.result();
+    QCOMPARE(result.elements, 9);
+    QCOMPARE(result.unplated, 1);
+    QCOMPARE(result.areaM2, 0.045);
+    QVERIFY(!HullGirderSection::scope().isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestHullGirderSection)
+
+#include "TestHullGirderSection.moc"
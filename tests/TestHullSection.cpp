@@ -0,0 +1,103 @@
+#include <QtTest>
+#include <cmath>
+#include "../src/core/HullSection.h"
+#include "../src/core/YZLineGeometry.h"
+
+/**
+ * Unit tests for HullSection and the per-frame section cache.
+ *
+ * The offsets describe a wedge, so every crossing is a straight-line interpolation.
+ */
+class TestHullSection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void clipLine();
+    void clipGeometryPerFrame();
+
+private:
+    static QVector<HullSection::Offset> wedgeOffsets();
+};
+
+QVector<HullSection::Offset> TestHullSection::wedgeOffsets()
+{
+    // Wall-sided stations, 2000 mm half breadth at x = 0 m and 4000 mm at x = 10 m
+    QVector<HullSection::Offset> offsets;
+    for (double x : { 0.0, 10.0 }) {
+        for (double z : { 0.0, 3000.0 })
+            offsets.append({ x, z, x == 0.0 ? 2000.0 : 4000.0 });
+    }
+    return offsets;
+}
+
+void TestHullSection::clipLine()
+{
+    HullSection section;
+    section.setOffsets(wedgeOffsets());
+    QCOMPARE(section.stationCount(), 2);
+
+    // Half way between the stations the half breadth is interpolated to 3000
+    const QVector<QPointF> polygon = section.polygonAt(5.0);
+    QVERIFY(!polygon.isEmpty());
+
+    QVector<HullSection::Span> spans = HullSection::clipLine(polygon, YZLineGeometry::Horizontal, 1000.0);
+    QCOMPARE(spans.size(), 1);
+    QCOMPARE(spans.first().from, -3000.0);
+    QCOMPARE(spans.first().to, 3000.0);
+
+    spans = HullSection::clipLine(polygon, YZLineGeometry::Vertical, 1000.0);
+    QCOMPARE(spans.size(), 1);
+    QCOMPARE(spans.first().from, 0.0);
+    QCOMPARE(spans.first().to, 3000.0);
+
+    // Above the deck and outside the side shell nothing is left
+    QVERIFY(HullSection::clipLine(polygon, YZLineGeometry::Horizontal, 4000.0).isEmpty());
+    QVERIFY(HullSection::clipLine(polygon, YZLineGeometry::Vertical, 3500.0).isEmpty());
+}
+
+void TestHullSection::clipGeometryPerFrame()
+{
+    HullSection section;
+    section.setOffsets(wedgeOffsets());
+    HullSectionCache cache;
+    cache.setSection(section);
+    QHash<int, double> xp;
+    xp.insert(0, 0.0);
+    xp.insert(10, 10.0);
+    cache.setFramePositions(xp);
+
+    // Same line on three frames: each is clipped on its own frame's section
+    YZLineGeometry::Row a;
+    a.prefix = QStringLiteral("A");
+    a.count = 1;
+    a.z = 1000.0;
+    a.hasZ = true;
+    a.sym = QStringLiteral("P+S");
+    a.frameNo = 0;
+    YZLineGeometry::Row b = a;
+    b.prefix = QStringLiteral("B");
+    b.frameNo = 10;
+    YZLineGeometry::Row c = a;
+    c.prefix = QStringLiteral("C");
+    c.frameNo = 99;     // no position, so no section
+
+    YZLineGeometry geometry;
+    geometry.build({ a, b, c });
+    const HullSectionCache::LineClip clip = cache.clipGeometry(geometry, 0);
+    QCOMPARE(clip.offsets.size(), 4);
+    QCOMPARE(clip.spans.size(), 3);
+    QCOMPARE(clip.spans.at(0).from, -2000.0);
+    QCOMPARE(clip.spans.at(0).to, 2000.0);
+    QCOMPARE(clip.spans.at(1).from, -4000.0);
+    QCOMPARE(clip.spans.at(1).to, 4000.0);
+    QVERIFY(std::isinf(clip.spans.at(2).from) && clip.spans.at(2).from < 0.0);
+    QVERIFY(std::isinf(clip.spans.at(2).to) && clip.spans.at(2).to > 0.0);
+
+    // The clip is cached per frame and stable
+    QCOMPARE(cache.clipGeometry(geometry, 0), clip);
+}
+
+QTEST_APPLESS_MAIN(TestHullSection)
+
+#include "TestHullSection.moc"
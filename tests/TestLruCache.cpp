@@ -0,0 +1,51 @@
+#include <QtTest>
+#include "../src/core/LruCache.h"
+
+/**
+ * Unit tests for LruCache.
+ *
+ * Hit and miss counts are worked out by hand from the sequence of find() calls.
+ */
+class TestLruCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void lruEviction();
+};
+
+void TestLruCache::lruEviction()
+{
+    LruCache<int, QString> cache(2);
+    cache.insert(1, QStringLiteral("one"));
+    cache.insert(2, QStringLiteral("two"));
+
+    // Touching 1 makes 2 the least recently used entry
+    QVERIFY(cache.find(1));
+    cache.insert(3, QStringLiteral("three"));
+    QCOMPARE(cache.size(), 2);
+    QVERIFY(!cache.find(2));
+    QCOMPARE(*cache.find(1), QStringLiteral("one"));
+    QCOMPARE(*cache.find(3), QStringLiteral("three"));
+
+    // Replacing a value refreshes it without evicting anything
+    cache.insert(1, QStringLiteral("uno"));
+    cache.insert(4, QStringLiteral("four"));
+    QVERIFY(!cache.find(3));
+    QCOMPARE(*cache.find(1), QStringLiteral("uno"));
+
+    QCOMPARE(cache.hits(), quint64(4));
+    QCOMPARE(cache.misses(), quint64(2));
+    QCOMPARE(cache.hitRate(), 4.0 / 6.0);
+
+    cache.clear();
+    cache.resetCounters();
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.hits(), quint64(0));
+    const LruCache<int, QString> minimal(0);
+    QCOMPARE(minimal.capacity(), 1);
+}
+
+QTEST_APPLESS_MAIN(TestLruCache)
+
+#include "TestLruCache.moc"
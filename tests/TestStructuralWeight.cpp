@@ -0,0 +1,55 @@
+#include <QtTest>
+#include "../src/core/StructuralWeight.h"
+
+/**
+ * Unit tests for StructuralWeight.
+ *
+ * A box section and bays of whole metres keep every mass and centre of gravity exact.
+ */
+class TestStructuralWeight : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void longitudinal();
+};
+
+void TestStructuralWeight::longitudinal()
+{
+    // One bottom longitudinal of 20 cm2 over three 1 m bays
+    StructuralWeight weight;
+    weight.setOutline(5000.0, 10000.0);
+    QVector<StructuralWeight::Bay> bays;
+    for (int frame = 0; frame < 3; ++frame)
+        bays.append({ frame, double(frame), 1000.0 });
+    weight.setBays(bays);
+
+    StructuralWeight::Member member;
+    member.section.areaCm2 = 20.0;
+    member.densityKgM3 = 7850.0;
+    QHash<QString, StructuralWeight::Member> members;
+    members.insert(QStringLiteral("L"), member);
+    weight.setMembers(members, StructuralWeight::Member());
+
+    YZLineGeometry::Row row;
+    row.prefix = QStringLiteral("L");
+    row.count = 1;
+    row.hasY = true;
+    row.y = 0.0;
+    row.sym = QStringLiteral("P+S");
+    QVERIFY(weight.setRow(0, 1, row));
+    weight.update();
+
+    // area x length x density = 0.002 m2 x 3 m x 7850 kg/m3, counted once
+    const StructuralWeight::Result &result = weight.result();
+    QCOMPARE(result.total.massKg, 47.1);
+    QCOMPARE(result.total.lcgM, 1.5);
+    QCOMPARE(result.total.vcgM, 0.0);
+    QCOMPARE(result.zones.size(), 1);
+    QCOMPARE(result.zones.first().lengthM, 3.0);
+    QCOMPARE(result.byPrefix.value(QStringLiteral("L")).massKg, 47.1);
+}
+
+QTEST_APPLESS_MAIN(TestStructuralWeight)
+
+#include "TestStructuralWeight.moc"
@@ -0,0 +1,68 @@
+#include <QtTest>
+#include "../src/core/YZSuffixIndex.h"
+
+/**
+ * Unit tests for YZSuffixIndex.
+ *
+ * Ranges are inclusive, L1..L5 is suffix 1 with count 5; expected values are worked out by hand.
+ */
+class TestYZSuffixIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void suffixOverlaps();
+    void suffixNextFree();
+};
+
+void TestYZSuffixIndex::suffixOverlaps()
+{
+    YZSuffixIndex index;
+    index.insert(1, QStringLiteral("L"), 1, 5, false);     // L1..L5
+    index.insert(2, QStringLiteral("L"), 10, 3, true);     // L10..L12
+    index.insert(3, QStringLiteral("B"), 1, 4, false);     // B1..B4
+
+    QCOMPARE(index.size(), 3);
+    QCOMPARE(index.lastSuffix(QStringLiteral("L")), 12);
+    QCOMPARE(index.lastSuffix(QStringLiteral("B")), 4);
+    QCOMPARE(index.lastSuffix(QStringLiteral("X")), -1);
+
+    QVector<YZSuffixIndex::Range> hits = index.overlapping(QStringLiteral("L"), 4, 3);
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits.first().id, 1);
+
+    hits = index.overlapping(QStringLiteral("L"), 5, 6);   // L5..L10
+    QCOMPARE(hits.size(), 2);
+    QCOMPARE(hits.at(0).id, 1);
+    QCOMPARE(hits.at(1).id, 2);
+    QCOMPARE(hits.at(1).end, 12);
+    QVERIFY(hits.at(1).manual);
+
+    QVERIFY(index.overlapping(QStringLiteral("L"), 6, 4).isEmpty());
+    QVERIFY(index.overlapping(QStringLiteral("B"), 5, 10).isEmpty());
+
+    // Re-inserting an id moves its range
+    index.insert(1, QStringLiteral("L"), 20, 2, false);
+    QCOMPARE(index.size(), 3);
+    QVERIFY(index.overlapping(QStringLiteral("L"), 1, 5).isEmpty());
+    QCOMPARE(index.lastSuffix(QStringLiteral("L")), 21);
+
+    index.remove(1);
+    QVERIFY(!index.contains(1));
+    QCOMPARE(index.lastSuffix(QStringLiteral("L")), 12);
+}
+
+void TestYZSuffixIndex::suffixNextFree()
+{
+    YZSuffixIndex index;
+    index.insert(1, QStringLiteral("L"), 1, 5, false);
+    index.insert(2, QStringLiteral("L"), 10, 3, false);
+
+    QCOMPARE(index.nextFreeSuffix(QStringLiteral("L"), 1, 3), 6);     // L6..L8 fits below L10
+    QCOMPARE(index.nextFreeSuffix(QStringLiteral("L"), 1, 5), 13);    // L6..L10 does not
+    QCOMPARE(index.nextFreeSuffix(QStringLiteral("B"), 1, 5), 1);
+}
+
+QTEST_APPLESS_MAIN(TestYZSuffixIndex)
+
+#include "TestYZSuffixIndex.moc"